@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Compares the standard ADS, which transposes the right-hand side between directions, with the
+// transpose-free ADS solving non-leading directions in place using strided band substitution and
+// the mixed precision ADS, as well as solving several fields one by one with the batched ADS.
+//
+// Usage: ads_solve [max size] [degree]
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "ads/lin/tensor.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/solver.hpp"
+#include "ads/solver/mixed_precision.hpp"
+#include "timing.hpp"
+
+namespace {
+
+// Enough repetitions to get stable results for small problems, few for the large ones
+auto repetitions(long size) -> int {
+    return static_cast<int>(std::clamp((1L << 26) / size, 3L, 20L));
+}
+
+auto make_dimension(int n, int p) -> ads::dimension {
+    auto dim = ads::dimension{ads::dim_config{p, n - p}, 1};
+    dim.factorize_matrix();
+    return dim;
+}
+
+template <std::size_t Rank>
+void fill(ads::lin::tensor<double, Rank>& a) {
+    auto* const data = a.data();
+    for (int i = 0; i < a.size(); ++i) {
+        data[i] = (i % 17) - 8.0;
+    }
+}
+
+void report(const char* name, double seconds, double reference) {
+    fmt::print("  {:<16} {:10.3f} ms {:8.2f}x\n", name, seconds * 1e3, reference / seconds);
+}
+
+template <std::size_t Rank, std::size_t... Is>
+void run(int n, int p, std::index_sequence<Is...>) {
+    auto const sizes = std::array<int, Rank>{(static_cast<void>(Is), n)...};
+    auto dims = std::array<ads::dimension, Rank>{(static_cast<void>(Is), make_dimension(n, p))...};
+
+    auto rhs = ads::lin::tensor<double, Rank>{sizes};
+    auto buf = ads::lin::tensor<double, Rank>{sizes};
+    auto const reps = repetitions(rhs.size());
+
+    fmt::print("{}D, {}^{}, p = {}\n", Rank, n, Rank, p);
+
+    auto const t_transpose = ads::bench::best_time(
+        reps, [&] { fill(rhs); }, [&] { ads_solve(rhs, buf, dims[Is].data()...); });
+    report("transposing", t_transpose, t_transpose);
+
+    auto const t_strided = ads::bench::best_time(
+        reps, [&] { fill(rhs); },
+        [&] { ads_solve(ads::strided_sweep{}, rhs, dims[Is].data()...); });
+    report("transpose-free", t_strided, t_transpose);
+
+    auto mixed = ads::mixed_precision_ads{dims[Is].data()...};
+    auto steps = 0;
+    auto const t_mixed = ads::bench::best_time(
+        reps, [&] { fill(rhs); }, [&] { steps = mixed.solve(rhs).steps; });
+    auto const label = fmt::format("mixed ({} it)", steps);
+    report(label.c_str(), t_mixed, t_transpose);
+}
+
+template <std::size_t Rank, std::size_t... Is>
+void run_batch(int n, int p, int fields, std::index_sequence<Is...>) {
+    auto const sizes = std::array<int, Rank>{(static_cast<void>(Is), n)...};
+    auto const batch_sizes = std::array<int, Rank + 1>{(static_cast<void>(Is), n)..., fields};
+    auto dims = std::array<ads::dimension, Rank>{(static_cast<void>(Is), make_dimension(n, p))...};
+
+    auto rhs = ads::lin::tensor<double, Rank>{sizes};
+    auto buf = ads::lin::tensor<double, Rank>{sizes};
+    auto batch = ads::lin::tensor<double, Rank + 1>{batch_sizes};
+    auto batch_buf = ads::lin::tensor<double, Rank + 1>{batch_sizes};
+    auto const reps = repetitions(batch.size());
+
+    fmt::print("{}D, {}^{}, p = {}, {} fields\n", Rank, n, Rank, p, fields);
+
+    auto const t_separate = ads::bench::best_time(
+        reps, [&] { fill(rhs); },
+        [&] {
+            for (int i = 0; i < fields; ++i) {
+                ads_solve(rhs, buf, dims[Is].data()...);
+            }
+        });
+    report("separate", t_separate, t_separate);
+
+    auto const t_batch = ads::bench::best_time(
+        reps, [&] { fill(batch); },
+        [&] { ads_solve_batch(batch, batch_buf, dims[Is].data()...); });
+    report("batched", t_batch, t_separate);
+
+    auto const t_strided = ads::bench::best_time(
+        reps, [&] { fill(batch); },
+        [&] { ads_solve_batch(ads::strided_sweep{}, batch, dims[Is].data()...); });
+    report("batched, strided", t_strided, t_separate);
+}
+
+template <std::size_t Rank>
+void run(int n, int p) {
+    run<Rank>(n, p, std::make_index_sequence<Rank>{});
+}
+
+template <std::size_t Rank>
+void run_batch(int n, int p, int fields) {
+    run_batch<Rank>(n, p, fields, std::make_index_sequence<Rank>{});
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto const max_size = argc > 1 ? std::atoi(argv[1]) : 512;
+    auto const p = argc > 2 ? std::atoi(argv[2]) : 2;
+
+    for (int n = 64; n <= max_size; n *= 2) {
+        run<2>(n, p);
+    }
+    for (int n = 64; n <= max_size; n *= 2) {
+        run<3>(n, p);
+    }
+    for (int n = 16; n <= max_size / 4; n *= 2) {
+        run_batch<2>(n, p, 3);
+    }
+    for (int n = 16; n <= max_size / 4; n *= 2) {
+        run_batch<3>(n, p, 3);
+    }
+}
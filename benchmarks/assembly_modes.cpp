@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Compares ways of avoiding conflicting updates of the global vector in parallel assembly of the
+// heat equation right-hand side in 3D (see assembly_mode): synchronizing them with a lock,
+// coloring the elements, and summing per-thread copies of the vector. Reports times for several
+// mesh sizes and thread counts.
+//
+// Usage: assembly_modes [degree] [max threads]
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "ads/assembly.hpp"
+#include "ads/executor/thread_pool.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/sum_factorization.hpp"
+#include "ads/util/function_value.hpp"
+#include "timing.hpp"
+
+namespace {
+
+using tensor = ads::lin::tensor<double, 3>;
+using value_type = ads::function_value_3d;
+
+constexpr int repetitions = 3;
+constexpr double dt = 1e-3;
+
+auto form(std::array<double, 3> /*x*/, value_type u) -> value_type {
+    return {u.val, -dt * u.dx, -dt * u.dy, -dt * u.dz};
+}
+
+void fill(tensor& t) {
+    for (int i = 0; i < t.size(); ++i) {
+        t.data()[i] = static_cast<double>(i % 17) - 8.0;
+    }
+}
+
+void run(int p, int elements, int threads) {
+    auto const dim = ads::dimension{ads::dim_config{p, elements}, 1};
+    auto const bases = std::array{&dim.basis(), &dim.basis(), &dim.basis()};
+    auto const n = dim.dofs();
+
+    auto u = tensor{{n, n, n}};
+    fill(u);
+    auto rhs = tensor{{n, n, n}};
+    auto const executor = ads::thread_pool_executor{threads};
+
+    auto time = [&](ads::assembly_mode mode) {
+        auto const seconds = ads::bench::best_time(
+            repetitions, [&] { zero(rhs); },
+            [&] { ads::assemble_rhs(rhs, u, bases, form, executor, mode); });
+        return seconds * 1e3;
+    };
+    auto const t_locked = time(ads::assembly_mode::locked);
+    auto const t_colored = time(ads::assembly_mode::colored);
+    auto const t_reduction = time(ads::assembly_mode::reduction);
+
+    fmt::print("{:>8} {:>7} {:>10.3f} {:>10.3f} {:>10.3f}\n", elements, threads, t_locked,
+               t_colored, t_reduction);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto const p = argc > 1 ? std::atoi(argv[1]) : 2;
+    auto const hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+    auto const max_threads = argc > 2 ? std::atoi(argv[2]) : std::max(hardware_threads, 1);
+
+    fmt::print("p = {}, times in ms\n", p);
+    fmt::print("{:>8} {:>7} {:>10} {:>10} {:>10}\n", "elements", "threads", "locked", "colored",
+               "reduction");
+    for (int elements : {8, 16, 32}) {
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            run(p, elements, threads);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Compares LAPACK band solvers (LU and Cholesky) with kernels specialized for band width, on
+// B-spline Gram matrices and many right-hand sides, as in a single ADS direction sweep.
+
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/band_solve.hpp"
+#include "ads/lin/lapack.hpp"
+#include "ads/lin/solver_ctx.hpp"
+#include "ads/lin/symmetric_band_matrix.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "timing.hpp"
+
+namespace {
+
+constexpr int repetitions = 10;
+
+// Number of values in the right-hand side
+constexpr int total_size = 1 << 22;
+
+void fill(std::vector<double>& b) {
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        b[i] = static_cast<double>(i % 17) - 8.0;
+    }
+}
+
+void report(const char* name, double factorize, double solve) {
+    fmt::print("  {:<22} {:12.3f} {:12.3f}\n", name, factorize * 1e6, solve * 1e3);
+}
+
+void run(int n, int p) {
+    auto const dim = ads::dimension{ads::dim_config{p, n - p}, 1};
+    auto const nrhs = total_size / n;
+    auto b = std::vector<double>(static_cast<std::size_t>(n) * nrhs);
+
+    fmt::print("p = {}, n = {}, {} right-hand sides\n", p, n, nrhs);
+
+    auto lapack = dim.mass_matrix();
+    auto lapack_ctx = ads::lin::solver_ctx{lapack};
+    auto const t_lapack_lu = ads::bench::best_time(
+        repetitions, [&] { lapack = dim.mass_matrix(); },
+        [&] {
+            dgbtrf_(&lapack.rows, &lapack.cols, &lapack.kl, &lapack.ku, lapack.full_buffer(),
+                    &lapack_ctx.lda, lapack_ctx.pivot(), &lapack_ctx.info);
+        });
+    auto const t_lapack_solve = ads::bench::best_time(
+        repetitions, [&] { fill(b); },
+        [&] {
+            int info = 0;
+            dgbtrs_("N", &n, &p, &p, &nrhs, lapack.full_buffer(), &lapack_ctx.lda,
+                    lapack_ctx.pivot(), b.data(), &n, &info);
+        });
+    report("LU, LAPACK", t_lapack_lu, t_lapack_solve);
+
+    auto special = dim.mass_matrix();
+    auto ctx = ads::lin::solver_ctx{special};
+    auto const t_special_lu = ads::bench::best_time(
+        repetitions, [&] { special = dim.mass_matrix(); },
+        [&] { ads::lin::factorize(special, ctx); });
+    auto const t_special_solve = ads::bench::best_time(
+        repetitions, [&] { fill(b); },
+        [&] { ads::lin::solve_with_factorized(special, b.data(), ctx, nrhs); });
+    report("LU, specialized", t_special_lu, t_special_solve);
+
+    auto const gram = ads::lin::to_symmetric(dim.mass_matrix());
+    auto symmetric = gram;
+    auto symmetric_ctx = ads::lin::solver_ctx{symmetric};
+    auto const t_cholesky_lapack = ads::bench::best_time(
+        repetitions, [&] { symmetric = gram; },
+        [&] {
+            dpbtrf_("U", &n, &p, symmetric.full_buffer(), &symmetric_ctx.lda,
+                    &symmetric_ctx.info);
+        });
+    auto const t_cholesky_lapack_solve = ads::bench::best_time(
+        repetitions, [&] { fill(b); },
+        [&] {
+            int info = 0;
+            dpbtrs_("U", &n, &p, &nrhs, symmetric.full_buffer(), &symmetric_ctx.lda, b.data(), &n,
+                    &info);
+        });
+    report("Cholesky, LAPACK", t_cholesky_lapack, t_cholesky_lapack_solve);
+
+    auto const t_cholesky = ads::bench::best_time(
+        repetitions, [&] { symmetric = gram; },
+        [&] { ads::lin::factorize(symmetric, symmetric_ctx); });
+    auto const t_cholesky_solve = ads::bench::best_time(
+        repetitions, [&] { fill(b); },
+        [&] { ads::lin::solve_with_factorized(symmetric, b.data(), symmetric_ctx, nrhs); });
+    report("Cholesky, specialized", t_cholesky, t_cholesky_solve);
+}
+
+}  // namespace
+
+int main() {
+    fmt::print("  {:<22} {:>12} {:>12}\n", "", "factorize", "solve");
+    fmt::print("  {:<22} {:>12} {:>12}\n", "", "[us]", "[ms]");
+
+    for (int p = 1; p <= 5; ++p) {
+        for (int n : {64, 256, 1024}) {
+            run(n, p);
+        }
+    }
+}
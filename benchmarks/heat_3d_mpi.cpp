@@ -0,0 +1,298 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Scaling of the distributed ADS on the problem of the heat_3d example - explicit time stepping of
+// the heat equation, with the right-hand side assembled by each process for its slab of the mesh.
+// Initial state and the form of the right-hand side are the ones of ads::problems::heat_3d.
+//
+// Usage: mpirun -np <processes> heat_3d_mpi [strong|weak] [elements] [steps] [degree]
+//
+// In strong scaling mode the mesh has elements^3 elements for any number of processes, in weak
+// scaling mode the number of elements along z is multiplied by the number of processes.
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ads/lin/tensor.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/solver/distributed.hpp"
+#include "ads/util/function_value.hpp"
+#include "heat/heat_3d.hpp"
+
+namespace {
+
+using tensor = ads::lin::tensor<double, 3>;
+using index_type = std::array<int, 3>;
+using problem = ads::problems::heat_3d;
+
+int comm_size() {
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    return size;
+}
+
+int comm_rank() {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    return rank;
+}
+
+auto make_dimension(int p, int elements) -> ads::dimension {
+    auto dim = ads::dimension{ads::dim_config{p, elements}, 1};
+    dim.factorize_matrix();
+    return dim;
+}
+
+struct timings {
+    double halo = 0;
+    double assembly = 0;
+    double solve = 0;
+};
+
+class distributed_heat_3d {
+private:
+    ads::dimension x, y, z;
+    double dt;
+    ads::distributed_ads<3> solver;
+    ads::block_partition slabs;
+    int rank;
+
+    // first plane of the local slab with halo, i.e. including planes along z needed to evaluate
+    // the solution on the elements contributing to the local slab
+    int halo_begin;
+    tensor u;
+    tensor u_prev;
+
+    std::vector<int> send_counts, send_offsets, recv_counts, recv_offsets;
+
+public:
+    timings time;
+
+    distributed_heat_3d(int p, int elements, int z_elements, double dt)
+    : x{make_dimension(p, elements)}
+    , y{make_dimension(p, elements)}
+    , z{make_dimension(p, z_elements)}
+    , dt{dt}
+    , solver{MPI_COMM_WORLD, {x.dofs(), y.dofs(), z.dofs()}}
+    , slabs{z.dofs(), comm_size()}
+    , rank{comm_rank()}
+    , halo_begin{halo_range(rank)[0]}
+    , u{solver.local_sizes()}
+    , u_prev{{x.dofs(), y.dofs(), halo_range(rank)[1] - halo_begin}} {
+        compute_halo_layout();
+    }
+
+    int dofs() const { return x.dofs() * y.dofs() * z.dofs(); }
+
+    void init() {
+        zero(u);
+        assemble(u, [this](index_type e, index_type q) {
+            auto const px = x.basis().x[e[0]][q[0]];
+            auto const py = y.basis().x[e[1]][q[1]];
+            auto const pz = z.basis().x[e[2]][q[2]];
+            return [val = problem::init_state(px, py, pz)](ads::function_value_3d) { return val; };
+        });
+        solver.solve(u, x.data(), y.data(), z.data());
+    }
+
+    void step() {
+        auto const t0 = MPI_Wtime();
+        exchange_halo();
+
+        auto const t1 = MPI_Wtime();
+        zero(u);
+        assemble(u, [this](index_type e, index_type q) {
+            auto const w = problem::rhs_form(eval_solution(e, q), dt);
+            return [w](ads::function_value_3d v) {
+                return w.val * v.val + w.dx * v.dx + w.dy * v.dy + w.dz * v.dz;
+            };
+        });
+
+        auto const t2 = MPI_Wtime();
+        solver.solve(u, x.data(), y.data(), z.data());
+
+        auto const t3 = MPI_Wtime();
+        time.halo += t1 - t0;
+        time.assembly += t2 - t1;
+        time.solve += t3 - t2;
+    }
+
+    double norm() const {
+        double local = 0;
+        for (int i = 0; i < u.size(); ++i) {
+            local += u.data()[i] * u.data()[i];
+        }
+        double sum = 0;
+        MPI_Allreduce(&local, &sum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        return sum;
+    }
+
+private:
+    // Planes along z needed by the process, its own slab extended by p planes on both sides
+    std::array<int, 2> halo_range(int q) const {
+        return {std::max(0, slabs.begin(q) - z.p), std::min(z.dofs(), slabs.end(q) + z.p)};
+    }
+
+    void compute_halo_layout() {
+        auto const processes = slabs.parts();
+        auto const plane = x.dofs() * y.dofs();
+        send_counts.assign(processes, 0);
+        send_offsets.assign(processes, 0);
+        recv_counts.assign(processes, 0);
+        recv_offsets.assign(processes, 0);
+
+        for (int q = 0; q < processes; ++q) {
+            // own planes needed by q
+            auto const [qb, qe] = halo_range(q);
+            auto const send_begin = std::max(slabs.begin(rank), qb);
+            auto const send_end = std::min(slabs.end(rank), qe);
+            if (send_begin < send_end) {
+                send_counts[q] = (send_end - send_begin) * plane;
+                send_offsets[q] = (send_begin - slabs.begin(rank)) * plane;
+            }
+            // planes of q needed by this process
+            auto const [hb, he] = halo_range(rank);
+            auto const recv_begin = std::max(slabs.begin(q), hb);
+            auto const recv_end = std::min(slabs.end(q), he);
+            if (recv_begin < recv_end) {
+                recv_counts[q] = (recv_end - recv_begin) * plane;
+                recv_offsets[q] = (recv_begin - hb) * plane;
+            }
+        }
+    }
+
+    void exchange_halo() {
+        MPI_Alltoallv(u.data(), send_counts.data(), send_offsets.data(), MPI_DOUBLE,
+                      u_prev.data(), recv_counts.data(), recv_offsets.data(), MPI_DOUBLE,
+                      MPI_COMM_WORLD);
+    }
+
+    ads::function_value_3d eval_basis(index_type e, index_type q, index_type a) const {
+        auto const& bx = x.basis().b[e[0]][q[0]];
+        auto const& by = y.basis().b[e[1]][q[1]];
+        auto const& bz = z.basis().b[e[2]][q[2]];
+
+        double B1 = bx[0][a[0]];
+        double B2 = by[0][a[1]];
+        double B3 = bz[0][a[2]];
+        double dB1 = bx[1][a[0]];
+        double dB2 = by[1][a[1]];
+        double dB3 = bz[1][a[2]];
+
+        return {B1 * B2 * B3, dB1 * B2 * B3, B1 * dB2 * B3, B1 * B2 * dB3};
+    }
+
+    ads::function_value_3d eval_solution(index_type e, index_type q) const {
+        auto value = ads::function_value_3d{};
+        for (int c = 0; c <= z.p; ++c) {
+            auto const iz = z.basis().first_dof(e[2]) + c - halo_begin;
+            for (int b = 0; b <= y.p; ++b) {
+                auto const iy = y.basis().first_dof(e[1]) + b;
+                for (int a = 0; a <= x.p; ++a) {
+                    auto const ix = x.basis().first_dof(e[0]) + a;
+                    value += u_prev(ix, iy, iz) * eval_basis(e, q, {a, b, c});
+                }
+            }
+        }
+        return value;
+    }
+
+    // Integrates form(e, q)(v) over the elements, for test functions v of the local slab
+    template <typename Form>
+    void assemble(tensor& rhs, Form&& form) {
+        auto const begin = slabs.begin(rank);
+        auto const end = slabs.end(rank);
+
+        for (int ez = 0; ez < z.elements; ++ez) {
+            if (z.basis().last_dof(ez) < begin || z.basis().first_dof(ez) >= end) {
+                continue;
+            }
+            for (int ey = 0; ey < y.elements; ++ey) {
+                for (int ex = 0; ex < x.elements; ++ex) {
+                    auto const e = index_type{ex, ey, ez};
+                    assemble_element(rhs, e, form);
+                }
+            }
+        }
+    }
+
+    template <typename Form>
+    void assemble_element(tensor& rhs, index_type e, Form& form) {
+        auto const begin = slabs.begin(rank);
+        auto const end = slabs.end(rank);
+        double J = x.basis().J[e[0]] * y.basis().J[e[1]] * z.basis().J[e[2]];
+
+        for (int qz = 0; qz < z.basis().quad_order; ++qz) {
+            for (int qy = 0; qy < y.basis().quad_order; ++qy) {
+                for (int qx = 0; qx < x.basis().quad_order; ++qx) {
+                    auto const q = index_type{qx, qy, qz};
+                    double w = x.basis().w[qx] * y.basis().w[qy] * z.basis().w[qz];
+                    auto const integrand = form(e, q);
+
+                    for (int c = 0; c <= z.p; ++c) {
+                        auto const iz = z.basis().first_dof(e[2]) + c;
+                        if (iz < begin || iz >= end) {
+                            continue;
+                        }
+                        for (int b = 0; b <= y.p; ++b) {
+                            auto const iy = y.basis().first_dof(e[1]) + b;
+                            for (int a = 0; a <= x.p; ++a) {
+                                auto const ix = x.basis().first_dof(e[0]) + a;
+                                auto const v = eval_basis(e, q, {a, b, c});
+                                rhs(ix, iy, iz - begin) += integrand(v) * w * J;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+
+    auto const weak = argc > 1 && std::string_view{argv[1]} == "weak";
+    auto const elements = argc > 2 ? std::atoi(argv[2]) : 24;
+    auto const steps = argc > 3 ? std::atoi(argv[3]) : 10;
+    auto const p = argc > 4 ? std::atoi(argv[4]) : 2;
+
+    auto const processes = comm_size();
+    auto const z_elements = weak ? elements * processes : elements;
+
+    {
+        auto sim = distributed_heat_3d{p, elements, z_elements, 1e-7};
+        sim.init();
+        for (int i = 0; i < steps; ++i) {
+            sim.step();
+        }
+        auto const norm = sim.norm();
+
+        // slowest process determines the time
+        auto const local = std::array<double, 3>{sim.time.halo, sim.time.assembly, sim.time.solve};
+        auto total = std::array<double, 3>{};
+        MPI_Reduce(local.data(), total.data(), 3, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+        if (comm_rank() == 0) {
+            fmt::print("{} scaling, {} processes, {} x {} x {} elements, p = {}, {} dofs\n",
+                       weak ? "weak" : "strong", processes, elements, elements, z_elements, p,
+                       sim.dofs());
+            fmt::print("  halo exchange  {:10.3f} ms / step\n", total[0] * 1e3 / steps);
+            fmt::print("  assembly       {:10.3f} ms / step\n", total[1] * 1e3 / steps);
+            fmt::print("  ADS solve      {:10.3f} ms / step\n", total[2] * 1e3 / steps);
+            fmt::print("  |u|^2 = {:.12e}\n", norm);
+        }
+    }
+
+    MPI_Finalize();
+}
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Effect of NUMA placement of tensors on the heat_3d time step (streaming update of the right-hand
+// side and parallel ADS solve). Compares tensors initialized by a single thread (all the memory
+// on one node), tensors first touched in parallel by the threads later using them, and tensors
+// interleaved between the nodes. Worker threads are pinned to consecutive CPUs, so that the same
+// thread processes the same part of the data in each loop. Differences only show up on multi-socket
+// machines, e.g. compare
+//
+//   numactl --cpunodebind=0 heat_3d_numa 128 2 16
+//   numactl --cpunodebind=0,1 heat_3d_numa 128 2 32
+//
+// Usage: heat_3d_numa [elements] [degree] [threads]
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/range/counting_range.hpp>
+#include <fmt/format.h>
+
+#ifdef __linux__
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
+#include "ads/lin/numa.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/solver.hpp"
+#include "timing.hpp"
+
+namespace {
+
+using tensor = ads::lin::tensor<double, 3>;
+
+auto make_dimension(int p, int elements) -> ads::dimension {
+    auto dim = ads::dimension{ads::dim_config{p, elements}, 1};
+    dim.factorize_matrix();
+    return dim;
+}
+
+void pin_to_cpu([[maybe_unused]] int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % CPU_SETSIZE, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+// Splits the range into contiguous parts processed by separate threads, i-th of them pinned to
+// i-th CPU
+class pinned_executor {
+private:
+    mutable std::mutex mutex_;
+    int threads_;
+
+public:
+    explicit pinned_executor(int threads)
+    : threads_{threads} { }
+
+    int thread_count() const { return threads_; }
+
+    template <typename Fun>
+    void synchronized(Fun fun) const {
+        auto const lock = std::scoped_lock{mutex_};
+        fun();
+    }
+
+    template <typename Range, typename Fun>
+    void for_each(Range range, Fun&& fun) const {
+        auto const first = std::begin(range);
+        auto const size = std::distance(first, std::end(range));
+        auto const parts = std::min<long>(threads_, size);
+
+        auto threads = std::vector<std::thread>{};
+        for (long i = 0; i < parts; ++i) {
+            auto const part_begin = std::next(first, i * size / parts);
+            auto const part_end = std::next(first, (i + 1) * size / parts);
+            threads.emplace_back([&fun, i, part_begin, part_end] {
+                pin_to_cpu(static_cast<int>(i));
+                std::for_each(part_begin, part_end, fun);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+};
+
+// Explicit Euler-like update u = u + dt f, streaming through the memory
+template <typename Executor>
+void update(tensor& u, const tensor& f, double dt, int parts, const Executor& executor) {
+    auto* const out = u.data();
+    auto const* const in = f.data();
+    std::ptrdiff_t const size = u.size();
+
+    executor.for_each(boost::counting_range(0, parts), [=](int i) {
+        auto const end = (i + 1) * size / parts;
+        for (auto j = i * size / parts; j < end; ++j) {
+            out[j] += dt * in[j];
+        }
+    });
+}
+
+void fill(tensor& a) {
+    auto* const data = a.data();
+    for (int i = 0; i < a.size(); ++i) {
+        data[i] = (i % 17) - 8.0;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto const elements = argc > 1 ? std::atoi(argv[1]) : 128;
+    auto const p = argc > 2 ? std::atoi(argv[2]) : 2;
+    auto const requested = argc > 3 ? std::atoi(argv[3]) : 0;
+
+    auto const hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+    auto const threads = requested > 0 ? requested : std::max(hardware_threads, 1);
+    auto const executor = pinned_executor{threads};
+    // Same split of the data as the one used by tensor for the first touch
+    auto const parts = 4 * std::max(hardware_threads, 1);
+
+    auto x = make_dimension(p, elements);
+    auto y = make_dimension(p, elements);
+    auto z = make_dimension(p, elements);
+    auto const sizes = std::array<int, 3>{x.dofs(), y.dofs(), z.dofs()};
+    auto const reps = 5;
+
+    fmt::print("heat_3d, {}^3 elements, p = {}, {} threads, {} NUMA nodes\n", elements, p, threads,
+               ads::lin::numa_node_count());
+    fmt::print("  {:<12} {:>12} {:>12} {:>12}\n", "placement", "init [ms]", "update [ms]",
+               "solve [ms]");
+
+    auto run = [&](const char* name, auto&& make) {
+        auto tensors = std::vector<tensor>{};
+        tensors.reserve(3);
+        auto const t_init = ads::bench::best_time(1, [&] {
+            for (int i = 0; i < 3; ++i) {
+                tensors.push_back(make());
+            }
+        });
+        auto& u = tensors[0];
+        auto& f = tensors[1];
+        auto& buf = tensors[2];
+        fill(f);
+
+        auto const t_update = ads::bench::best_time(reps, [&] {
+            update(u, f, 1e-3, parts, executor);
+        });
+        auto const t_solve = ads::bench::best_time(
+            reps, [&] { update(u, f, 1e-3, parts, executor); },
+            [&] {
+                auto const sweep = ads::parallel_sweep{executor};
+                ads_solve(sweep, u, buf, x.data(), y.data(), z.data());
+            });
+        fmt::print("  {:<12} {:12.3f} {:12.3f} {:12.3f}\n", name, t_init * 1e3, t_update * 1e3,
+                   t_solve * 1e3);
+    };
+
+    run("serial", [&] { return tensor{sizes}; });
+    run("first touch", [&] { return tensor{sizes, executor}; });
+    run("interleave", [&] { return tensor{sizes, executor, {ads::lin::numa_policy::interleave}}; });
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Overlap of direction sweeps and transpositions in the pipelined ADS, on the solve of the heat_3d
+// example (Kronecker product of 1D mass matrices). Compares it with the parallel transposing ADS,
+// where each sweep and transposition is a global step, and prints timings of each stage of the
+// pipeline. A stage starting before the previous one ends shows the overlap.
+//
+// Usage: heat_3d_pipeline [elements] [degree] [workers] [slabs]
+
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ads/executor/thread_pool.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/solver.hpp"
+#include "ads/solver/pipelined.hpp"
+#include "timing.hpp"
+
+namespace {
+
+using tensor = ads::lin::tensor<double, 3>;
+
+auto make_dimension(int p, int elements) -> ads::dimension {
+    auto dim = ads::dimension{ads::dim_config{p, elements}, 1};
+    dim.factorize_matrix();
+    return dim;
+}
+
+void fill(tensor& a) {
+    auto* const data = a.data();
+    for (int i = 0; i < a.size(); ++i) {
+        data[i] = (i % 17) - 8.0;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto const elements = argc > 1 ? std::atoi(argv[1]) : 128;
+    auto const p = argc > 2 ? std::atoi(argv[2]) : 2;
+    auto const workers = argc > 3 ? std::atoi(argv[3]) : 0;
+    auto const slabs = argc > 4 ? std::atoi(argv[4]) : 0;
+
+    auto x = make_dimension(p, elements);
+    auto y = make_dimension(p, elements);
+    auto z = make_dimension(p, elements);
+
+    auto rhs = tensor{{x.dofs(), y.dofs(), z.dofs()}};
+    auto buf = tensor{rhs.sizes()};
+    auto const reps = 5;
+
+    auto const executor = ads::thread_pool_executor{workers};
+    auto solver = ads::pipelined_ads{executor, executor.thread_count(), slabs};
+
+    fmt::print("heat_3d, {}^3 elements, p = {}, {} workers\n", elements, p, solver.workers());
+
+    auto const t_barrier = ads::bench::best_time(
+        reps, [&] { fill(rhs); },
+        [&] {
+            auto const sweep = ads::parallel_sweep{executor, solver.workers()};
+            ads_solve(sweep, rhs, buf, x.data(), y.data(), z.data());
+        });
+    fmt::print("  {:<12} {:10.3f} ms\n", "barriers", t_barrier * 1e3);
+
+    auto best = std::vector<ads::pipeline_stage_stats>{};
+    auto best_wall = 0.0;
+    for (int i = 0; i < reps; ++i) {
+        fill(rhs);
+        solver.solve(rhs, x.data(), y.data(), z.data());
+        if (best.empty() || solver.wall_time() < best_wall) {
+            best = solver.stats();
+            best_wall = solver.wall_time();
+        }
+    }
+    fmt::print("  {:<12} {:10.3f} ms {:8.2f}x\n", "pipelined", best_wall * 1e3,
+               t_barrier / best_wall);
+
+    fmt::print("  stage     solve [ms]  transpose [ms]  begin [ms]    end [ms]\n");
+    for (std::size_t d = 0; d < best.size(); ++d) {
+        auto const& s = best[d];
+        fmt::print("  {:5} {:14.3f} {:15.3f} {:11.3f} {:11.3f}\n", d, s.solve * 1e3,
+                   s.transpose * 1e3, s.begin * 1e3, s.end * 1e3);
+    }
+}
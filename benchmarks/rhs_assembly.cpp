@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Compares assembly of the heat equation right-hand side (u, v) - dt (grad u, grad v) in 3D done by
+// evaluating basis functions at each quadrature point (as in heat_3d before), with sum
+// factorization.
+//
+// Usage: rhs_assembly [elements]
+
+#include <array>
+#include <cstdlib>
+
+#include <fmt/format.h>
+
+#include "ads/lin/tensor.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/sum_factorization.hpp"
+#include "ads/util/function_value.hpp"
+#include "timing.hpp"
+
+namespace {
+
+using tensor = ads::lin::tensor<double, 3>;
+using value_type = ads::function_value_3d;
+
+constexpr int repetitions = 3;
+constexpr double dt = 1e-3;
+
+auto form(std::array<double, 3> /*x*/, value_type u) -> value_type {
+    return {u.val, -dt * u.dx, -dt * u.dy, -dt * u.dz};
+}
+
+void fill(tensor& t) {
+    for (int i = 0; i < t.size(); ++i) {
+        t.data()[i] = static_cast<double>(i % 17) - 8.0;
+    }
+}
+
+auto basis_value(const std::array<const ads::basis_data*, 3>& bases, const std::array<int, 3>& e,
+                 const std::array<int, 3>& q, const std::array<int, 3>& a) -> value_type {
+    auto const& bx = *bases[0];
+    auto const& by = *bases[1];
+    auto const& bz = *bases[2];
+    double const B1 = bx.b[e[0]][q[0]][0][a[0]];
+    double const B2 = by.b[e[1]][q[1]][0][a[1]];
+    double const B3 = bz.b[e[2]][q[2]][0][a[2]];
+    double const dB1 = bx.b[e[0]][q[0]][1][a[0]];
+    double const dB2 = by.b[e[1]][q[1]][1][a[1]];
+    double const dB3 = bz.b[e[2]][q[2]][1][a[2]];
+    return {B1 * B2 * B3, dB1 * B2 * B3, B1 * dB2 * B3, B1 * B2 * dB3};
+}
+
+// Calls fun(a) for each multi-index a in [0, n)^3
+template <typename Fun>
+void for_each_index(int n, Fun&& fun) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            for (int k = 0; k < n; ++k) {
+                fun(std::array{i, j, k});
+            }
+        }
+    }
+}
+
+void naive_rhs(tensor& rhs, const tensor& u, const std::array<const ads::basis_data*, 3>& bases) {
+    auto const& b = *bases[0];
+    auto const dofs = b.dofs_per_element();
+
+    for_each_index(b.elements, [&](std::array<int, 3> e) {
+        double const J = b.J[e[0]] * b.J[e[1]] * b.J[e[2]];
+        auto const first = std::array{b.first_dof(e[0]), b.first_dof(e[1]), b.first_dof(e[2])};
+
+        for_each_index(b.quad_order, [&](std::array<int, 3> q) {
+            double const w = b.w[q[0]] * b.w[q[1]] * b.w[q[2]];
+            auto uu = value_type{};
+            for_each_index(dofs, [&](std::array<int, 3> a) {
+                auto B = basis_value(bases, e, q, a);
+                B *= u(first[0] + a[0], first[1] + a[1], first[2] + a[2]);
+                uu += B;
+            });
+            auto const r = form({}, uu);
+            for_each_index(dofs, [&](std::array<int, 3> a) {
+                auto const v = basis_value(bases, e, q, a);
+                double const val = r.val * v.val + r.dx * v.dx + r.dy * v.dy + r.dz * v.dz;
+                rhs(first[0] + a[0], first[1] + a[1], first[2] + a[2]) += val * w * J;
+            });
+        });
+    });
+}
+
+void run(int p, int elements) {
+    auto const dim = ads::dimension{ads::dim_config{p, elements}, 1};
+    auto const bases = std::array{&dim.basis(), &dim.basis(), &dim.basis()};
+    auto const n = dim.dofs();
+
+    auto u = tensor{{n, n, n}};
+    fill(u);
+    auto rhs = tensor{{n, n, n}};
+
+    auto const t_naive = ads::bench::best_time(
+        repetitions, [&] { zero(rhs); }, [&] { naive_rhs(rhs, u, bases); });
+    auto const t_sum = ads::bench::best_time(
+        repetitions, [&] { zero(rhs); }, [&] { ads::assemble_rhs(rhs, u, bases, form); });
+
+    fmt::print("{:>4} {:>10.3f} {:>10.3f} {:>9.1f}x\n", p, t_naive * 1e3, t_sum * 1e3,
+               t_naive / t_sum);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto const elements = argc > 1 ? std::atoi(argv[1]) : 16;
+
+    fmt::print("{}^3 elements\n", elements);
+    fmt::print("{:>4} {:>10} {:>10} {:>10}\n", "p", "naive [ms]", "sum [ms]", "speedup");
+    for (int p = 1; p <= 5; ++p) {
+        run(p, elements);
+    }
+}
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef BENCHMARKS_TIMING_HPP
+#define BENCHMARKS_TIMING_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace ads::bench {
+
+// Runs fun repeatedly and returns the shortest execution time in seconds
+template <typename Fun>
+auto best_time(int repetitions, Fun&& fun) -> double {
+    using clock = std::chrono::steady_clock;
+    auto best = std::numeric_limits<double>::infinity();
+
+    for (int i = 0; i < repetitions; ++i) {
+        auto const before = clock::now();
+        fun();
+        auto const after = clock::now();
+        auto const elapsed = std::chrono::duration<double>(after - before).count();
+        best = std::min(best, elapsed);
+    }
+    return best;
+}
+
+// Same as above, but calls setup before each run of fun, excluding it from the measurement
+template <typename Setup, typename Fun>
+auto best_time(int repetitions, Setup&& setup, Fun&& fun) -> double {
+    auto best = std::numeric_limits<double>::infinity();
+
+    for (int i = 0; i < repetitions; ++i) {
+        setup();
+        best = std::min(best, best_time(1, fun));
+    }
+    return best;
+}
+
+// Memory throughput in GB/s for an operation moving given number of bytes
+inline auto throughput(double bytes, double seconds) -> double {
+    return bytes / seconds * 1e-9;
+}
+
+}  // namespace ads::bench
+
+#endif  // BENCHMARKS_TIMING_HPP
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Measures memory throughput of cyclic tensor transposition against memcpy baseline.
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "ads/config.hpp"
+#include "ads/executor/thread_pool.hpp"
+#include "ads/lin/tensor.hpp"
+#include "timing.hpp"
+
+namespace {
+
+constexpr int repetitions = 10;
+
+// Element-by-element transposition through tensor indexing, for reference
+void naive_transpose(const ads::lin::tensor<double, 2>& a, ads::lin::tensor_view<double, 2>& b) {
+    for (int j = 0; j < a.size(1); ++j) {
+        for (int i = 0; i < a.size(0); ++i) {
+            b(j, i) = a(i, j);
+        }
+    }
+}
+
+void naive_transpose(const ads::lin::tensor<double, 3>& a, ads::lin::tensor_view<double, 3>& b) {
+    for (int k = 0; k < a.size(2); ++k) {
+        for (int j = 0; j < a.size(1); ++j) {
+            for (int i = 0; i < a.size(0); ++i) {
+                b(j, k, i) = a(i, j, k);
+            }
+        }
+    }
+}
+
+void report(const char* name, double bytes, double seconds) {
+    fmt::print("  {:<12} {:10.3f} ms {:10.2f} GB/s\n", name, seconds * 1e3,
+               ads::bench::throughput(bytes, seconds));
+}
+
+template <std::size_t Rank>
+void run(const std::array<int, Rank>& sizes) {
+    auto a = ads::lin::tensor<double, Rank>{sizes};
+    auto b = ads::lin::tensor<double, Rank>{sizes};
+
+    auto const n = a.size();
+    for (ads::linear_index_type i = 0; i < n; ++i) {
+        a.data()[i] = static_cast<double>(i);
+    }
+    // each element is read once and written once
+    auto const bytes = 2.0 * sizeof(double) * static_cast<double>(n);
+
+    fmt::print("{}D", Rank);
+    for (std::size_t i = 0; i < Rank; ++i) {
+        fmt::print("{} {}", i == 0 ? "" : " x", sizes[i]);
+    }
+    fmt::print("\n");
+
+    auto const t_memcpy = ads::bench::best_time(repetitions, [&] {
+        std::memcpy(b.data(), a.data(), sizeof(double) * n);
+    });
+    report("memcpy", bytes, t_memcpy);
+
+    auto const t_naive = ads::bench::best_time(repetitions, [&] {
+        auto view = ads::lin::as_tensor(b.data(), ads::lin::detail::cyclic_transpose_sizes(sizes));
+        naive_transpose(a, view);
+    });
+    report("naive", bytes, t_naive);
+
+    auto const t_blocked = ads::bench::best_time(repetitions, [&] {
+        ads::lin::cyclic_transpose(a, b.data());  //
+    });
+    report("blocked", bytes, t_blocked);
+
+    for (int threads : {2, 4, 8, 16}) {
+        auto const executor = ads::thread_pool_executor{threads};
+        auto const t_parallel = ads::bench::best_time(repetitions, [&] {
+            ads::lin::cyclic_transpose(a, b.data(), executor);
+        });
+        auto const label = fmt::format("{} threads", threads);
+        report(label.c_str(), bytes, t_parallel);
+    }
+}
+
+}  // namespace
+
+int main() {
+    run<2>({1024, 1024});
+    run<2>({4096, 4096});
+    run<2>({200, 40000});
+
+    run<3>({64, 64, 64});
+    run<3>({128, 128, 128});
+    run<3>({256, 256, 256});
+}
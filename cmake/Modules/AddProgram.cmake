@@ -1,5 +1,5 @@
 function(add_program name)
-  cmake_parse_arguments(PROGRAM "MUMPS;GALOIS" "" "LIBS;SRC" ${ARGN})
+  cmake_parse_arguments(PROGRAM "MUMPS;GALOIS;MPI" "" "LIBS;SRC" ${ARGN})
 
   set(OK TRUE)
   if (PROGRAM_GALOIS AND NOT ADS_USE_GALOIS)
@@ -8,6 +8,9 @@ function(add_program name)
   if (PROGRAM_MUMPS AND NOT ADS_USE_MUMPS)
     set(OK FALSE)
   endif()
+  if (PROGRAM_MPI AND NOT ADS_USE_MPI)
+    set(OK FALSE)
+  endif()
 
   if (OK)
     add_executable(${name} ${PROGRAM_SRC})
@@ -0,0 +1,20 @@
+include(FindPackageHandleStandardArgs)
+
+find_path(NUMA_INCLUDE_DIR NAMES numa.h numaif.h)
+
+find_library(NUMA_LIBRARY NAMES numa)
+
+find_package_handle_standard_args(NUMA
+  FOUND_VAR NUMA_FOUND
+  REQUIRED_VARS
+    NUMA_LIBRARY
+    NUMA_INCLUDE_DIR
+)
+
+# Create imported target
+if (NUMA_FOUND AND NOT TARGET NUMA::NUMA)
+  add_library(NUMA::NUMA UNKNOWN IMPORTED)
+  set_target_properties(NUMA::NUMA PROPERTIES
+    IMPORTED_LOCATION "${NUMA_LIBRARY}"
+    INTERFACE_INCLUDE_DIRECTORIES "${NUMA_INCLUDE_DIR}")
+endif()
@@ -4,11 +4,13 @@
 #ifndef CG_ADVECTION_HPP
 #define CG_ADVECTION_HPP
 
-#include <galois/Timer.h>
+#include <chrono>
+#include <iostream>
 
 #include "../erikkson/erikkson_base.hpp"
 #include "../erikkson/solution.hpp"
-#include "ads/executor/galois.hpp"
+#include "ads/element_coloring.hpp"
+#include "ads/executor/thread_pool.hpp"
 #include "ads/lin/dense_matrix.hpp"
 #include "ads/lin/dense_solve.hpp"
 #include "ads/lin/tensor/view.hpp"
@@ -47,12 +49,15 @@ class advection : public erikkson_base {
     using Base::errorH1;
     using Base::errorL2;
 
-    galois_executor executor{8};
+    thread_pool_executor executor;
 
     dimension Ux, Uy;
     dimension& Vx;
     dimension& Vy;
 
+    // colors of elements sharing no dofs in either space, for assembly without locking
+    element_coloring<2> coloring;
+
     lin::band_matrix MVx, MVy;
     lin::band_matrix KVx, KVy;
 
@@ -60,7 +65,6 @@ class advection : public erikkson_base {
     lin::solver_ctx Ax_ctx, Ay_ctx;
 
     vector_type u, r;
-    vector_type buffer;
 
     std::vector<double> full_rhs;
 
@@ -78,9 +82,10 @@ class advection : public erikkson_base {
 
     output_manager<2> output;
 
-    galois::StatTimer integration_timer{"integration"};
-    galois::StatTimer solver_timer{"solver"};
-    galois::StatTimer total_timer{"total"};
+    using clock = std::chrono::steady_clock;
+    clock::duration integration_time{};
+    clock::duration solver_time{};
+    clock::duration total_time{};
 
     int total_CG_iters = 0;
 
@@ -96,6 +101,7 @@ class advection : public erikkson_base {
     , Uy{trial_y}
     , Vx{x}
     , Vy{y}
+    , coloring{{&Vx.basis(), &Vy.basis()}, {&Ux.basis(), &Uy.basis()}}
     , MVx{Vx.p, Vx.p, Vx.dofs(), Vx.dofs(), 0}
     , MVy{Vy.p, Vy.p, Vy.dofs(), Vy.dofs(), 0}
     , KVx{Vx.p, Vx.p, Vx.dofs(), Vx.dofs(), 0}
@@ -106,7 +112,6 @@ class advection : public erikkson_base {
     , Ay_ctx{Ay}
     , u{{Ux.dofs(), Uy.dofs()}}
     , r{{Vx.dofs(), Vy.dofs()}}
-    , buffer{{Vx.dofs(), Vy.dofs()}}
     , full_rhs(Vx.dofs() * Vy.dofs() + Ux.dofs() * Uy.dofs())
     , h{element_diam(Ux, Uy)}
     , eta{eta}
@@ -115,7 +120,7 @@ class advection : public erikkson_base {
     , problem{problem}
     , output{Ux.B, Uy.B, 500}
     , dirichlet{cfg.weak_bc ? boundary::none : boundary::full} {
-        int p = Vx.basis.degree;
+        int p = Vx.basis().degree;
         gamma = 3 * epsilon * p * p / h;
     }
 
@@ -159,7 +164,7 @@ class advection : public erikkson_base {
     }
 
     bool supported_in_1d(int dof, int e, const dimension& x) const {
-        auto xrange = x.basis.element_ranges[dof];
+        auto xrange = x.basis().element_ranges[dof];
         return e >= xrange.first && e <= xrange.second;
     }
 
@@ -178,15 +183,15 @@ class advection : public erikkson_base {
 
             auto y0 = side == boundary::bottom ? Uy.a : Uy.b;
 
-            for (auto e : Ux.basis.element_range(i[0])) {
+            for (auto e : Ux.basis().element_range(i[0])) {
                 if (!supported_in_1d(j[0], e, Vx))
                     continue;
 
-                double J = Ux.basis.J[e];
+                double J = Ux.basis().J[e];
 
-                for (int q = 0; q < Ux.basis.quad_order; ++q) {
-                    double w = Ux.basis.w[q];
-                    point_type x{Ux.basis.x[e][q], y0};
+                for (int q = 0; q < Ux.basis().quad_order; ++q) {
+                    double w = Ux.basis().w[q];
+                    point_type x{Ux.basis().x[e][q], y0};
                     value_type ww = eval_basis_at(x, i, Ux, Uy);
                     value_type uu = eval_basis_at(x, j, Vx, Vy);
                     double fuw = form(ww, uu, x, nv);
@@ -200,15 +205,15 @@ class advection : public erikkson_base {
 
             auto x0 = side == boundary::left ? Ux.a : Ux.b;
 
-            for (auto e : Uy.basis.element_range(i[1])) {
+            for (auto e : Uy.basis().element_range(i[1])) {
                 if (!supported_in_1d(j[1], e, Vy))
                     continue;
 
-                double J = Uy.basis.J[e];
+                double J = Uy.basis().J[e];
 
-                for (int q = 0; q < Uy.basis.quad_order; ++q) {
-                    double w = Uy.basis.w[q];
-                    point_type x{x0, Uy.basis.x[e][q]};
+                for (int q = 0; q < Uy.basis().quad_order; ++q) {
+                    double w = Uy.basis().w[q];
+                    point_type x{x0, Uy.basis().x[e][q]};
                     value_type ww = eval_basis_at(x, i, Ux, Uy);
                     value_type uu = eval_basis_at(x, j, Vx, Vy);
                     double fuw = form(ww, uu, x, nv);
@@ -233,12 +238,12 @@ class advection : public erikkson_base {
 
             auto y0 = side == boundary::bottom ? Uy.a : Uy.b;
 
-            for (auto e : Ux.basis.element_range(i[0])) {
-                double J = Ux.basis.J[e];
+            for (auto e : Ux.basis().element_range(i[0])) {
+                double J = Ux.basis().J[e];
 
-                for (int q = 0; q < Ux.basis.quad_order; ++q) {
-                    double w = Ux.basis.w[q];
-                    point_type x{Ux.basis.x[e][q], y0};
+                for (int q = 0; q < Ux.basis().quad_order; ++q) {
+                    double w = Ux.basis().w[q];
+                    point_type x{Ux.basis().x[e][q], y0};
                     value_type ww = eval_basis_at(x, i, Ux, Uy);
                     double fuw = form(ww, x, nv);
                     val += fuw * w * J;
@@ -251,12 +256,12 @@ class advection : public erikkson_base {
 
             auto x0 = side == boundary::left ? Ux.a : Ux.b;
 
-            for (auto e : Uy.basis.element_range(i[1])) {
-                double J = Uy.basis.J[e];
+            for (auto e : Uy.basis().element_range(i[1])) {
+                double J = Uy.basis().J[e];
 
-                for (int q = 0; q < Uy.basis.quad_order; ++q) {
-                    double w = Uy.basis.w[q];
-                    point_type x{x0, Uy.basis.x[e][q]};
+                for (int q = 0; q < Uy.basis().quad_order; ++q) {
+                    double w = Uy.basis().w[q];
+                    point_type x{x0, Uy.basis().x[e][q]};
                     value_type ww = eval_basis_at(x, i, Ux, Uy);
                     double fuw = form(ww, x, nv);
                     val += fuw * w * J;
@@ -281,12 +286,12 @@ class advection : public erikkson_base {
 
             auto y0 = side == boundary::bottom ? Uy.a : Uy.b;
 
-            for (auto e : Ux.basis.element_range(i[0])) {
-                double J = Ux.basis.J[e];
+            for (auto e : Ux.basis().element_range(i[0])) {
+                double J = Ux.basis().J[e];
 
-                for (int q = 0; q < Ux.basis.quad_order; ++q) {
-                    double w = Ux.basis.w[q];
-                    point_type x{Ux.basis.x[e][q], y0};
+                for (int q = 0; q < Ux.basis().quad_order; ++q) {
+                    double w = Ux.basis().w[q];
+                    point_type x{Ux.basis().x[e][q], y0};
                     value_type uu = eval_at(x, u, Vx, Vy);
                     value_type ww = eval_basis_at(x, i, Ux, Uy);
                     double fuw = form(uu, ww, x, nv);
@@ -300,12 +305,12 @@ class advection : public erikkson_base {
 
             auto x0 = side == boundary::left ? Ux.a : Ux.b;
 
-            for (auto e : Uy.basis.element_range(i[1])) {
-                double J = Uy.basis.J[e];
+            for (auto e : Uy.basis().element_range(i[1])) {
+                double J = Uy.basis().J[e];
 
-                for (int q = 0; q < Uy.basis.quad_order; ++q) {
-                    double w = Uy.basis.w[q];
-                    point_type x{x0, Uy.basis.x[e][q]};
+                for (int q = 0; q < Uy.basis().quad_order; ++q) {
+                    double w = Uy.basis().w[q];
+                    point_type x{x0, Uy.basis().x[e][q]};
                     value_type uu = eval_at(x, u, Vx, Vy);
                     value_type ww = eval_basis_at(x, i, Ux, Uy);
                     double fuw = form(uu, ww, x, nv);
@@ -426,10 +431,12 @@ class advection : public erikkson_base {
     }
 
     void prepare_matrices() {
-        gram_matrix_1d(MVx, Vx.basis);
-        gram_matrix_1d(MVy, Vy.basis);
-        stiffness_matrix_1d(KVx, Vx.basis);
-        stiffness_matrix_1d(KVy, Vy.basis);
+        // test spaces usually coincide, so these are assembled only once
+        auto& cache = factorization_cache::global();
+        MVx = *cache.matrix(Vx.basis(), matrix_kind::mass);
+        MVy = *cache.matrix(Vy.basis(), matrix_kind::mass);
+        KVx = *cache.matrix(Vx.basis(), matrix_kind::stiffness);
+        KVy = *cache.matrix(Vy.basis(), matrix_kind::stiffness);
 
         // double eta = h * h;
 
@@ -469,7 +476,7 @@ class advection : public erikkson_base {
         zero(u);
 
         // auto init = [this](double x, double y) { return 2*x*x + 2*y*y; };
-        // compute_projection(u, Ux.basis, Uy.basis, init);
+        // compute_projection(u, Ux.basis(), Uy.basis(), init);
         // vector_type u_buffer{{ Ux.dofs(), Uy.dofs() }};
         // ads_solve(u, u_buffer, Ux.data(), Uy.data());
 
@@ -525,7 +532,7 @@ class advection : public erikkson_base {
 
         std::fill(begin(full_rhs), end(full_rhs), 0);
 
-        integration_timer.start();
+        auto const integration_start = clock::now();
         compute_rhs(Vx, Vy, dr, du);
 
         // BC
@@ -536,11 +543,11 @@ class advection : public erikkson_base {
 
         mumps::problem problem{full_rhs};
         assemble_problem(problem, Vx, Vy);
-        integration_timer.stop();
+        integration_time += clock::now() - integration_start;
 
-        solver_timer.start();
+        auto const solver_start = clock::now();
         solver.solve(problem);
-        solver_timer.stop();
+        solver_time += clock::now() - solver_start;
 
         update_solution(du);
         return du;
@@ -614,7 +621,7 @@ class advection : public erikkson_base {
     }
 
     void solve_A(vector_type& v) {
-        ads_solve(v, buffer, dim_data{Ax, Ax_ctx}, dim_data{Ay, Ay_ctx});
+        ads_solve(parallel_sweep{executor}, v, dim_data{Ax, Ax_ctx}, dim_data{Ay, Ay_ctx});
     }
 
     void step(int /*iter*/, double /*t*/) override {
@@ -622,7 +629,7 @@ class advection : public erikkson_base {
         auto dc = vector_type{{Ux.dofs(), Uy.dofs()}};
         auto Bc = vector_type{{Vx.dofs(), Vy.dofs()}};
 
-        total_timer.start();
+        auto const start = clock::now();
         int i = 0;
         for (; i < cfg.max_outer_iters; ++i) {
             // dd = A~ \ (F + Kr - Bu)
@@ -655,7 +662,7 @@ class advection : public erikkson_base {
                 break;
             }
         }
-        total_timer.stop();
+        total_time += clock::now() - start;
 
         if (cfg.print_outer_count)
             std::cout << "outer iters: " << i << std::endl;
@@ -664,6 +671,10 @@ class advection : public erikkson_base {
             std::cout << "total CG iters: " << total_CG_iters << std::endl;
     }
 
+    static double milliseconds(clock::duration time) {
+        return std::chrono::duration<double, std::milli>(time).count();
+    }
+
     void after() override {
         if (cfg.plot) {
             output.to_file(u, "result.data");
@@ -679,20 +690,17 @@ class advection : public erikkson_base {
         }
 
         if (cfg.print_times) {
-            std::cout << "integration: " << static_cast<double>(integration_timer.get()) << " ms"
-                      << std::endl;
-            std::cout << "solver:      " << static_cast<double>(solver_timer.get()) << " ms"
-                      << std::endl;
-            std::cout << "total:       " << static_cast<double>(total_timer.get()) << " ms"
-                      << std::endl;
+            std::cout << "integration: " << milliseconds(integration_time) << " ms" << std::endl;
+            std::cout << "solver:      " << milliseconds(solver_time) << " ms" << std::endl;
+            std::cout << "total:       " << milliseconds(total_time) << " ms" << std::endl;
         }
     }
 
     void compute_rhs(const dimension& Vx, const dimension& Vy, vector_view& r_rhs,
                      vector_view& u_rhs) {
-        executor.for_each(elements(Vx, Vy), [&](index_type e) {
-            auto R = vector_type{{Vx.basis.dofs_per_element(), Vy.basis.dofs_per_element()}};
-            auto U = vector_type{{Ux.basis.dofs_per_element(), Uy.basis.dofs_per_element()}};
+        for_each_colored(coloring, executor, [&](index_type e) {
+            auto R = vector_type{{Vx.basis().dofs_per_element(), Vy.basis().dofs_per_element()}};
+            auto U = vector_type{{Ux.basis().dofs_per_element(), Uy.basis().dofs_per_element()}};
 
             double J = jacobian(e);
             for (auto q : quad_points(Vx, Vy)) {
@@ -720,10 +728,8 @@ class advection : public erikkson_base {
                     U(aa[0], aa[1]) += val * WJ;
                 }
             }
-            executor.synchronized([&]() {
-                update_global_rhs(r_rhs, R, e, Vx, Vy);
-                update_global_rhs(u_rhs, U, e, Ux, Uy);
-            });
+            update_global_rhs(r_rhs, R, e, Vx, Vy);
+            update_global_rhs(u_rhs, U, e, Ux, Uy);
         });
 
         // Boundary terms of -Bu
@@ -769,8 +775,8 @@ class advection : public erikkson_base {
     double eval_basis_dxy(index_type e, index_type q, index_type dof, const dimension& x,
                           const dimension& y) const {
         auto loc = dof_global_to_local(e, dof);
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
         double dB1 = bx.b[e[0]][q[0]][1][loc[0]];
         double dB2 = by.b[e[1]][q[1]][1][loc[1]];
         return dB1 * dB2;
@@ -789,8 +795,8 @@ class advection : public erikkson_base {
 
     void compute_dd(const dimension& Vx, const dimension& Vy, vector_type& dd) {
         zero(dd);
-        executor.for_each(elements(Vx, Vy), [&](index_type e) {
-            auto R = vector_type{{Vx.basis.dofs_per_element(), Vy.basis.dofs_per_element()}};
+        for_each_colored(coloring, executor, [&](index_type e) {
+            auto R = vector_type{{Vx.basis().dofs_per_element(), Vy.basis().dofs_per_element()}};
 
             double J = jacobian(e);
             for (auto q : quad_points(Vx, Vy)) {
@@ -813,7 +819,7 @@ class advection : public erikkson_base {
                     R(aa[0], aa[1]) += val * WJ;
                 }
             }
-            executor.synchronized([&]() { update_global_rhs(dd, R, e, Vx, Vy); });
+            update_global_rhs(dd, R, e, Vx, Vy);
         });
 
         // Boundary terms of -Bu
@@ -846,8 +852,8 @@ class advection : public erikkson_base {
     template <typename U, typename Res>
     void apply_B(const U& u, Res& result) {
         zero(result);
-        executor.for_each(elements(Vx, Vy), [&](index_type e) {
-            auto rhs = vector_type{{Vx.basis.dofs_per_element(), Vy.basis.dofs_per_element()}};
+        for_each_colored(coloring, executor, [&](index_type e) {
+            auto rhs = vector_type{{Vx.basis().dofs_per_element(), Vy.basis().dofs_per_element()}};
 
             double J = jacobian(e);
             for (auto q : quad_points(Vx, Vy)) {
@@ -864,7 +870,7 @@ class advection : public erikkson_base {
                     rhs(aa[0], aa[1]) += val * WJ;
                 }
             }
-            executor.synchronized([&]() { update_global_rhs(result, rhs, e, Vx, Vy); });
+            update_global_rhs(result, rhs, e, Vx, Vy);
         });
 
         // Boundary terms of Bu
@@ -884,8 +890,8 @@ class advection : public erikkson_base {
     template <typename U, typename Res>
     void apply_Bt(const U& r, Res& result) {
         zero(result);
-        executor.for_each(elements(Vx, Vy), [&](index_type e) {
-            auto rhs = vector_type{{Ux.basis.dofs_per_element(), Uy.basis.dofs_per_element()}};
+        for_each_colored(coloring, executor, [&](index_type e) {
+            auto rhs = vector_type{{Ux.basis().dofs_per_element(), Uy.basis().dofs_per_element()}};
 
             double J = jacobian(e);
             for (auto q : quad_points(Vx, Vy)) {
@@ -903,7 +909,7 @@ class advection : public erikkson_base {
                     rhs(aa[0], aa[1]) += val * WJ;
                 }
             }
-            executor.synchronized([&]() { update_global_rhs(result, rhs, e, Ux, Uy); });
+            update_global_rhs(result, rhs, e, Ux, Uy);
         });
 
         // Boundary terms of B'r
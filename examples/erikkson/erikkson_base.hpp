@@ -7,7 +7,6 @@
 #include <fstream>
 
 #include "ads/bspline/eval.hpp"
-#include "ads/executor/galois.hpp"
 #include "ads/simulation.hpp"
 #include "ads/simulation/utils.hpp"
 #include "solution.hpp"
@@ -37,7 +36,10 @@ class erikkson_base : public simulation_2d {
 
     template <typename RHS>
     void zero_bc(RHS& u, dimension& Ux, dimension& Uy) {
-        for_boundary_dofs(Ux, Uy, [&](index_type i) { u(i[0], i[1]) = 0; });
+        lin::assign(u.template slice<0>(0), 0.0);
+        lin::assign(u.template slice<0>(Ux.dofs() - 1), 0.0);
+        lin::assign(u.template slice<1>(0), 0.0);
+        lin::assign(u.template slice<1>(Uy.dofs() - 1), 0.0);
     }
 
     void plot_horizontal(const char* filename, double y0, const vector_type& u, const dimension& Ux,
@@ -52,9 +54,9 @@ class erikkson_base : public simulation_2d {
         };
 
         print(Ux.a);
-        auto N = Ux.basis.quad_order;
+        auto N = Ux.basis().quad_order;
         for (auto e : Ux.element_indices()) {
-            std::vector<double> qs(Ux.basis.x[e], Ux.basis.x[e] + N);
+            std::vector<double> qs(Ux.basis().x[e], Ux.basis().x[e] + N);
             std::sort(begin(qs), end(qs));
             for (auto xx : qs) {
                 print(xx);
@@ -75,9 +77,9 @@ class erikkson_base : public simulation_2d {
         };
 
         print(Uy.a);
-        auto N = Uy.basis.quad_order;
+        auto N = Uy.basis().quad_order;
         for (auto e : Uy.element_indices()) {
-            std::vector<double> qs(Uy.basis.x[e], Uy.basis.x[e] + N);
+            std::vector<double> qs(Uy.basis().x[e], Uy.basis().x[e] + N);
             std::sort(begin(qs), end(qs));
             for (auto yy : qs) {
                 print(yy);
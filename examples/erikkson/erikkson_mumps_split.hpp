@@ -4,13 +4,14 @@
 #ifndef ERIKKSON_ERIKKSON_MUMPS_SPLIT_HPP
 #define ERIKKSON_ERIKKSON_MUMPS_SPLIT_HPP
 
-#include "ads/executor/galois.hpp"
+#include "ads/executor/thread_pool.hpp"
 #include "ads/lin/dense_matrix.hpp"
 #include "ads/lin/dense_solve.hpp"
 #include "ads/lin/tensor/view.hpp"
 #include "ads/output_manager.hpp"
 #include "ads/simulation.hpp"
 #include "ads/solver/mumps.hpp"
+#include "ads/sum_factorization.hpp"
 #include "erikkson_base.hpp"
 
 namespace ads {
@@ -22,7 +23,7 @@ class erikkson_mumps_split : public erikkson_base {
     using Base = erikkson_base;
     using vector_view = lin::tensor_view<double, 2>;
 
-    galois_executor executor{8};
+    thread_pool_executor executor;
 
     dimension Ux, Uy;
     dimension& Vx;
@@ -56,7 +57,6 @@ class erikkson_mumps_split : public erikkson_base {
 
     vector_type u;
     residuum r;
-    vector_type u_buffer;
     std::vector<double> full_rhs;
 
     int save_every = 1;
@@ -118,7 +118,6 @@ class erikkson_mumps_split : public erikkson_base {
     , AUUy{Uy.dofs(), Uy.dofs()}
     , u{{Ux.dofs(), Uy.dofs()}}
     , r{vector_type{{Vx.dofs(), Vy.dofs()}}, &Vx, &Vy}
-    , u_buffer{{Ux.dofs(), Uy.dofs()}}
     , full_rhs(Vx.dofs() * Vy.dofs() + Ux.dofs() * Uy.dofs())
     , output{Ux.B, Uy.B, 500}
     , method{method} { }
@@ -219,35 +218,35 @@ class erikkson_mumps_split : public erikkson_base {
     }
 
     void prepare_matrices() {
-        gram_matrix_1d(MVx, Vx.basis);
-        gram_matrix_1d(MVy, Vy.basis);
+        gram_matrix_1d(MVx, Vx.basis());
+        gram_matrix_1d(MVy, Vy.basis());
 
-        gram_matrix_1d(MUx, Ux.basis);
-        gram_matrix_1d(MUy, Uy.basis);
+        gram_matrix_1d(MUx, Ux.basis());
+        gram_matrix_1d(MUy, Uy.basis());
 
-        gram_matrix_1d(MUUx, Ux.basis, Ux.basis);
-        gram_matrix_1d(MUUy, Uy.basis, Uy.basis);
+        gram_matrix_1d(MUUx, Ux.basis(), Ux.basis());
+        gram_matrix_1d(MUUy, Uy.basis(), Uy.basis());
 
-        gram_matrix_1d(MUVx, Ux.basis, Vx.basis);
-        gram_matrix_1d(MUVy, Uy.basis, Vy.basis);
+        gram_matrix_1d(MUVx, Ux.basis(), Vx.basis());
+        gram_matrix_1d(MUVy, Uy.basis(), Vy.basis());
 
-        stiffness_matrix_1d(KVx, Vx.basis);
-        stiffness_matrix_1d(KVy, Vy.basis);
+        stiffness_matrix_1d(KVx, Vx.basis());
+        stiffness_matrix_1d(KVy, Vy.basis());
 
-        stiffness_matrix_1d(KUx, Ux.basis);
-        stiffness_matrix_1d(KUy, Uy.basis);
+        stiffness_matrix_1d(KUx, Ux.basis());
+        stiffness_matrix_1d(KUy, Uy.basis());
 
-        stiffness_matrix_1d(KUVx, Ux.basis, Vx.basis);
-        stiffness_matrix_1d(KUVy, Uy.basis, Vy.basis);
+        stiffness_matrix_1d(KUVx, Ux.basis(), Vx.basis());
+        stiffness_matrix_1d(KUVy, Uy.basis(), Vy.basis());
 
-        stiffness_matrix_1d(KUUx, Ux.basis, Ux.basis);
-        stiffness_matrix_1d(KUUy, Uy.basis, Uy.basis);
+        stiffness_matrix_1d(KUUx, Ux.basis(), Ux.basis());
+        stiffness_matrix_1d(KUUy, Uy.basis(), Uy.basis());
 
-        advection_matrix_1d(AUVx, Ux.basis, Vx.basis);
-        advection_matrix_1d(AUVy, Uy.basis, Vy.basis);
+        advection_matrix_1d(AUVx, Ux.basis(), Vx.basis());
+        advection_matrix_1d(AUVy, Uy.basis(), Vy.basis());
 
-        advection_matrix_1d(AUUx, Ux.basis, Ux.basis);
-        advection_matrix_1d(AUUy, Uy.basis, Uy.basis);
+        advection_matrix_1d(AUUx, Ux.basis(), Ux.basis());
+        advection_matrix_1d(AUUy, Uy.basis(), Uy.basis());
     }
 
     double init_state(double /*x*/, double /*y*/) {
@@ -265,8 +264,8 @@ class erikkson_mumps_split : public erikkson_base {
         Uy.factorize_matrix();
 
         auto init = [this](double x, double y) { return init_state(x, y); };
-        compute_projection(u, Ux.basis, Uy.basis, init);
-        ads_solve(u, u_buffer, Ux.data(), Uy.data());
+        compute_projection(u, Ux.basis(), Uy.basis(), init);
+        ads_solve(u, Ux.data(), Uy.data());
 
         zero(r.data);
         zero(u);
@@ -376,60 +375,23 @@ class erikkson_mumps_split : public erikkson_base {
 
     template <typename Fun>
     void compute_rhs(double cx, double cy, const dimension& Vx, const dimension& Vy,
-                     vector_view& r_rhs, vector_view& u_rhs, double dt, Fun&& F) {
-        executor.for_each(elements(Vx, Vy), [&](index_type e) {
-            auto R = vector_type{{Vx.basis.dofs_per_element(), Vy.basis.dofs_per_element()}};
-            auto U = vector_type{{Ux.basis.dofs_per_element(), Uy.basis.dofs_per_element()}};
-
-            double J = jacobian(e);
-            for (auto q : quad_points(Vx, Vy)) {
-                double W = weight(q);
-                double WJ = W * J;
-                auto x = point(e, q);
-                value_type uu = eval(u, e, q, Ux, Uy);
-                // value_type rr = eval(r.data, e, q, *r.Vx, *r.Vy);
-
-                for (auto a : dofs_on_element(e, Vx, Vy)) {
-                    auto aa = dof_global_to_local(e, a, Vx, Vy);
-                    value_type v = eval_basis(e, q, a, Vx, Vy);
-
-                    double M = uu.val * v.val;
-                    double Lx = c_diff[0] * uu.dx * v.dx + beta[0] * uu.dx * v.val;
-                    double Ly = c_diff[1] * uu.dy * v.dy + beta[1] * uu.dy * v.val;
-
-                    double lv = M + cx * Lx + cy * Ly + dt * F(x) * v.val;
-                    double val = -lv;
-
-                    // val += alpha * rr.val * v.val;
-                    // if (with_x) val -= hh * rr.dx * v.dx;
-                    // if (with_y) val -= hh * rr.dy * v.dy;
-
-                    R(aa[0], aa[1]) += val * WJ;
-                }
-                // for (auto a : dofs_on_element(e, Ux, Uy)) {
-                //     auto aa = dof_global_to_local(e, a, Ux, Uy);
-                //     value_type w = eval_basis(e, q, a, Ux, Uy);
-                //     double val = 0;
-                //     if (with_y) {
-                //         val += c_diff[0] * w.dx * rr.dx + beta[0] * w.dx * rr.val;
-                //         val += c_diff[1] * w.dy * rr.dy + beta[1] * w.dy * rr.val;
-                //     }
-                //     val += gamma * w.val * uu.val;
-                //     U(aa[0], aa[1]) += val * WJ;
-                // }
-            }
-            executor.synchronized([&]() {
-                update_global_rhs(r_rhs, R, e, Vx, Vy);
-                update_global_rhs(u_rhs, U, e, Ux, Uy);
-            });
-        });
+                     vector_view& r_rhs, vector_view& /*u_rhs*/, double dt, Fun&& F) {
+        // -(u, v) - cx Lx(u, v) - cy Ly(u, v) - dt (F, v)
+        auto form = [&](point_type x, value_type uu) {
+            double const val = uu.val + cx * beta[0] * uu.dx + cy * beta[1] * uu.dy + dt * F(x);
+            return value_type{-val, -cx * c_diff[0] * uu.dx, -cy * c_diff[1] * uu.dy};
+        };
+        assemble_rhs(r_rhs, {&Vx.basis(), &Vy.basis()}, u, {&Ux.basis(), &Uy.basis()}, form,
+                     executor);
     }
 
     // template <typename Form>
     // void add_to_rhs(const dimension& Vx, const dimension& Vy, vector_view& r_rhs, Form&& form) {
     //     executor.for_each(elements(Vx, Vy), [&](index_type e) {
-    //         auto R = vector_type{{ Vx.basis.dofs_per_element(), Vy.basis.dofs_per_element() }};
-    //         auto U = vector_type{{ Ux.basis.dofs_per_element(), Uy.basis.dofs_per_element() }};
+    //         auto R = vector_type{{ Vx.basis().dofs_per_element(),
+    //                                Vy.basis().dofs_per_element() }};
+    //         auto U = vector_type{{ Ux.basis().dofs_per_element(),
+    //                                Uy.basis().dofs_per_element() }};
 
     //         double J = jacobian(e);
     //         for (auto q : quad_points(Vx, Vy)) {
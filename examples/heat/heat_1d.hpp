@@ -68,7 +68,7 @@ class heat_1d : public simulation_1d {
     }
 
     void compute_rhs() {
-        const auto& bx = x.basis;
+        const auto& bx = x.basis();
         auto& rhs = u;
 
         zero(rhs);
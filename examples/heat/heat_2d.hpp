@@ -4,11 +4,13 @@
 #ifndef HEAT_HEAT_2D_HPP
 #define HEAT_HEAT_2D_HPP
 
-#include <galois/Timer.h>
+#include <chrono>
+#include <iostream>
 
-#include "ads/executor/galois.hpp"
+#include "ads/executor/thread_pool.hpp"
 #include "ads/output_manager.hpp"
 #include "ads/simulation.hpp"
+#include "ads/sum_factorization.hpp"
 
 namespace ads::problems {
 
@@ -18,8 +20,8 @@ class heat_2d : public simulation_2d {
     vector_type u, u_prev;
 
     output_manager<2> output;
-    galois_executor executor{1};
-    galois::StatTimer integration_timer{"integration"};
+    thread_pool_executor executor;
+    std::chrono::steady_clock::duration integration_time{};
 
 public:
     explicit heat_2d(const config_2d& config)
@@ -39,11 +41,11 @@ class heat_2d : public simulation_2d {
 private:
     void solve(vector_type& v) {
         lin::vector buf{{y.dofs()}};
-        compute_projection(buf, y.basis, [](double y) { return std::sin(y * M_PI); });
+        compute_projection(buf, y.basis(), [](double y) { return std::sin(y * M_PI); });
         for (int i = 0; i < y.dofs(); ++i) {
             v(0, i) = buf(i);
         }
-        Base::solve(v);
+        Base::solve(v, executor);
     }
 
     void prepare_matrices() {
@@ -78,35 +80,23 @@ class heat_2d : public simulation_2d {
     }
 
     void compute_rhs() {
-        integration_timer.start();
+        auto const start = std::chrono::steady_clock::now();
         auto& rhs = u;
 
         zero(rhs);
 
-        executor.for_each(elements(), [&](index_type e) {
-            auto U = element_rhs();
-
-            double J = jacobian(e);
-            for (auto q : quad_points()) {
-                double w = weight(q);
-                for (auto a : dofs_on_element(e)) {
-                    auto aa = dof_global_to_local(e, a);
-                    value_type v = eval_basis(e, q, a);
-                    value_type u = eval_fun(u_prev, e, q);
-
-                    double gradient_prod = grad_dot(u, v);
-                    double val = u.val * v.val - steps.dt * gradient_prod;
-                    U(aa[0], aa[1]) += val * w * J;
-                }
-            }
-
-            executor.synchronized([&]() { update_global_rhs(rhs, U, e); });
-        });
-        integration_timer.stop();
+        // (u, v) - dt (grad u, grad v)
+        auto form = [this](point_type, value_type u) {
+            double const dt = steps.dt;
+            return value_type{u.val, -dt * u.dx, -dt * u.dy};
+        };
+        assemble_rhs(rhs, u_prev, {&x.basis(), &y.basis()}, form, executor);
+        integration_time += std::chrono::steady_clock::now() - start;
     }
 
     void after() override {
-        std::cout << "integration: " << static_cast<double>(integration_timer.get()) << std::endl;
+        auto const ms = std::chrono::duration<double, std::milli>(integration_time).count();
+        std::cout << "integration: " << ms << std::endl;
     }
 };
 
@@ -5,6 +5,7 @@
 #define HEAT_HEAT_3D_HPP
 
 #include "ads/simulation.hpp"
+#include "ads/solution_cache.hpp"
 
 namespace ads::problems {
 
@@ -12,33 +13,40 @@ class heat_3d : public simulation_3d {
 private:
     using Base = simulation_3d;
     vector_type u, u_prev;
+    solution_cache<3> prev;  // values and gradients of u_prev
 
 public:
     explicit heat_3d(const config_3d& config)
     : Base{config}
     , u{shape()}
-    , u_prev{shape()} { }
+    , u_prev{shape()}
+    , prev{{&x.basis(), &y.basis(), &z.basis()}} { }
 
-    double init_state(double x, double y, double z) {
+    static double init_state(double x, double y, double z) {
         double dx = x - 0.5;
         double dy = y - 0.5;
         double dz = z - 0.5;
         double r2 = std::min(8 * (dx * dx + dy * dy + dz * dz), 1.0);
         return (r2 - 1) * (r2 - 1) * (r2 + 1) * (r2 + 1);
-    };
+    }
+
+    // (u, v) - dt (grad u, grad v) as coefficients of the value and gradient of test function v
+    static value_type rhs_form(value_type u, double dt) {
+        return value_type{u.val, -dt * u.dx, -dt * u.dy, -dt * u.dz};
+    }
 
 private:
     void before() override {
         prepare_matrices();
 
-        auto init = [this](double x, double y, double z) { return init_state(x, y, z); };
-        projection(u, init);
+        projection(u, init_state);
         solve(u);
     }
 
     void before_step(int /*iter*/, double /*t*/) override {
         using std::swap;
         swap(u, u_prev);
+        prev.invalidate();
     }
 
     void step(int /*iter*/, double /*t*/) override {
@@ -50,20 +58,9 @@ class heat_3d : public simulation_3d {
         auto& rhs = u;
 
         zero(rhs);
-        for (auto e : elements()) {
-            double J = jacobian(e);
-            for (auto q : quad_points()) {
-                double w = weight(q);
-                for (auto a : dofs_on_element(e)) {
-                    value_type v = eval_basis(e, q, a);
-                    value_type u = eval_fun(u_prev, e, q);
-
-                    double gradient_prod = u.dx * v.dx + u.dy * v.dy + u.dz * v.dz;
-                    double val = u.val * v.val - steps.dt * gradient_prod;
-                    rhs(a[0], a[1], a[2]) += val * w * J;
-                }
-            }
-        }
+        auto form = [this](point_type, value_type u) { return rhs_form(u, steps.dt); };
+        prev.update(u_prev);
+        assemble_rhs(rhs, prev, form);
     }
 };
 
@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "heat_spacetime.hpp"
+
+int main() {
+    ads::dim_config dim{2, 8};
+    double slab = 0.25;
+    ads::dim_config time{2, 8, 0, slab};
+    ads::timesteps_config steps{4, slab};
+    int ders = 1;
+
+    ads::config_4d c{dim, dim, dim, time, steps, ders};
+    ads::problems::heat_spacetime sim{c};
+    sim.run();
+}
@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef HEAT_HEAT_SPACETIME_HPP
+#define HEAT_HEAT_SPACETIME_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/range/counting_range.hpp>
+
+#include "ads/executor/thread_pool.hpp"
+#include "ads/form_matrix.hpp"
+#include "ads/lin/band_solve.hpp"
+#include "ads/lin/fast_diagonalization.hpp"
+#include "ads/lin/kron_apply.hpp"
+#include "ads/output_manager.hpp"
+#include "ads/simulation.hpp"
+#include "ads/simulation/factorization_cache.hpp"
+
+namespace ads::problems {
+
+/**
+ * Heat equation u_t - alpha laplace(u) = f on [0, 1]^3 with homogeneous Neumann boundary
+ * conditions, solved with space-time Galerkin method. Each step solves the problem on one time
+ * slab [t0, t0 + dt], with all the time instants of the slab coupled in one system
+ *
+ *   (M (x) M (x) M) (x) A_t + alpha (K (x) M (x) M + M (x) K (x) M + M (x) M (x) K) (x) M_t
+ *
+ * where A_t(i, j) = (psi_j', psi_i) and the first row of the time matrices is replaced by the
+ * initial condition. In the basis of generalized eigenvectors of (K, M) in each spatial direction
+ * the spatial operator becomes diagonal, so the system splits into independent 1D problems in time
+ * (A_t + mu M_t) w = g, one for each spatial mode with eigenvalue mu. Transforming to and from the
+ * eigenbasis is done with Kronecker product sweeps. The time matrices do not change between the
+ * slabs and are factorized once, for each distinct eigenvalue.
+ */
+class heat_spacetime : public simulation_4d {
+private:
+    using Base = simulation_4d;
+    using space_vector = lin::tensor<double, 3>;
+
+    static constexpr double alpha = 0.05;
+    static constexpr double pi = M_PI;
+
+    vector_type u, buf;
+    space_vector u0;  // coefficients of the state at the beginning of the slab
+
+    std::array<lin::generalized_eigenbasis, 3> bases;
+    std::array<lin::dense_matrix, 3> V, Vt, VtM;
+    lin::band_matrix Mt, At, It;
+
+    // Factorized time matrices, one per distinct eigenvalue of the spatial operator
+    std::vector<lin::band_matrix> time_factors;
+    std::vector<lin::solver_ctx> time_ctx;
+    std::vector<int> mode_factor;  // index of the time matrix of each spatial mode
+
+    thread_pool_executor executor;
+
+    output_manager<4> output;
+
+public:
+    explicit heat_spacetime(const config_4d& config)
+    : Base{config}
+    , u{shape()}
+    , buf{shape()}
+    , u0{{x.dofs(), y.dofs(), z.dofs()}}
+    , bases{eigenbasis(x), eigenbasis(y), eigenbasis(z)}
+    , V{bases[0].vectors(), bases[1].vectors(), bases[2].vectors()}
+    , Vt{transpose(V[0]), transpose(V[1]), transpose(V[2])}
+    , VtM{times_mass(Vt[0], x), times_mass(Vt[1], y), times_mass(Vt[2], z)}
+    , Mt{t.p, t.p, t.dofs()}
+    , At{t.p, t.p, t.dofs()}
+    , It{0, 0, t.dofs()}
+    , output{x.B, y.B, z.B, t.B, 20} {
+        gram_matrix_1d(Mt, t.basis());
+        advection_matrix_1d(At, t.basis());
+        for (int i = 0; i < t.dofs(); ++i) {
+            It(i, i) = 1;
+        }
+    }
+
+    static double exact(double x, double y, double z, double t) {
+        return std::cos(pi * x) * std::cos(pi * y) * std::cos(pi * z) * (1 + t);
+    }
+
+    static double forcing(double x, double y, double z, double t) {
+        double const s = std::cos(pi * x) * std::cos(pi * y) * std::cos(pi * z);
+        return s * (1 + 3 * pi * pi * alpha * (1 + t));
+    }
+
+private:
+    void before() override {
+        x.factorize_matrix();
+        y.factorize_matrix();
+        z.factorize_matrix();
+
+        auto init = [](double x, double y, double z) { return exact(x, y, z, 0); };
+        compute_projection(u0, x.basis(), y.basis(), z.basis(), init);
+        ads_solve(u0, x.data(), y.data(), z.data());
+
+        factorize_time_matrices();
+    }
+
+    void step(int /*iter*/, double t0) override {
+        compute_rhs(t0);
+        solve_slab();
+
+        // value at the end of the slab (last time basis function interpolates)
+        int const last = t.dofs() - 1;
+        for (int i = 0; i < x.dofs(); ++i) {
+            for (int j = 0; j < y.dofs(); ++j) {
+                for (int k = 0; k < z.dofs(); ++k) {
+                    u0(i, j, k) = u(i, j, k, last);
+                }
+            }
+        }
+    }
+
+    void after_step(int iter, double t0) override {
+        auto solution = [t0](point_type p) {
+            double const val = exact(p[0], p[1], p[2], t0 + p[3]);
+            return value_type{val, 0, 0, 0, 0};
+        };
+        double const error = errorL2(u, x, y, z, t, solution);
+        double const norm = normL2(u, x, y, z, t);
+        std::cout << "slab " << iter << ": t = " << t0 + steps.dt << ", relative L2 error "
+                  << error / norm << std::endl;
+
+        output.to_file(u, steps.dt, "out_%d.vti", iter);
+    }
+
+    // Integrals of the forcing term, the first time row is replaced in solve_slab
+    void compute_rhs(double t0) {
+        zero(buf);
+        auto f = [t0](double x, double y, double z, double s) { return forcing(x, y, z, t0 + s); };
+        projection(buf, f);
+    }
+
+    void solve_slab() {
+        // to the spatial eigenbasis
+        lin::kron_apply(u, buf, {Vt[0], Vt[1], Vt[2], It});
+
+        // initial condition - coefficients of u0 in the eigenbasis
+        auto w0 = space_vector{u0.sizes()};
+        lin::kron_apply(w0, u0, {VtM[0], VtM[1], VtM[2]});
+
+        // independent problems in time for each spatial mode, solved in place - the values of a
+        // mode at consecutive time instants are stride apart
+        std::ptrdiff_t const stride = w0.size();
+        executor.for_each(boost::counting_range(std::ptrdiff_t{0}, stride), [&](auto mode) {
+            auto const f = mode_factor[mode];
+            double* const data = u.data() + mode;
+            data[0] = w0.data()[mode];
+            lin::solve_with_factorized_strided(time_factors[f], data, time_ctx[f], 1, stride);
+        });
+
+        // back to the B-spline basis
+        lin::kron_apply(buf, u, {V[0], V[1], V[2], It});
+        using std::swap;
+        swap(u, buf);
+    }
+
+    // Eigenvalue of the spatial operator for mode (i, j, k). The 1D eigenvalues are summed in
+    // ascending order, so that modes differing by a permutation of directions with the same
+    // spectra get exactly the same value.
+    double mode_eigenvalue(int i, int j, int k) const {
+        auto values = std::array{bases[0].values()[i], bases[1].values()[j], bases[2].values()[k]};
+        std::sort(begin(values), end(values));
+        return alpha * (values[0] + values[1] + values[2]);
+    }
+
+    void factorize_time_matrices() {
+        auto mu = std::vector<double>(u0.size());
+        for (int i = 0; i < x.dofs(); ++i) {
+            for (int j = 0; j < y.dofs(); ++j) {
+                for (int k = 0; k < z.dofs(); ++k) {
+                    mu[&u0(i, j, k) - u0.data()] = mode_eigenvalue(i, j, k);
+                }
+            }
+        }
+        auto distinct = mu;
+        std::sort(begin(distinct), end(distinct));
+        distinct.erase(std::unique(begin(distinct), end(distinct)), end(distinct));
+
+        mode_factor.resize(mu.size());
+        for (std::size_t m = 0; m < mu.size(); ++m) {
+            auto const it = std::lower_bound(begin(distinct), end(distinct), mu[m]);
+            mode_factor[m] = narrow_cast<int>(it - begin(distinct));
+        }
+
+        int const count = narrow_cast<int>(distinct.size());
+        time_factors.assign(distinct.size(), lin::band_matrix{t.p, t.p, t.dofs()});
+        time_ctx.assign(distinct.size(), lin::solver_ctx{time_factors[0]});
+        executor.for_each(boost::counting_range(0, count), [&](int f) {
+            time_matrix(time_factors[f], distinct[f]);
+            lin::factorize(time_factors[f], time_ctx[f]);
+        });
+        for (auto const& ctx : time_ctx) {
+            if (ctx.info != 0) {
+                throw std::runtime_error{"Singular time matrix, info = "
+                                         + std::to_string(ctx.info)};
+            }
+        }
+    }
+
+    // A_t + mu M_t with the first row replaced by the initial condition
+    void time_matrix(lin::band_matrix& T, double mu) const {
+        T.zero();
+        for (int i = 0; i < t.dofs(); ++i) {
+            for (int j = std::max(0, i - t.p); j <= std::min(t.dofs() - 1, i + t.p); ++j) {
+                T(i, j) = i == 0 ? 0 : At(i, j) + mu * Mt(i, j);
+            }
+        }
+        T(0, 0) = 1;
+    }
+
+    static lin::generalized_eigenbasis eigenbasis(const dimension& d) {
+        auto& cache = factorization_cache::global();
+        auto const M = cache.matrix(d.basis(), matrix_kind::mass);
+        auto const K = cache.matrix(d.basis(), matrix_kind::stiffness);
+        auto basis = lin::generalized_eigenbasis{*M, *K};
+        if (basis.info != 0) {
+            throw std::runtime_error{"dsygv failed for the generalized eigenproblem, info = "
+                                     + std::to_string(basis.info)};
+        }
+        return basis;
+    }
+
+    static lin::dense_matrix transpose(const lin::dense_matrix& A) {
+        auto out = lin::dense_matrix{A.cols(), A.rows()};
+        for (int i = 0; i < A.rows(); ++i) {
+            for (int j = 0; j < A.cols(); ++j) {
+                out(j, i) = A(i, j);
+            }
+        }
+        return out;
+    }
+
+    // A M, where M is the mass matrix of dimension d
+    static lin::dense_matrix times_mass(const lin::dense_matrix& A, const dimension& d) {
+        auto const M = factorization_cache::global().matrix(d.basis(), matrix_kind::mass);
+        auto out = lin::dense_matrix{A.rows(), M->cols};
+        for (int i = 0; i < A.rows(); ++i) {
+            for (int j = 0; j < M->cols; ++j) {
+                double sum = 0;
+                for (int k = std::max(0, j - M->ku); k <= std::min(M->rows - 1, j + M->kl); ++k) {
+                    sum += A(i, k) * (*M)(k, j);
+                }
+                out(i, j) = sum;
+            }
+        }
+        return out;
+    }
+};
+
+}  // namespace ads::problems
+
+#endif  // HEAT_HEAT_SPACETIME_HPP
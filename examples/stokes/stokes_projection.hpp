@@ -4,9 +4,12 @@
 #ifndef STOKES_STOKES_PROJECTION_HPP
 #define STOKES_STOKES_PROJECTION_HPP
 
-#include <galois/Timer.h>
+#include <chrono>
+#include <iostream>
+#include <string>
 
-#include "ads/executor/galois.hpp"
+#include "ads/element_coloring.hpp"
+#include "ads/executor/thread_pool.hpp"
 #include "ads/output_manager.hpp"
 #include "ads/simulation.hpp"
 #include "ads/simulation/utils.hpp"
@@ -199,7 +202,7 @@ class stokes_projection : public simulation_2d {
 
     Problem problem;
 
-    galois_executor executor{8};
+    thread_pool_executor executor;
 
     space_set trial, test;
 
@@ -210,8 +213,9 @@ class stokes_projection : public simulation_2d {
     mumps::solver solver;
     output_manager<2> outputU1, outputU2, outputP;
 
-    galois::Timer solver_timer;
-    galois::Timer total_timer;
+    using clock = std::chrono::steady_clock;
+    clock::duration solver_time{};  // time of the last solve
+    clock::time_point start_time;
 
 public:
     stokes_projection(const space_set& trial_, const space_set& test_,
@@ -229,9 +233,8 @@ class stokes_projection : public simulation_2d {
     , vy_prev{{trial.U2x.dofs(), trial.U2y.dofs()}}
     , outputU1{trial.U1x.B, trial.U1y.B, 200}
     , outputU2{trial.U2x.B, trial.U2y.B, 200}
-    , outputP{trial.Px.B, trial.Py.B, 200} {
-        total_timer.start();
-    }
+    , outputP{trial.Px.B, trial.Py.B, 200}
+    , start_time{clock::now()} { }
 
     void pressure_sum(vector_type& target, const vector_type& a, const vector_type& b) const {
         for (auto i : dofs(trial.Px, trial.Py)) {
@@ -262,11 +265,10 @@ class stokes_projection : public simulation_2d {
         trial.Py.factorize_matrix();
 
         auto project = [&](auto& rhs, auto& x, auto& y, auto fun) {
-            vector_type buffer{{x.dofs(), y.dofs()}};
-            compute_projection(rhs, x.basis, y.basis, [&](double x, double y) {
+            compute_projection(rhs, x.basis(), y.basis(), [&](double x, double y) {
                 return fun({x, y});
             });
-            ads_solve(rhs, buffer, x.data(), y.data());
+            ads_solve(rhs, x.data(), y.data());
         };
         project(vx, trial.U1x, trial.U1y,
                 [this](point_type x) { return problem.exact_v(x, 0)[0].val; });
@@ -291,11 +293,10 @@ class stokes_projection : public simulation_2d {
 
         auto project = [&](auto& x, auto& y, auto fun) {
             vector_type rhs{{x.dofs(), y.dofs()}};
-            vector_type buffer{{x.dofs(), y.dofs()}};
-            compute_projection(rhs, x.basis, y.basis, [&](double x, double y) {
+            compute_projection(rhs, x.basis(), y.basis(), [&](double x, double y) {
                 return fun({x, y});
             });
-            ads_solve(rhs, buffer, x.data(), y.data());
+            ads_solve(rhs, x.data(), y.data());
             return rhs;
         };
 
@@ -518,15 +519,13 @@ class stokes_projection : public simulation_2d {
     }
     void print_solver_info(const std::string& header, const mumps::problem& problem,
                            mumps::solver& solver) {
-        auto time = static_cast<double>(solver_timer.get());
+        auto time = std::chrono::duration<double, std::milli>(solver_time).count();
         std::cout << "Solver " << header << ": "                          //
                   << " NZ " << problem.nonzero_entries()                  //
                   << " time " << time << " ms"                            //
                   << " assembly FLOPS " << solver.flops_assembly()        //
                   << " elimination FLOPS " << solver.flops_elimination()  //
                   << std::endl;
-        // reset
-        solver_timer = galois::Timer{};
     }
 
     template <typename RHS>
@@ -707,9 +706,9 @@ class stokes_projection : public simulation_2d {
         mumps::problem problem_vx1{rhs};
         assemble_matrix_velocity(problem_vx1, dt / (2 * Re), 0);
 
-        solver_timer.start();
+        auto const problem_vx1_start = clock::now();
         solver.solve(problem_vx1);
-        solver_timer.stop();
+        solver_time = clock::now() - problem_vx1_start;
         print_solver_info("velocity 1", problem_vx1, solver);
 
         // Step 2
@@ -737,21 +736,16 @@ class stokes_projection : public simulation_2d {
         mumps::problem problem_vx2{rhs2};
         assemble_matrix_velocity(problem_vx2, 0, dt / (2 * Re));
 
-        solver_timer.start();
+        auto const problem_vx2_start = clock::now();
         solver.solve(problem_vx2);
-        solver_timer.stop();
+        solver_time = clock::now() - problem_vx2_start;
         print_solver_info("velocity 2", problem_vx2, solver);
 
         vx_prev = vx;
         vy_prev = vy;
 
-        // Update
-        for (auto i : dofs(trial.U1x, trial.U1y)) {
-            vx(i[0], i[1]) = vx2(i[0], i[1]);
-        }  // vx = vx2;
-        for (auto i : dofs(trial.U2x, trial.U2y)) {
-            vy(i[0], i[1]) = vy2(i[0], i[1]);
-        }  // vy = vy2;
+        lin::copy(vx2, vx);
+        lin::copy(vy2, vy);
     }
 
     void update_velocity_exact(double t) {
@@ -761,11 +755,10 @@ class stokes_projection : public simulation_2d {
         zero(vy);
 
         auto project = [&](auto& rhs, auto& x, auto& y, auto fun) {
-            vector_type buffer{{x.dofs(), y.dofs()}};
-            compute_projection(rhs, x.basis, y.basis, [&](double x, double y) {
+            compute_projection(rhs, x.basis(), y.basis(), [&](double x, double y) {
                 return fun({x, y});
             });
-            ads_solve(rhs, buffer, x.data(), y.data());
+            ads_solve(rhs, x.data(), y.data());
         };
         project(vx, trial.U1x, trial.U1y,
                 [this, tt](point_type x) { return problem.exact_v(x, tt)[0].val; });
@@ -797,11 +790,10 @@ class stokes_projection : public simulation_2d {
         double th = t + steps.dt / 2;
         zero(p);
         auto project = [&](auto& rhs, auto& x, auto& y, auto fun) {
-            vector_type buffer{{x.dofs(), y.dofs()}};
-            compute_projection(rhs, x.basis, y.basis, [&](double x, double y) {
+            compute_projection(rhs, x.basis(), y.basis(), [&](double x, double y) {
                 return fun({x, y});
             });
-            ads_solve(rhs, buffer, x.data(), y.data());
+            ads_solve(rhs, x.data(), y.data());
         };
         project(p, trial.Px, trial.Py,
                 [this, th](point_type x) { return problem.exact_p(x, th).val; });
@@ -820,9 +812,9 @@ class stokes_projection : public simulation_2d {
         mumps::problem problem_px{rhs};
         assemble_matrix_pressure(problem_px, 1, 0);
 
-        solver_timer.start();
+        auto const problem_px_start = clock::now();
         solver.solve(problem_px);
-        solver_timer.stop();
+        solver_time = clock::now() - problem_px_start;
         print_solver_info("pressure 1", problem_px, solver);
 
         // Step 2
@@ -834,9 +826,9 @@ class stokes_projection : public simulation_2d {
         mumps::problem problem_py{rhs2};
         assemble_matrix_pressure(problem_py, 0, 1);
 
-        solver_timer.start();
+        auto const problem_py_start = clock::now();
         solver.solve(problem_py);
-        solver_timer.stop();
+        solver_time = clock::now() - problem_py_start;
         print_solver_info("pressure 2", problem_py, solver);
 
         for (auto i : dofs(trial.Px, trial.Py)) {
@@ -871,10 +863,14 @@ class stokes_projection : public simulation_2d {
                      const S3& p, Fun&& forcing, double ax, double ay, double bx, double by,
                      double conv, double c, double d) const {
         using shape = std::array<int, 2>;
-        auto u1_shape = shape{test.U1x.basis.dofs_per_element(), test.U1y.basis.dofs_per_element()};
-        auto u2_shape = shape{test.U2x.basis.dofs_per_element(), test.U2y.basis.dofs_per_element()};
-
-        executor.for_each(elements(trial.Px, trial.Py), [&](index_type e) {
+        auto u1_shape =
+            shape{test.U1x.basis().dofs_per_element(), test.U1y.basis().dofs_per_element()};
+        auto u2_shape =
+            shape{test.U2x.basis().dofs_per_element(), test.U2y.basis().dofs_per_element()};
+        auto const coloring = element_coloring<2>{{&test.U1x.basis(), &test.U1y.basis()},
+                                                  {&test.U2x.basis(), &test.U2y.basis()}};
+
+        for_each_colored(coloring, executor, [&](index_type e) {
             auto vx_loc = vector_type{u1_shape};
             auto vy_loc = vector_type{u2_shape};
 
@@ -918,10 +914,8 @@ class stokes_projection : public simulation_2d {
                     vy_loc(aa[0], aa[1]) += val * W * J;
                 }
             }
-            executor.synchronized([&]() {
-                update_global_rhs(rhsx, vx_loc, e, test.U1x, test.U1y);
-                update_global_rhs(rhsy, vy_loc, e, test.U2x, test.U2y);
-            });
+            update_global_rhs(rhsx, vx_loc, e, test.U1x, test.U1y);
+            update_global_rhs(rhsy, vy_loc, e, test.U2x, test.U2y);
         });
     }
 
@@ -929,9 +923,10 @@ class stokes_projection : public simulation_2d {
     void compute_rhs_pressure_1(RHS& rhs, const Sol& vx, const Sol& vy, const dimension& Vx,
                                 const dimension& Vy, double dt) const {
         using shape = std::array<int, 2>;
-        auto p_shape = shape{Vx.basis.dofs_per_element(), Vy.basis.dofs_per_element()};
+        auto p_shape = shape{Vx.basis().dofs_per_element(), Vy.basis().dofs_per_element()};
+        auto const coloring = element_coloring<2>{{&Vx.basis(), &Vy.basis()}};
 
-        executor.for_each(elements(trial.Px, trial.Py), [&](index_type e) {
+        for_each_colored(coloring, executor, [&](index_type e) {
             auto loc = vector_type{p_shape};
 
             double J = jacobian(e);
@@ -948,7 +943,7 @@ class stokes_projection : public simulation_2d {
                     loc(aa[0], aa[1]) += val * W * J;
                 }
             }
-            executor.synchronized([&]() { update_global_rhs(rhs, loc, e, Vx, Vy); });
+            update_global_rhs(rhs, loc, e, Vx, Vy);
         });
     }
 
@@ -956,9 +951,10 @@ class stokes_projection : public simulation_2d {
     void compute_rhs_pressure_2(RHS& rhs, const Sol& p, const dimension& Vx,
                                 const dimension& Vy) const {
         using shape = std::array<int, 2>;
-        auto p_shape = shape{Vx.basis.dofs_per_element(), Vy.basis.dofs_per_element()};
+        auto p_shape = shape{Vx.basis().dofs_per_element(), Vy.basis().dofs_per_element()};
+        auto const coloring = element_coloring<2>{{&Vx.basis(), &Vy.basis()}};
 
-        executor.for_each(elements(trial.Px, trial.Py), [&](index_type e) {
+        for_each_colored(coloring, executor, [&](index_type e) {
             auto loc = vector_type{p_shape};
 
             double J = jacobian(e);
@@ -974,7 +970,7 @@ class stokes_projection : public simulation_2d {
                     loc(aa[0], aa[1]) += val * W * J;
                 }
             }
-            executor.synchronized([&]() { update_global_rhs(rhs, loc, e, Vx, Vy); });
+            update_global_rhs(rhs, loc, e, Vx, Vy);
         });
     }
 
@@ -983,9 +979,11 @@ class stokes_projection : public simulation_2d {
         auto Re = problem.Re;
 
         using shape = std::array<int, 2>;
-        auto p_shape = shape{trial.Px.basis.dofs_per_element(), trial.Py.basis.dofs_per_element()};
+        auto p_shape =
+            shape{trial.Px.basis().dofs_per_element(), trial.Py.basis().dofs_per_element()};
+        auto const coloring = element_coloring<2>{{&trial.Px.basis(), &trial.Py.basis()}};
 
-        executor.for_each(elements(trial.Px, trial.Py), [&](index_type e) {
+        for_each_colored(coloring, executor, [&](index_type e) {
             auto loc = vector_type{p_shape};
 
             double J = jacobian(e);
@@ -1008,7 +1006,7 @@ class stokes_projection : public simulation_2d {
                     loc(aa[0], aa[1]) += val * W * J;
                 }
             }
-            executor.synchronized([&]() { update_global_rhs(rhs, loc, e, trial.Px, trial.Py); });
+            update_global_rhs(rhs, loc, e, trial.Px, trial.Py);
         });
     }
 
@@ -1069,8 +1067,7 @@ class stokes_projection : public simulation_2d {
     }
 
     void after() override {
-        total_timer.stop();
-        auto time = static_cast<double>(total_timer.get()) / 1000.0;
+        auto time = std::chrono::duration<double>(clock::now() - start_time).count();
         std::cout << "Total time: " << time << " s" << std::endl;
     }
 
@@ -1118,7 +1115,10 @@ class stokes_projection : public simulation_2d {
 
     template <typename RHS>
     void zero_bc(RHS& u, dimension& Ux, dimension& Uy) const {
-        for_boundary_dofs(Ux, Uy, [&](index_type i) { u(i[0], i[1]) = 0; });
+        lin::assign(u.template slice<0>(0), 0.0);
+        lin::assign(u.template slice<0>(Ux.dofs() - 1), 0.0);
+        lin::assign(u.template slice<1>(0), 0.0);
+        lin::assign(u.template slice<1>(Uy.dofs() - 1), 0.0);
     }
 
     template <typename Sol, typename Fun>
@@ -1161,8 +1161,8 @@ class stokes_projection : public simulation_2d {
 
             auto loc = dof_global_to_local(e, b, space.U1x, space.U1y);
 
-            const auto& bx = space.U1x.basis;
-            const auto& by = space.U1y.basis;
+            const auto& bx = space.U1x.basis();
+            const auto& by = space.U1y.basis();
 
             double B2 = by.b[e[1]][q[1]][0][loc[1]];
             double dB1 = bx.b[e[0]][q[0]][1][loc[0]];
@@ -1182,8 +1182,8 @@ class stokes_projection : public simulation_2d {
 
             auto loc = dof_global_to_local(e, b, space.U2x, space.U2y);
 
-            const auto& bx = space.U2x.basis;
-            const auto& by = space.U2y.basis;
+            const auto& bx = space.U2x.basis();
+            const auto& by = space.U2y.basis();
 
             double B1 = bx.b[e[0]][q[0]][0][loc[0]];
             double dB1 = bx.b[e[0]][q[0]][1][loc[0]];
@@ -1202,8 +1202,8 @@ class stokes_projection : public simulation_2d {
     }
 
     bool overlap(int a, const dimension& U, int b, const dimension& V) const {
-        auto ar = U.basis.element_ranges[a];
-        auto br = V.basis.element_ranges[b];
+        auto ar = U.basis().element_ranges[a];
+        auto br = V.basis().element_ranges[b];
         return (ar.first >= br.first && ar.first <= br.second)
             || (br.first >= ar.first && br.first <= ar.second);
     }
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_ASSEMBLY_HPP
+#define ADS_ASSEMBLY_HPP
+
+#include <array>
+#include <cstddef>
+
+#include <boost/range/counting_range.hpp>
+
+#include "ads/basis_data.hpp"
+#include "ads/element_coloring.hpp"
+#include "ads/executor/chunking.hpp"
+#include "ads/executor/per_thread.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/util.hpp"
+
+namespace ads {
+
+namespace detail {
+
+template <std::size_t Dim, typename Executor, typename Fun>
+void for_each_element_chunk(const std::array<const basis_data*, Dim>& bases,
+                            const Executor& executor, Fun&& fun) {
+    std::ptrdiff_t elements = 1;
+    for (auto const* basis : bases) {
+        elements *= basis->elements;
+    }
+    auto const chunks = chunk_count(executor, elements);
+
+    executor.for_each(boost::counting_range(0, chunks), [&](int chunk) {
+        fun(chunk * elements / chunks, (chunk + 1) * elements / chunks);
+    });
+}
+
+template <std::size_t Dim>
+auto element_index(std::ptrdiff_t idx, const std::array<const basis_data*, Dim>& bases)
+    -> std::array<int, Dim> {
+    auto e = std::array<int, Dim>{};
+    for (std::size_t i = 0; i < Dim; ++i) {
+        e[i] = narrow_cast<int>(idx % bases[i]->elements);
+        idx /= bases[i]->elements;
+    }
+    return e;
+}
+
+template <std::size_t Dim>
+auto first_dofs(const std::array<int, Dim>& e, const std::array<const basis_data*, Dim>& bases)
+    -> std::array<int, Dim> {
+    auto first = std::array<int, Dim>{};
+    for (std::size_t i = 0; i < Dim; ++i) {
+        first[i] = bases[i]->first_dof(e[i]);
+    }
+    return first;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Ways of avoiding conflicting updates of the global vector in parallel assembly.
+ */
+enum class assembly_mode {
+    // Updates are synchronized using the executor
+    locked,
+    // Elements are processed color by color, see element_coloring
+    colored,
+    // Each thread accumulates into its own copy of the global vector, copies are summed at the end
+    reduction,
+};
+
+/**
+ * @brief Assembles global vector from contributions of the elements.
+ *
+ * Elements are split into chunks processed by @p executor. For each chunk, a worker is created by
+ * @p make_worker and called as worker(e, local) for each element e of the chunk, to compute the
+ * local contributions (with previous contents of @p local overwritten). They are then added to
+ * @p rhs, the way specified by @p mode.
+ *
+ * With assembly_mode::reduction, memory required for the copies is proportional to the number of
+ * threads, which makes it suitable for coarse meshes where coloring leaves few elements per color.
+ */
+template <std::size_t Dim, typename RhsImpl, typename Executor, typename MakeWorker>
+void assemble_elements(lin::tensor_base<double, Dim, RhsImpl>& rhs,
+                       const std::array<const basis_data*, Dim>& bases, const Executor& executor,
+                       assembly_mode mode, MakeWorker&& make_worker) {
+    auto dofs = std::array<int, Dim>{};
+    for (std::size_t i = 0; i < Dim; ++i) {
+        dofs[i] = bases[i]->dofs_per_element();
+    }
+    auto add = [&](auto& out, const auto& e, const auto& local) {
+        lin::axpy(1.0, local, out.block(detail::first_dofs(e, bases), dofs));
+    };
+
+    switch (mode) {
+    case assembly_mode::locked: {
+        auto assemble_chunk = [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+            auto worker = make_worker();
+            auto local = lin::tensor<double, Dim>{dofs};
+            for (auto idx = begin; idx < end; ++idx) {
+                auto const e = detail::element_index(idx, bases);
+                worker(e, local);
+                executor.synchronized([&]() { add(rhs, e, local); });
+            }
+        };
+        detail::for_each_element_chunk(bases, executor, assemble_chunk);
+        break;
+    }
+    case assembly_mode::colored: {
+        auto const coloring = element_coloring<Dim>{bases};
+        auto assemble_chunk = [&](int c, std::ptrdiff_t begin, std::ptrdiff_t end) {
+            auto worker = make_worker();
+            auto local = lin::tensor<double, Dim>{dofs};
+            for (auto idx = begin; idx < end; ++idx) {
+                auto const e = coloring.element(c, idx);
+                worker(e, local);
+                add(rhs, e, local);
+            }
+        };
+        for_each_colored_chunk(coloring, executor, assemble_chunk);
+        break;
+    }
+    case assembly_mode::reduction: {
+        using tensor_type = lin::tensor<double, Dim>;
+        auto partial = per_thread<tensor_type>{[&] { return tensor_type{rhs.sizes()}; }};
+        auto assemble_chunk = [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+            auto worker = make_worker();
+            auto local = tensor_type{dofs};
+            auto& out = partial.local();
+            for (auto idx = begin; idx < end; ++idx) {
+                auto const e = detail::element_index(idx, bases);
+                worker(e, local);
+                add(out, e, local);
+            }
+        };
+        detail::for_each_element_chunk(bases, executor, assemble_chunk);
+        partial.reduce(rhs, executor, [](auto& a, const tensor_type& b) { lin::axpy(1.0, b, a); });
+        break;
+    }
+    }
+}
+
+}  // namespace ads
+
+#endif  // ADS_ASSEMBLY_HPP
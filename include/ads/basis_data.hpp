@@ -4,20 +4,119 @@
 #ifndef ADS_BASIS_DATA_HPP
 #define ADS_BASIS_DATA_HPP
 
+#include <cstddef>
 #include <utility>
 #include <vector>
 
 #include <boost/range/counting_range.hpp>
 
 #include "ads/bspline/bspline.hpp"
+#include "ads/lin/allocator.hpp"
 
 namespace ads {
 
 using element_id = int;
 using dof_id = int;
 
-// TODO: use proper multidimensional arrays
-// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions, hicpp-special-member-functions)
+/**
+ * @brief Arrays of equal length, one per element, stored contiguously.
+ *
+ * Indexing with element yields pointer to its array, so that values can be accessed as a[e][i].
+ */
+class element_arrays {
+private:
+    std::vector<double, lin::default_allocator<double>> data_;
+    int size_ = 0;
+
+public:
+    element_arrays() = default;
+
+    element_arrays(int elements, int size)
+    : data_(static_cast<std::size_t>(elements) * static_cast<std::size_t>(size))
+    , size_{size} { }
+
+    int size() const { return size_; }
+
+    const double* operator[](element_id e) const { return data_.data() + e * size_; }
+
+    double* operator[](element_id e) { return data_.data() + e * size_; }
+};
+
+/**
+ * @brief Values and derivatives of basis functions at quadrature points of all the elements.
+ *
+ * All the values are stored in a single aligned buffer, laid out as
+ * [element][derivative][quadrature point][dof], so that for a given element and derivative order
+ * values form a contiguous (quadrature points x dofs) row-major matrix (see table), which is the
+ * form used by sum factorization.
+ *
+ * Values can also be accessed as b[e][q][d][a], through lightweight views.
+ */
+class basis_values {
+private:
+    std::vector<double, lin::default_allocator<double>> data_;
+    int quad_order_ = 0;
+    int dofs_ = 0;
+    int derivatives_ = 0;
+
+public:
+    // Values of basis functions at a single quadrature point, indexed by derivative order
+    class point_view {
+    private:
+        const double* data_;
+        int stride_;
+
+    public:
+        point_view(const double* data, int stride)
+        : data_{data}
+        , stride_{stride} { }
+
+        const double* operator[](int d) const { return data_ + d * stride_; }
+    };
+
+    // Values of basis functions on a single element, indexed by quadrature point
+    class element_view {
+    private:
+        const double* data_;
+        int dofs_;
+        int stride_;
+
+    public:
+        element_view(const double* data, int dofs, int stride)
+        : data_{data}
+        , dofs_{dofs}
+        , stride_{stride} { }
+
+        point_view operator[](int q) const { return {data_ + q * dofs_, stride_}; }
+    };
+
+    basis_values() = default;
+
+    basis_values(int elements, int quad_order, int dofs, int derivatives)
+    : data_(static_cast<std::size_t>(elements) * static_cast<std::size_t>(derivatives + 1)
+            * static_cast<std::size_t>(quad_order) * static_cast<std::size_t>(dofs))
+    , quad_order_{quad_order}
+    , dofs_{dofs}
+    , derivatives_{derivatives} { }
+
+    element_view operator[](element_id e) const {
+        return {table(e, 0), dofs_, table_size()};
+    }
+
+    // Values of derivatives of order d on element e, as (quadrature points x dofs) matrix
+    const double* table(element_id e, int d) const { return data_.data() + offset(e, d); }
+
+    double* table(element_id e, int d) { return data_.data() + offset(e, d); }
+
+private:
+    int table_size() const { return quad_order_ * dofs_; }
+
+    std::ptrdiff_t offset(element_id e, int d) const {
+        auto const tables = static_cast<std::ptrdiff_t>(e) * (derivatives_ + 1) + d;
+        return tables * table_size();
+    }
+};
+
 struct basis_data {
     using range_type = decltype(boost::counting_range(0, 0));
 
@@ -32,20 +131,10 @@ struct basis_data {
     int elem_division;
     std::vector<double> points;
     bspline::basis basis;
-    double**** b;
-    double** x;
+    basis_values b;
+    element_arrays x;
     const double* w;
-    double* J;
-
-    ~basis_data();
-
-    basis_data(const basis_data& other);
-
-    basis_data& operator=(const basis_data& other) {
-        auto tmp = other;
-        swap(*this, tmp);
-        return *this;
-    }
+    std::vector<double> J;
 
     basis_data(bspline::basis basis, int derivatives)
     : basis_data{std::move(basis), derivatives, basis.degree + 1, 1} { }
@@ -65,24 +154,6 @@ struct basis_data {
     range_type element_range(dof_id dof) const {
         return boost::counting_range(element_ranges[dof].first, element_ranges[dof].second + 1);
     }
-
-    friend void swap(basis_data& a, basis_data& b) noexcept {
-        using std::swap;
-        swap(a.first_dofs, b.first_dofs);
-        swap(a.element_ranges, b.element_ranges);
-        swap(a.degree, b.degree);
-        swap(a.elements, b.elements);
-        swap(a.dofs, b.dofs);
-        swap(a.derivatives, b.derivatives);
-        swap(a.quad_order, b.quad_order);
-        swap(a.elem_division, b.elem_division);
-        swap(a.points, b.points);
-        swap(a.basis, b.basis);
-        swap(a.b, b.b);
-        swap(a.x, b.x);
-        swap(a.w, b.w);
-        swap(a.J, b.J);
-    }
 };
 
 }  // namespace ads
@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_ELEMENT_COLORING_HPP
+#define ADS_ELEMENT_COLORING_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include <boost/range/counting_range.hpp>
+
+#include "ads/basis_data.hpp"
+#include "ads/executor/chunking.hpp"
+#include "ads/util.hpp"
+
+namespace ads {
+
+/**
+ * @brief Colors elements of a 1D mesh so that elements of the same color share no dofs.
+ *
+ * Elements are colored greedily from left to right, which gives the minimal number of colors,
+ * e.g. p + 1 for a basis of degree p with maximal continuity. All the bases need to have the same
+ * elements, and elements of the same color share no dofs in any of them.
+ *
+ * @return color of each element
+ */
+std::vector<int> color_elements(const std::vector<const basis_data*>& bases);
+
+/**
+ * @brief Partition of tensor product elements into colors, such that elements of the same color
+ * share no dofs.
+ *
+ * Elements of one color can be assembled in parallel without synchronizing updates of the global
+ * vector. Coloring is a product of 1D colorings (see color_elements), so on a mesh with maximal
+ * continuity there are (p + 1)^Dim colors.
+ */
+template <std::size_t Dim>
+class element_coloring {
+public:
+    using index_type = std::array<int, Dim>;
+    using bases_type = std::array<const basis_data*, Dim>;
+
+private:
+    std::array<std::vector<int>, Dim> colors_;                  // [dim][element]
+    std::array<std::vector<std::vector<int>>, Dim> elements_;  // [dim][color] -> elements
+    int color_count_ = 1;
+
+public:
+    explicit element_coloring(const bases_type& bases)
+    : element_coloring{{bases}} { }
+
+    /**
+     * @brief Creates coloring valid for all the given spaces, e.g. when assembling right-hand
+     * sides of several equations in one loop.
+     *
+     * All the spaces need to have the same elements.
+     */
+    element_coloring(std::initializer_list<bases_type> spaces) {
+        assert(spaces.size() > 0 && "No spaces to color");
+        for (std::size_t i = 0; i < Dim; ++i) {
+            auto bases = std::vector<const basis_data*>{};
+            for (auto const& space : spaces) {
+                bases.push_back(space[i]);
+            }
+            colors_[i] = color_elements(bases);
+
+            auto const count = *std::max_element(begin(colors_[i]), end(colors_[i])) + 1;
+            elements_[i].resize(static_cast<std::size_t>(count));
+            for (int e = 0; e < narrow_cast<int>(colors_[i].size()); ++e) {
+                elements_[i][static_cast<std::size_t>(colors_[i][e])].push_back(e);
+            }
+            color_count_ *= count;
+        }
+    }
+
+    int colors() const { return color_count_; }
+
+    int color(const index_type& e) const {
+        int c = 0;
+        for (std::size_t i = Dim; i-- > 0;) {
+            c = c * narrow_cast<int>(elements_[i].size()) + colors_[i][e[i]];
+        }
+        return c;
+    }
+
+    // Number of elements of the given color
+    std::ptrdiff_t size(int color) const {
+        std::ptrdiff_t n = 1;
+        for (std::size_t i = 0; i < Dim; ++i) {
+            n *= narrow_cast<std::ptrdiff_t>(color_elements_(color, i).size());
+        }
+        return n;
+    }
+
+    // Element number @p idx among the elements of the given color
+    index_type element(int color, std::ptrdiff_t idx) const {
+        auto e = index_type{};
+        for (std::size_t i = 0; i < Dim; ++i) {
+            auto const& elems = color_elements_(color, i);
+            auto const n = narrow_cast<std::ptrdiff_t>(elems.size());
+            e[i] = elems[static_cast<std::size_t>(idx % n)];
+            idx /= n;
+        }
+        return e;
+    }
+
+private:
+    // Elements along dimension i with 1D color matching the given color
+    const std::vector<int>& color_elements_(int color, std::size_t i) const {
+        for (std::size_t j = 0; j < i; ++j) {
+            color /= narrow_cast<int>(elements_[j].size());
+        }
+        auto const c = color % narrow_cast<int>(elements_[i].size());
+        return elements_[i][static_cast<std::size_t>(c)];
+    }
+};
+
+/**
+ * @brief Calls @p fun(e) for each element, processing colors one after another, and elements of
+ * each color in parallel using @p executor.
+ *
+ * Since elements of one color share no dofs, @p fun can update the global vector without
+ * synchronization.
+ */
+template <std::size_t Dim, typename Executor, typename Fun>
+void for_each_colored(const element_coloring<Dim>& coloring, const Executor& executor,
+                      Fun&& fun) {
+    for (int c = 0; c < coloring.colors(); ++c) {
+        auto const n = coloring.size(c);
+        executor.for_each(boost::counting_range(std::ptrdiff_t{0}, n),
+                          [&](std::ptrdiff_t idx) { fun(coloring.element(c, idx)); });
+    }
+}
+
+/**
+ * @brief Same as for_each_colored, but calls @p fun(color, begin, end) for chunks of elements of
+ * each color, so that buffers can be reused between elements of a chunk.
+ *
+ * Elements of a chunk are coloring.element(color, idx) for idx in [begin, end).
+ */
+template <std::size_t Dim, typename Executor, typename Fun>
+void for_each_colored_chunk(const element_coloring<Dim>& coloring, const Executor& executor,
+                            Fun&& fun) {
+    for (int c = 0; c < coloring.colors(); ++c) {
+        auto const n = coloring.size(c);
+        auto const chunks = chunk_count(executor, n);
+        executor.for_each(boost::counting_range(0, chunks), [&](int chunk) {
+            fun(c, chunk * n / chunks, (chunk + 1) * n / chunks);
+        });
+    }
+}
+
+}  // namespace ads
+
+#endif  // ADS_ELEMENT_COLORING_HPP
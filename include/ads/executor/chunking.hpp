@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_EXECUTOR_CHUNKING_HPP
+#define ADS_EXECUTOR_CHUNKING_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ads {
+
+// Default number of chunks per thread of the executor, leaves some room for load balancing
+constexpr int default_chunks_per_thread = 4;
+
+/**
+ * @brief Number of chunks to split a loop over @p size items into, when run by @p executor.
+ *
+ * Gives a few chunks per thread of the executor (see @c thread_count of the executors), but no
+ * more chunks than there are items.
+ */
+template <typename Executor>
+int chunk_count(const Executor& executor, std::ptrdiff_t size,
+                int chunks_per_thread = default_chunks_per_thread) {
+    auto const threads = std::max(executor.thread_count(), 1);
+    auto const max_chunks = std::ptrdiff_t{chunks_per_thread} * threads;
+    return static_cast<int>(std::min(max_chunks, size));
+}
+
+}  // namespace ads
+
+#endif  // ADS_EXECUTOR_CHUNKING_HPP
@@ -46,6 +46,8 @@ class galois_executor {
     explicit galois_executor(int threads);
 
     void thread_count(int threads);
+
+    int thread_count() const;
 };
 
 }  // namespace ads
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_EXECUTOR_PER_THREAD_HPP
+#define ADS_EXECUTOR_PER_THREAD_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/range/counting_range.hpp>
+
+namespace ads {
+
+/**
+ * @brief Lazily created objects of type T, one for each thread accessing it.
+ *
+ * Allows tasks run by an executor to accumulate partial results without synchronization. Object of
+ * a thread is created by the factory on its first access from that thread (and so its memory is
+ * first touched by that thread). After the parallel section, partial results are combined using
+ * reduce.
+ *
+ * Each thread remembers the object it used most recently, so that repeated calls of local from
+ * the same thread do not lock. The factory can be called concurrently from several threads.
+ */
+template <typename T>
+class per_thread {
+public:
+    using factory_type = std::function<T()>;
+
+private:
+    struct cache {
+        std::uint64_t owner = 0;
+        T* item = nullptr;
+    };
+
+    factory_type factory_;
+    std::uint64_t id_;
+    std::mutex mutex_;
+    std::vector<std::pair<std::thread::id, std::unique_ptr<T>>> items_;
+
+public:
+    explicit per_thread(factory_type factory = [] { return T{}; })
+    : factory_{std::move(factory)}
+    , id_{next_id_()} { }
+
+    per_thread(const per_thread&) = delete;
+    per_thread& operator=(const per_thread&) = delete;
+
+    // Object of the calling thread
+    T& local() {
+        auto& c = cache_();
+        if (c.owner != id_) {
+            c = cache{id_, &lookup_(std::this_thread::get_id())};
+        }
+        return *c.item;
+    }
+
+    // Number of threads that accessed the object
+    std::size_t size() const { return items_.size(); }
+
+    /**
+     * @brief Combines objects of all the threads into @p result.
+     *
+     * Objects are combined pairwise in a tree, with the pairs at each level combined in parallel
+     * using @p executor, and the final one is combined into @p result. Objects are left in
+     * unspecified state.
+     *
+     * @param combine called as combine(a, b), adds object b to a
+     */
+    template <typename Result, typename Executor, typename Combine>
+    void reduce(Result& result, const Executor& executor, Combine&& combine) {
+        auto const n = static_cast<int>(items_.size());
+        if (n == 0) {
+            return;
+        }
+        for (int step = 1; step < n; step *= 2) {
+            auto const pairs = (n - step + 2 * step - 1) / (2 * step);
+            executor.for_each(boost::counting_range(0, pairs), [&](int i) {
+                auto const a = static_cast<std::size_t>(2 * step * i);
+                auto const b = a + static_cast<std::size_t>(step);
+                combine(*items_[a].second, *items_[b].second);
+            });
+        }
+        combine(result, *items_.front().second);
+    }
+
+private:
+    T& lookup_(std::thread::id thread) {
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            for (auto& [owner, item] : items_) {
+                if (owner == thread) {
+                    return *item;
+                }
+            }
+        }
+        // Only the calling thread creates its object, so it can be done without holding the lock
+        auto item = std::make_unique<T>(factory_());
+        auto& ref = *item;
+        auto const lock = std::scoped_lock{mutex_};
+        items_.emplace_back(thread, std::move(item));
+        return ref;
+    }
+
+    static cache& cache_() {
+        thread_local cache c;
+        return c;
+    }
+
+    // Ids are never reused, so that a stale cache entry cannot match a new object
+    static std::uint64_t next_id_() {
+        static std::atomic<std::uint64_t> next{1};
+        return next++;
+    }
+};
+
+}  // namespace ads
+
+#endif  // ADS_EXECUTOR_PER_THREAD_HPP
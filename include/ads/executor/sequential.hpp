@@ -4,6 +4,7 @@
 #ifndef ADS_EXECUTOR_SEQUENTIAL_HPP
 #define ADS_EXECUTOR_SEQUENTIAL_HPP
 
+#include <algorithm>
 #include <iterator>
 #include <utility>
 
@@ -11,6 +12,8 @@ namespace ads {
 
 class sequential_executor {
 public:
+    int thread_count() const { return 1; }
+
     template <typename Fun>
     void synchronized(Fun fun) const {
         fun();
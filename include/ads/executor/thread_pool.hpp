@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_EXECUTOR_THREAD_POOL_HPP
+#define ADS_EXECUTOR_THREAD_POOL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ads/executor/chunking.hpp"
+
+namespace ads {
+
+/**
+ * @brief Executor running tasks on a pool of threads, balancing the load by work stealing.
+ *
+ * Each worker thread has its own queue of tasks. Workers take tasks from the back of their own
+ * queues and, once these are empty, steal tasks from the front of queues of other workers.
+ *
+ * Pool of N threads consists of N - 1 workers and the thread calling for_each or parallel_reduce,
+ * which takes part in the loop. Loops split ranges into chunks (a few per thread), each processed
+ * by a single task. Threads waiting for completion of their loops (or futures, see wait) run queued
+ * tasks in the meantime, so parallel loops can be nested.
+ *
+ * Exceptions thrown by the loop body are rethrown by for_each and parallel_reduce after all the
+ * chunks are done, exceptions of submitted tasks are stored in their futures.
+ */
+class thread_pool_executor {
+private:
+    struct pool;
+
+    std::unique_ptr<pool> pool_;
+    mutable std::mutex mutex_;
+
+public:
+    /**
+     * @brief Creates a pool with given number of threads.
+     *
+     * @param threads number of threads, or 0 to use one per hardware thread
+     */
+    explicit thread_pool_executor(int threads = 0);
+
+    thread_pool_executor(const thread_pool_executor&) = delete;
+    thread_pool_executor& operator=(const thread_pool_executor&) = delete;
+
+    ~thread_pool_executor();
+
+    int thread_count() const;
+
+    template <typename Fun>
+    void synchronized(Fun fun) const {
+        auto const lock = std::scoped_lock{mutex_};
+        fun();
+    }
+
+    template <typename Range, typename Fun>
+    void for_each(Range range, Fun&& fun) const {
+        with_random_access(range, [&](auto first, std::ptrdiff_t size) {
+            auto const chunks = chunk_count(size);
+            run_chunks(chunks, [&](int chunk) {
+                auto const end = chunk_end(chunk, chunks, size);
+                for (auto i = chunk_end(chunk - 1, chunks, size); i < end; ++i) {
+                    fun(first[i]);
+                }
+            });
+        });
+    }
+
+    /**
+     * @brief Computes combine(... combine(combine(identity, fun(a1)), fun(a2)) ..., fun(an)) for
+     * items a1, ..., an of the range.
+     *
+     * Chunks of the range are reduced in parallel, so @p combine needs to be associative and
+     * @p identity its neutral element. Partial results are combined in order of the chunks.
+     */
+    template <typename Range, typename T, typename Fun, typename Combine>
+    T parallel_reduce(Range range, T identity, Fun&& fun, Combine&& combine) const {
+        auto partial = std::vector<T>{};
+        with_random_access(range, [&](auto first, std::ptrdiff_t size) {
+            auto const chunks = chunk_count(size);
+            partial.assign(static_cast<std::size_t>(chunks), identity);
+            run_chunks(chunks, [&](int chunk) {
+                auto acc = identity;
+                auto const end = chunk_end(chunk, chunks, size);
+                for (auto i = chunk_end(chunk - 1, chunks, size); i < end; ++i) {
+                    acc = combine(std::move(acc), fun(first[i]));
+                }
+                partial[static_cast<std::size_t>(chunk)] = std::move(acc);
+            });
+        });
+        auto result = std::move(identity);
+        for (auto& value : partial) {
+            result = combine(std::move(result), std::move(value));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Schedules @p fun to be run by the pool.
+     *
+     * With a single thread there are no workers, and @p fun is run immediately.
+     *
+     * @return future holding the result of @p fun
+     */
+    template <typename Fun>
+    auto submit(Fun fun) const -> std::future<std::invoke_result_t<Fun>> {
+        using result_type = std::invoke_result_t<Fun>;
+        auto task = std::make_shared<std::packaged_task<result_type()>>(std::move(fun));
+        auto future = task->get_future();
+        push([task] { (*task)(); });
+        return future;
+    }
+
+    /**
+     * @brief Waits until @p future is ready, running queued tasks in the meantime.
+     *
+     * Unlike future.wait(), can be safely called from tasks run by the pool.
+     */
+    template <typename T>
+    void wait(const std::future<T>& future) const {
+        while (future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            run_pending_or_yield();
+        }
+    }
+
+private:
+    // Schedules the task, or runs it immediately if there are no workers
+    void push(std::function<void()> task) const;
+
+    // Runs body(chunk) for chunk in [0, chunks) in parallel, returns once all of them are done
+    void run_chunks(int chunks, const std::function<void(int)>& body) const;
+
+    // Runs one of the queued tasks if there are any, otherwise yields
+    void run_pending_or_yield() const;
+
+    int chunk_count(std::ptrdiff_t size) const { return ads::chunk_count(*this, size); }
+
+    // End of i-th of the chunks of range [0, size), 0 for i = -1
+    static std::ptrdiff_t chunk_end(int i, int chunks, std::ptrdiff_t size) {
+        return (i + 1) * size / chunks;
+    }
+
+    // Calls fun(first, size) with random access iterator to the items of the range, copying them
+    // if the range does not provide one
+    template <typename Range, typename Fun>
+    static void with_random_access(const Range& range, Fun&& fun) {
+        using std::begin;
+        using std::end;
+
+        auto first = begin(range);
+        auto last = end(range);
+        using iterator = decltype(first);
+        using category = typename std::iterator_traits<iterator>::iterator_category;
+
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>) {
+            fun(first, static_cast<std::ptrdiff_t>(std::distance(first, last)));
+        } else {
+            auto items = std::vector<std::decay_t<decltype(*first)>>(first, last);
+            fun(items.begin(), static_cast<std::ptrdiff_t>(items.size()));
+        }
+    }
+};
+
+}  // namespace ads
+
+#endif  // ADS_EXECUTOR_THREAD_POOL_HPP
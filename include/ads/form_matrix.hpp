@@ -7,6 +7,7 @@
 #include "ads/basis_data.hpp"
 #include "ads/lin/band_matrix.hpp"
 #include "ads/lin/dense_matrix.hpp"
+#include "ads/lin/symmetric_band_matrix.hpp"
 #include "ads/util/function_value/function_value_1d.hpp"
 
 namespace ads {
@@ -17,6 +18,10 @@ void stiffness_matrix_1d(lin::band_matrix& M, const basis_data& d);
 
 void advection_matrix_1d(lin::band_matrix& M, const basis_data& d);
 
+void gram_matrix_1d(lin::symmetric_band_matrix& M, const basis_data& d);
+
+void stiffness_matrix_1d(lin::symmetric_band_matrix& M, const basis_data& d);
+
 void gram_matrix_1d(lin::dense_matrix& M, const basis_data& U, const basis_data& V);
 
 void stiffness_matrix_1d(lin::dense_matrix& M, const basis_data& U, const basis_data& V);
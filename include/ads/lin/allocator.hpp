@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_LIN_ALLOCATOR_HPP
+#define ADS_LIN_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ads::lin {
+
+// Alignment sufficient for aligned loads of full AVX-512 registers
+constexpr std::size_t default_alignment = 64;
+
+// Size of a transparent huge page on x86-64
+constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+/**
+ * @brief Asks the system to back a memory region with transparent huge pages.
+ *
+ * Does nothing on systems without support for transparent huge pages.
+ *
+ * @return true if the request has been accepted
+ */
+bool advise_huge_pages(void* data, std::size_t bytes);
+
+/**
+ * @brief Allocator of bulk numeric storage, returning memory aligned to @p Alignment bytes.
+ *
+ * With @p HugePages set, blocks of at least @c huge_page_size bytes are aligned and padded to
+ * huge page boundaries and backed by transparent huge pages (if available), which reduces TLB
+ * misses in loops striding through large tensors. Smaller blocks are allocated normally.
+ *
+ * Elements constructed without arguments are default-initialized, so numeric arrays are not
+ * zeroed (and their pages not touched) on allocation - containers need to initialize them
+ * explicitly.
+ */
+template <typename T, std::size_t Alignment = default_alignment, bool HugePages = false>
+class aligned_allocator {
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                  "Invalid alignment");
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment, HugePages>;
+    };
+
+    aligned_allocator() noexcept = default;
+
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment, HugePages>& /*other*/) noexcept { }
+
+    T* allocate(std::size_t n) {
+        auto const bytes = padded_size_(n * sizeof(T));
+        auto const alignment = alignment_(bytes);
+        auto* const data = ::operator new(bytes, alignment);
+        if (use_huge_pages_(bytes)) {
+            advise_huge_pages(data, bytes);
+        }
+        return static_cast<T*>(data);
+    }
+
+    void deallocate(T* data, std::size_t n) noexcept {
+        auto const bytes = padded_size_(n * sizeof(T));
+        ::operator delete(data, bytes, alignment_(bytes));
+    }
+
+    template <typename U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    friend bool operator==(const aligned_allocator& /*a*/, const aligned_allocator& /*b*/) {
+        return true;
+    }
+
+    friend bool operator!=(const aligned_allocator& /*a*/, const aligned_allocator& /*b*/) {
+        return false;
+    }
+
+private:
+    static constexpr bool use_huge_pages_(std::size_t bytes) {
+        return HugePages && bytes >= huge_page_size;
+    }
+
+    static constexpr std::size_t padded_size_(std::size_t bytes) {
+        if (use_huge_pages_(bytes)) {
+            return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+        }
+        return bytes;
+    }
+
+    static constexpr std::align_val_t alignment_(std::size_t bytes) {
+        return std::align_val_t{use_huge_pages_(bytes) ? huge_page_size : Alignment};
+    }
+};
+
+// Allocator used by default by tensors and matrices
+template <typename T>
+using default_allocator = aligned_allocator<T>;
+
+// Allocator backing large blocks with transparent huge pages
+template <typename T>
+using huge_page_allocator = aligned_allocator<T, default_alignment, true>;
+
+}  // namespace ads::lin
+
+#endif  // ADS_LIN_ALLOCATOR_HPP
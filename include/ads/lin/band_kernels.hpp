@@ -0,0 +1,398 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_LIN_BAND_KERNELS_HPP
+#define ADS_LIN_BAND_KERNELS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/solver_ctx.hpp"
+#include "ads/lin/symmetric_band_matrix.hpp"
+
+// Banded LU factorization and forward/back substitution kernels operating on matrices in the
+// LAPACK band storage format used by dgbtrf/dgbtrs. Factors produced by these kernels and by LAPACK
+// are interchangeable.
+//
+// Storage of the factorized matrix with kl subdiagonals and ku superdiagonals: column j holds U
+// with kl + ku superdiagonals (accounting for fill-in due to row interchanges) in rows
+// [0, kl + ku], with the diagonal in row kl + ku, followed by kl multipliers of L.
+
+namespace ads::lin::detail {
+
+// Band widths known only at runtime
+struct dynamic_band {
+    int kl;
+    int ku;
+};
+
+// Band widths known at compile time, kl = ku = P - all the loops over the band are then fully
+// unrolled. B-spline basis of degree p yields 1D matrices of this form with P = p.
+template <int P>
+struct static_band {
+    static constexpr int kl = P;
+    static constexpr int ku = P;
+};
+
+// Largest band width with specialized kernels
+constexpr int max_static_band = 5;
+
+template <int P, typename Fun>
+auto dispatch_band_impl(int width, Fun&& fun) {
+    if constexpr (P > max_static_band) {
+        return fun(dynamic_band{width, width});
+    } else {
+        if (width == P) {
+            return fun(static_band<P>{});
+        }
+        return dispatch_band_impl<P + 1>(width, std::forward<Fun>(fun));
+    }
+}
+
+// Calls fun with the most specific band descriptor matching the square matrix a
+template <typename Fun>
+auto dispatch_band(const band_matrix& a, Fun&& fun) {
+    if (a.kl == a.ku && a.rows == a.cols) {
+        return dispatch_band_impl<1>(a.kl, std::forward<Fun>(fun));
+    }
+    return fun(dynamic_band{a.kl, a.ku});
+}
+
+template <typename Fun>
+auto dispatch_band(const symmetric_band_matrix& a, Fun&& fun) {
+    return dispatch_band_impl<1>(a.kd, std::forward<Fun>(fun));
+}
+
+template <typename Band>
+constexpr bool is_static_band = false;
+
+template <int P>
+constexpr bool is_static_band<static_band<P>> = true;
+
+// Unblocked LU factorization with partial pivoting of a square band matrix, following LAPACK
+// dgbtf2 (which is what dgbtrf uses for narrow bands). Returns LAPACK-compatible status code.
+template <typename Band>
+auto band_lu(band_matrix& a, int* ipiv, std::ptrdiff_t ld, Band band) -> int {
+    int const n = a.cols;
+    int const kl = band.kl;
+    int const ku = band.ku;
+    int const kv = kl + ku;
+    double* const ab = a.full_buffer();
+
+    auto const at = [=](int i, int j) -> double& { return ab[kv + i - j + j * ld]; };
+
+    // Fill-in rows may hold leftovers of a previous factorization
+    for (int j = 0; j < n; ++j) {
+        std::fill_n(ab + j * ld, kl, 0.0);
+    }
+
+    int info = 0;
+    int ju = 0;
+
+    for (int j = 0; j < n; ++j) {
+        int const km = std::min(kl, n - 1 - j);
+
+        int jp = 0;
+        double max = std::abs(at(j, j));
+        for (int k = 1; k <= km; ++k) {
+            if (std::abs(at(j + k, j)) > max) {
+                max = std::abs(at(j + k, j));
+                jp = k;
+            }
+        }
+        ipiv[j] = j + jp + 1;
+
+        if (at(j + jp, j) != 0) {
+            ju = std::max(ju, std::min(j + jp + ku, n - 1));
+
+            if (jp != 0) {
+                for (int c = j; c <= ju; ++c) {
+                    std::swap(at(j + jp, c), at(j, c));
+                }
+            }
+            if (km > 0) {
+                double const r = 1 / at(j, j);
+                for (int k = 1; k <= km; ++k) {
+                    at(j + k, j) *= r;
+                }
+                for (int c = j + 1; c <= ju; ++c) {
+                    double const u = at(j, c);
+                    for (int k = 1; k <= km; ++k) {
+                        at(j + k, c) -= at(j + k, j) * u;
+                    }
+                }
+            }
+        } else if (info == 0) {
+            info = j + 1;
+        }
+    }
+    return info;
+}
+
+// Cholesky factorization A = U^T U of a symmetric positive definite band matrix stored in upper
+// triangular form, following LAPACK dpbtf2. Returns LAPACK-compatible status code.
+template <typename Band>
+auto band_cholesky(symmetric_band_matrix& a, Band band) -> int {
+    int const n = a.n;
+    int const kd = band.ku;
+    auto const ld = static_cast<std::ptrdiff_t>(a.column_size());
+    double* const ab = a.full_buffer();
+
+    auto const at = [=](int i, int j) -> double& { return ab[kd + i - j + j * ld]; };
+
+    for (int j = 0; j < n; ++j) {
+        double const ajj = at(j, j);
+        if (ajj <= 0 || std::isnan(ajj)) {
+            return j + 1;
+        }
+        double const ujj = std::sqrt(ajj);
+        at(j, j) = ujj;
+
+        int const kn = std::min(kd, n - 1 - j);
+        double const r = 1 / ujj;
+        for (int k = 1; k <= kn; ++k) {
+            at(j, j + k) *= r;
+        }
+        for (int c = 1; c <= kn; ++c) {
+            double const u = at(j, j + c);
+            for (int k = 1; k <= c; ++k) {
+                at(j + k, j + c) -= at(j, j + k) * u;
+            }
+        }
+    }
+    return 0;
+}
+
+// Factors of a band matrix in LAPACK band storage (see above), with leading dimension ld. Factors
+// may be stored in a different precision than the one used to compute them. Pivots are only used
+// by the LU factorization.
+template <typename T>
+struct band_factors {
+    const T* ab;
+    std::ptrdiff_t ld;
+    int n;
+    const int* ipiv = nullptr;
+};
+
+inline auto factors_of(const band_matrix& a, const solver_ctx& ctx) -> band_factors<double> {
+    return {a.full_buffer(), ctx.lda, a.cols, ctx.pivot()};
+}
+
+inline auto factors_of(const symmetric_band_matrix& a) -> band_factors<double> {
+    return {a.full_buffer(), a.column_size(), a.n};
+}
+
+// Applies inverse of the LU factorization to `count` right-hand sides stored so that i-th
+// component of r-th right-hand side is b[r + i * stride]. Each operation of the band forward/back
+// substitution is thus performed on `count` consecutive values at once, which vectorizes well.
+template <typename T, typename Band>
+void substitute_strided(const band_factors<T>& f, T* b, int count, std::ptrdiff_t stride,
+                        Band band) {
+    int const n = f.n;
+    int const kl = band.kl;
+    int const kd = band.kl + band.ku;
+    auto const ld = f.ld;
+    const T* ab = f.ab;
+    const int* ipiv = f.ipiv;
+
+    auto const line = [=](int i) { return b + i * stride; };
+
+    // Forward substitution with row interchanges: L^-1 P b
+    if (kl > 0) {
+        for (int j = 0; j < n - 1; ++j) {
+            T* const xj = line(j);
+            int const p = ipiv[j] - 1;
+            if (p != j) {
+                std::swap_ranges(xj, xj + count, line(p));
+            }
+            int const lm = std::min(kl, n - 1 - j);
+            const T* const multipliers = ab + kd + 1 + j * ld;
+            for (int k = 0; k < lm; ++k) {
+                T const m = multipliers[k];
+                T* const y = line(j + 1 + k);
+                for (int r = 0; r < count; ++r) {
+                    y[r] -= m * xj[r];
+                }
+            }
+        }
+    }
+
+    // Back substitution: U^-1 b
+    for (int j = n - 1; j >= 0; --j) {
+        T* const xj = line(j);
+        const T* const column = ab + j * ld;
+        T const diag = column[kd];
+        for (int r = 0; r < count; ++r) {
+            xj[r] /= diag;
+        }
+        for (int i = std::max(0, j - kd); i < j; ++i) {
+            T const u = column[kd + i - j];
+            T* const y = line(i);
+            for (int r = 0; r < count; ++r) {
+                y[r] -= u * xj[r];
+            }
+        }
+    }
+}
+
+template <typename Band>
+void substitute_strided(const band_matrix& a, double* b, const solver_ctx& ctx, int count,
+                        std::ptrdiff_t stride, Band band) {
+    substitute_strided(factors_of(a, ctx), b, count, stride, band);
+}
+
+// Same as above, for the Cholesky factorization A = U^T U computed by dpbtrf (uplo = 'U'). Column j
+// of the factor holds U(i, j) for i in [j - kd, j] in rows [0, kd], with the diagonal in row kd.
+template <typename T, typename Band>
+void cholesky_substitute_strided(const band_factors<T>& f, T* b, int count, std::ptrdiff_t stride,
+                                 Band band) {
+    int const n = f.n;
+    int const kd = band.ku;
+    auto const ld = f.ld;
+    const T* ab = f.ab;
+
+    auto const line = [=](int i) { return b + i * stride; };
+
+    // Forward substitution: U^-T b
+    for (int j = 0; j < n; ++j) {
+        T* const xj = line(j);
+        const T* const column = ab + j * ld;
+        for (int i = std::max(0, j - kd); i < j; ++i) {
+            T const u = column[kd + i - j];
+            const T* const y = line(i);
+            for (int r = 0; r < count; ++r) {
+                xj[r] -= u * y[r];
+            }
+        }
+        T const diag = column[kd];
+        for (int r = 0; r < count; ++r) {
+            xj[r] /= diag;
+        }
+    }
+
+    // Back substitution: U^-1 b
+    for (int j = n - 1; j >= 0; --j) {
+        T* const xj = line(j);
+        const T* const column = ab + j * ld;
+        T const diag = column[kd];
+        for (int r = 0; r < count; ++r) {
+            xj[r] /= diag;
+        }
+        for (int i = std::max(0, j - kd); i < j; ++i) {
+            T const u = column[kd + i - j];
+            T* const y = line(i);
+            for (int r = 0; r < count; ++r) {
+                y[r] -= u * xj[r];
+            }
+        }
+    }
+}
+
+template <typename Band>
+void cholesky_substitute_strided(const symmetric_band_matrix& a, double* b, int count,
+                                 std::ptrdiff_t stride, Band band) {
+    cholesky_substitute_strided(factors_of(a), b, count, stride, band);
+}
+
+// Multiplies interleaved vectors (layout as above) by the original matrix A = P L U, given its LU
+// factors. Operations of the forward/back substitution are undone in reverse order, so that each
+// vector is overwritten in place.
+template <typename T, typename Band>
+void multiply_factorized_strided(const band_factors<T>& f, T* b, int count, std::ptrdiff_t stride,
+                                 Band band) {
+    int const n = f.n;
+    int const kl = band.kl;
+    int const kd = band.kl + band.ku;
+    auto const ld = f.ld;
+    const T* ab = f.ab;
+    const int* ipiv = f.ipiv;
+
+    auto const line = [=](int i) { return b + i * stride; };
+
+    // U b - component j depends only on components [j, j + kd], which are not overwritten yet
+    for (int j = 0; j < n; ++j) {
+        T* const xj = line(j);
+        T const diag = ab[kd + j * ld];
+        for (int r = 0; r < count; ++r) {
+            xj[r] *= diag;
+        }
+        for (int i = j + 1; i <= std::min(n - 1, j + kd); ++i) {
+            T const u = ab[kd + j - i + i * ld];
+            const T* const y = line(i);
+            for (int r = 0; r < count; ++r) {
+                xj[r] += u * y[r];
+            }
+        }
+    }
+
+    // P L b
+    if (kl > 0) {
+        for (int j = n - 2; j >= 0; --j) {
+            T* const xj = line(j);
+            int const lm = std::min(kl, n - 1 - j);
+            const T* const multipliers = ab + kd + 1 + j * ld;
+            for (int k = 0; k < lm; ++k) {
+                T const m = multipliers[k];
+                T* const y = line(j + 1 + k);
+                for (int r = 0; r < count; ++r) {
+                    y[r] += m * xj[r];
+                }
+            }
+            int const p = ipiv[j] - 1;
+            if (p != j) {
+                std::swap_ranges(xj, xj + count, line(p));
+            }
+        }
+    }
+}
+
+// Same as above, for A = U^T U
+template <typename T, typename Band>
+void cholesky_multiply_strided(const band_factors<T>& f, T* b, int count, std::ptrdiff_t stride,
+                               Band band) {
+    int const n = f.n;
+    int const kd = band.ku;
+    auto const ld = f.ld;
+    const T* ab = f.ab;
+
+    auto const line = [=](int i) { return b + i * stride; };
+
+    // U b
+    for (int j = 0; j < n; ++j) {
+        T* const xj = line(j);
+        T const diag = ab[kd + j * ld];
+        for (int r = 0; r < count; ++r) {
+            xj[r] *= diag;
+        }
+        for (int i = j + 1; i <= std::min(n - 1, j + kd); ++i) {
+            T const u = ab[kd + j - i + i * ld];
+            const T* const y = line(i);
+            for (int r = 0; r < count; ++r) {
+                xj[r] += u * y[r];
+            }
+        }
+    }
+
+    // U^T b - component j depends only on components [j - kd, j]
+    for (int j = n - 1; j >= 0; --j) {
+        T* const xj = line(j);
+        const T* const column = ab + j * ld;
+        for (int r = 0; r < count; ++r) {
+            xj[r] *= column[kd];
+        }
+        for (int i = std::max(0, j - kd); i < j; ++i) {
+            T const u = column[kd + i - j];
+            const T* const y = line(i);
+            for (int r = 0; r < count; ++r) {
+                xj[r] += u * y[r];
+            }
+        }
+    }
+}
+
+}  // namespace ads::lin::detail
+
+#endif  // ADS_LIN_BAND_KERNELS_HPP
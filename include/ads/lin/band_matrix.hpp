@@ -4,12 +4,14 @@
 #ifndef ADS_LIN_BAND_MATRIX_HPP
 #define ADS_LIN_BAND_MATRIX_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <iomanip>
 #include <iostream>
 #include <vector>
 
+#include "ads/lin/allocator.hpp"
 #include "ads/lin/dense_matrix.hpp"
 #include "ads/lin/lapack.hpp"
 
@@ -17,7 +19,7 @@ namespace ads::lin {
 
 class band_matrix {
 private:
-    std::vector<double> data_;
+    std::vector<double, default_allocator<double>> data_;
 
 public:
     int kl = 0;
@@ -37,7 +39,9 @@ class band_matrix {
     , ku(ku)
     , rows(rows)
     , cols(cols)
-    , row_offset(row_offset) { }
+    , row_offset(row_offset) {
+        zero();
+    }
 
     double& operator()(int i, int j) {
         assert(inside_band(i, j));
@@ -88,6 +92,20 @@ inline std::ostream& operator<<(std::ostream& os, const band_matrix& M) {
     return os;
 }
 
+// Equal if both the layout and all the stored entries (including the space for LU factors) match
+inline bool operator==(const band_matrix& a, const band_matrix& b) {
+    if (a.kl != b.kl || a.ku != b.ku || a.rows != b.rows || a.cols != b.cols
+        || a.row_offset != b.row_offset) {
+        return false;
+    }
+    auto const size = a.column_size() * a.cols;
+    return std::equal(a.full_buffer(), a.full_buffer() + size, b.full_buffer());
+}
+
+inline bool operator!=(const band_matrix& a, const band_matrix& b) {
+    return !(a == b);
+}
+
 template <typename Vec1, typename Vec2>
 inline void multiply(const band_matrix& M, const Vec1& x, Vec2& y, int count = 1,
                      const char* transpose = "N") {
@@ -98,8 +116,8 @@ inline void multiply(const band_matrix& M, const Vec1& x, Vec2& y, int count = 1
     int lda = M.column_size();
 
     for (int i = 0; i < count; ++i) {
-        auto in = x.data() + M.cols * i;
-        auto out = y.data() + M.rows * i;
+        auto in = x.data() + static_cast<std::ptrdiff_t>(M.cols) * i;
+        auto out = y.data() + static_cast<std::ptrdiff_t>(M.rows) * i;
         dgbmv_(transpose, &M.rows, &M.cols, &M.kl, &M.ku, &alpha, M.data(), &lda, in, &incx, &beta,
                out, &incy);
     }
@@ -0,0 +1,318 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_LIN_BAND_ROW_UPDATE_HPP
+#define ADS_LIN_BAND_ROW_UPDATE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/band_solve.hpp"
+#include "ads/lin/dense_matrix.hpp"
+#include "ads/lin/lapack.hpp"
+#include "ads/lin/solver_ctx.hpp"
+#include "ads/util.hpp"
+
+namespace ads::lin {
+
+/**
+ * @brief Factorized band matrix with some of its rows replaced, solved without refactorization.
+ *
+ * Replacing rows k_1, ..., k_r of A (e.g. to impose Dirichlet boundary conditions) gives
+ * B = A + U V^T, where columns of U are unit vectors e_k and rows of V^T are the differences
+ * between the new and the original rows. By the Sherman-Morrison-Woodbury formula
+ *
+ *   B^-1 b = y - Z C^-1 V^T y,  where  y = A^-1 b,  Z = A^-1 U,  C = I + V^T Z
+ *
+ * so the system with B is solved with the factorization of A, followed by a correction of rank r.
+ * Changing the replaced rows costs one solve with A per row, and the factorization of A can be
+ * shared by any number of updates.
+ *
+ * New rows must have the same sparsity pattern as A, i.e. fit within its band. The original and
+ * factorized matrices are referenced and need to outlive the update.
+ *
+ * Solves allocate no memory - right-hand sides are corrected in blocks, using a fixed-size buffer
+ * for V^T y, so that the update can be shared by concurrent solves. This limits the number of
+ * replaced rows to max_rank.
+ */
+class band_row_update {
+public:
+    // Size of the buffer for V^T y of a block of right-hand sides
+    static constexpr int scratch_size = 256;
+
+    static constexpr int max_rank = scratch_size;
+
+private:
+    const band_matrix* original_;
+    const band_matrix* factors_;
+    const solver_ctx* ctx_;
+
+    int n_;
+    int width_;
+
+    std::vector<int> rows_;
+    std::vector<int> first_;       // first column of the band of each replaced row
+    std::vector<double> delta_;    // new minus original row, width_ entries per row
+    std::vector<double> z_;        // A^-1 e_k for each replaced row k, n_ entries per row
+    std::vector<double> capacitance_;
+    std::vector<int> pivots_;
+
+public:
+    /**
+     * @param original matrix A, not factorized
+     * @param factors LU factorization of A
+     * @param ctx solver context of the factorization
+     */
+    band_row_update(const band_matrix& original, const band_matrix& factors, const solver_ctx& ctx)
+    : original_{&original}
+    , factors_{&factors}
+    , ctx_{&ctx}
+    , n_{original.rows}
+    , width_{original.kl + original.ku + 1} { }
+
+    // Number of replaced rows
+    int rank() const { return static_cast<int>(rows_.size()); }
+
+    int size() const { return n_; }
+
+    // Factorization of the original matrix
+    const band_matrix& factors() const { return *factors_; }
+
+    const std::vector<int>& rows() const { return rows_; }
+
+    // Matrix with the rows replaced, in the same layout as the original one (e.g. to be factorized
+    // directly)
+    band_matrix matrix() const {
+        auto B = *original_;
+        for (int i = 0; i < rank(); ++i) {
+            int const k = rows_[i];
+            int const first = first_[i];
+            int const last = std::min(k + B.ku, n_ - 1);
+            for (int j = first; j <= last; ++j) {
+                B(k, j) += delta_[i * width_ + j - first];
+            }
+        }
+        return B;
+    }
+
+    /**
+     * @brief Replaces row k of the matrix.
+     *
+     * @param k index of the row
+     * @param row new row, with entries for all the columns (only those within the band may be
+     *        non-zero)
+     */
+    void replace_row(int k, const std::vector<double>& row) {
+        assert(static_cast<int>(row.size()) == n_ && "Invalid row size");
+        auto const& A = *original_;
+        int const first = std::max(k - A.kl, 0);
+        int const last = std::min(k + A.ku, n_ - 1);
+
+        auto delta = std::vector<double>(width_);
+        for (int j = first; j <= last; ++j) {
+            delta[j - first] = row[j] - A(k, j);
+        }
+
+        auto const it = std::find(begin(rows_), end(rows_), k);
+        auto const i = it - begin(rows_);
+        if (it == end(rows_)) {
+            if (rank() == max_rank) {
+                throw std::length_error{"Too many rows replaced by low-rank update"};
+            }
+            rows_.push_back(k);
+            first_.push_back(first);
+            delta_.insert(end(delta_), begin(delta), end(delta));
+
+            auto z = std::vector<double>(n_);
+            z[k] = 1;
+            solve_with_factorized(*factors_, z.data(), *ctx_, 1);
+            z_.insert(end(z_), begin(z), end(z));
+        } else {
+            std::copy(begin(delta), end(delta), begin(delta_) + i * width_);
+        }
+        update_capacitance();
+    }
+
+    // Replaces row k by the k-th row of identity (Dirichlet boundary condition)
+    void fix_dof(int k) {
+        auto row = std::vector<double>(n_);
+        row[k] = 1;
+        replace_row(k, row);
+    }
+
+    // Restores the original matrix
+    void reset() {
+        rows_.clear();
+        first_.clear();
+        delta_.clear();
+        z_.clear();
+        capacitance_.clear();
+        pivots_.clear();
+    }
+
+    /**
+     * @brief Applies the low-rank correction to solutions of the system with the original matrix.
+     *
+     * Turns y = A^-1 b into B^-1 b for @p count vectors. The i-th component of the j-th vector is
+     * @c y[j * line_stride + i * stride].
+     */
+    void correct(double* y, int count, std::ptrdiff_t line_stride, std::ptrdiff_t stride) const {
+        int const r = rank();
+        if (r == 0) {
+            return;
+        }
+        auto t = std::array<double, scratch_size>{};
+        int const block = scratch_size / r;
+
+        for (int begin = 0; begin < count; begin += block) {
+            int const size = std::min(block, count - begin);
+            double* const lines = y + begin * line_stride;
+            multiply_delta(lines, size, line_stride, stride, t.data());
+
+            // s = C^-1 t
+            int info = 0;
+            dgetrs_("N", &r, &size, capacitance_.data(), &r, pivots_.data(), t.data(), &r, &info);
+            check_info(info, "dgetrs");
+
+            subtract_z(lines, size, line_stride, stride, t.data());
+        }
+    }
+
+private:
+    static void check_info(int info, const char* routine) {
+        if (info != 0) {
+            throw std::runtime_error{std::string{routine} + " failed for the capacitance matrix"
+                                     + " of low-rank update, info = " + std::to_string(info)};
+        }
+    }
+
+    // t = V^T y, r x count. The innermost loop runs over the dimension with unit stride.
+    void multiply_delta(const double* y, int count, std::ptrdiff_t line_stride,
+                        std::ptrdiff_t stride, double* t) const {
+        int const r = rank();
+        if (stride == 1) {
+            for (int j = 0; j < count; ++j) {
+                double const* line = y + j * line_stride;
+                for (int i = 0; i < r; ++i) {
+                    double const* delta = delta_.data() + i * width_;
+                    int const first = first_[i];
+                    int const last = std::min(first + width_, n_);
+                    double sum = 0;
+                    for (int m = first; m < last; ++m) {
+                        sum += delta[m - first] * line[m];
+                    }
+                    t[i + r * j] = sum;
+                }
+            }
+        } else {
+            std::fill_n(t, r * count, 0.0);
+            for (int i = 0; i < r; ++i) {
+                double const* delta = delta_.data() + i * width_;
+                int const first = first_[i];
+                int const last = std::min(first + width_, n_);
+                for (int m = first; m < last; ++m) {
+                    double const d = delta[m - first];
+                    double const* row = y + m * stride;
+                    for (int j = 0; j < count; ++j) {
+                        t[i + r * j] += d * row[j * line_stride];
+                    }
+                }
+            }
+        }
+    }
+
+    // y -= Z s, where s is r x count. The innermost loop runs over the dimension with unit stride.
+    void subtract_z(double* y, int count, std::ptrdiff_t line_stride, std::ptrdiff_t stride,
+                    const double* s) const {
+        int const r = rank();
+        if (stride == 1) {
+            for (int j = 0; j < count; ++j) {
+                double* const line = y + j * line_stride;
+                for (int i = 0; i < r; ++i) {
+                    double const* z = z_.data() + static_cast<std::ptrdiff_t>(i) * n_;
+                    double const a = s[i + r * j];
+                    for (int m = 0; m < n_; ++m) {
+                        line[m] -= z[m] * a;
+                    }
+                }
+            }
+        } else {
+            for (int m = 0; m < n_; ++m) {
+                double* const row = y + m * stride;
+                for (int i = 0; i < r; ++i) {
+                    double const z = z_[static_cast<std::size_t>(i) * n_ + m];
+                    for (int j = 0; j < count; ++j) {
+                        row[j * line_stride] -= z * s[i + r * j];
+                    }
+                }
+            }
+        }
+    }
+
+    void update_capacitance() {
+        int const r = rank();
+        capacitance_.assign(static_cast<std::size_t>(r) * r, 0.0);
+        pivots_.resize(r);
+
+        for (int j = 0; j < r; ++j) {
+            double const* z = z_.data() + static_cast<std::ptrdiff_t>(j) * n_;
+            for (int i = 0; i < r; ++i) {
+                double const* delta = delta_.data() + i * width_;
+                int const first = first_[i];
+                int const last = std::min(first + width_, n_);
+                double sum = i == j ? 1 : 0;
+                for (int m = first; m < last; ++m) {
+                    sum += delta[m - first] * z[m];
+                }
+                capacitance_[i + r * j] = sum;
+            }
+        }
+        int info = 0;
+        dgetrf_(&r, &r, capacitance_.data(), &r, pivots_.data(), &info);
+        check_info(info, "dgetrf");
+    }
+};
+
+// Solvers with the same interface as for band_matrix. The context is the one of the factorization
+// of the original matrix.
+
+inline int solve_with_factorized(const band_row_update& a, double* b, const solver_ctx& ctx,
+                                 int nrhs) {
+    int const info = solve_with_factorized(a.factors(), b, ctx, nrhs);
+    a.correct(b, nrhs, a.size(), 1);
+    return info;
+}
+
+template <typename Rhs>
+inline void solve_with_factorized(const band_row_update& a, Rhs& b, const solver_ctx& ctx) {
+    if constexpr (is_strided_view<std::remove_const_t<Rhs>>) {
+        detail::solve_view(a, b, ctx);
+    } else {
+        int nrhs = narrow_cast<int>(b.size() / b.size(0));
+        solve_with_factorized(a, b.data(), ctx, nrhs);
+    }
+}
+
+template <typename T, std::size_t Rank>
+inline void solve_with_factorized(const band_row_update& a, const strided_view<T, Rank>& b,
+                                  const solver_ctx& ctx) {
+    detail::solve_view(a, b, ctx);
+}
+
+inline void solve_with_factorized_strided(const band_row_update& a, double* b,
+                                          const solver_ctx& ctx, int count,
+                                          std::ptrdiff_t stride) {
+    solve_with_factorized_strided(a.factors(), b, ctx, count, stride);
+    a.correct(b, count, 1, stride);
+}
+
+}  // namespace ads::lin
+
+#endif  // ADS_LIN_BAND_ROW_UPDATE_HPP
@@ -4,30 +4,185 @@
 #ifndef ADS_LIN_BAND_SOLVE_HPP
 #define ADS_LIN_BAND_SOLVE_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "ads/lin/band_kernels.hpp"
 #include "ads/lin/band_matrix.hpp"
 #include "ads/lin/lapack.hpp"
 #include "ads/lin/solver_ctx.hpp"
+#include "ads/lin/symmetric_band_matrix.hpp"
 #include "ads/lin/tensor.hpp"
+#include "ads/util.hpp"
 
 namespace ads::lin {
 
+namespace detail {
+
+// Number of values in the part of interleaved right-hand sides processed at once by
+// the substitution kernel - a block of this size should comfortably fit in L2 cache
+constexpr int strided_solve_block_size = 16384;
+
+// Granularity of the number of right-hand sides in a block, so that the inner loops vectorize well
+constexpr int strided_solve_width_step = 8;
+
+inline auto strided_solve_block_width(int n) -> int {
+    constexpr int step = strided_solve_width_step;
+    auto const width = std::max(step, strided_solve_block_size / std::max(n, 1));
+    return width / step * step;
+}
+
+// Solves interleaved right-hand sides of a system of size n in blocks, using kernel(b, count,
+// stride) to solve each of them
+template <typename T, typename Kernel>
+void solve_strided_blocks(int n, T* b, int count, std::ptrdiff_t stride, Kernel&& kernel) {
+    auto const block = strided_solve_block_width(n);
+
+    for (int begin = 0; begin < count; begin += block) {
+        auto const size = std::min(block, count - begin);
+        kernel(b + begin, size, stride);
+    }
+}
+
+// Solves right-hand sides stored contiguously one after another by transposing blocks of them into
+// a scratch buffer, where they are interleaved and can be processed by the substitution kernel.
+template <typename T, typename Kernel>
+void solve_packed(int n, T* b, int nrhs, Kernel&& kernel) {
+    if (nrhs == 1) {
+        kernel(b, 1, 1);
+        return;
+    }
+    auto const width = std::min(strided_solve_block_width(n), nrhs);
+    auto buffer = std::vector<T>(static_cast<std::size_t>(n) * width);
+
+    for (int begin = 0; begin < nrhs; begin += width) {
+        auto const count = std::min(width, nrhs - begin);
+        auto* const block = b + static_cast<std::ptrdiff_t>(begin) * n;
+
+        transpose_matrix(block, buffer.data(), n, count);
+        kernel(buffer.data(), count, count);
+        transpose_matrix(buffer.data(), block, count, n);
+    }
+}
+
+/**
+ * Solves lines along the first dimension of a strided view. Lines stored contiguously one after
+ * another, or interleaved (with unit stride along the second dimension), are solved together.
+ */
+template <typename Matrix, typename T, std::size_t Rank>
+void solve_view(const Matrix& a, const strided_view<T, Rank>& b, const solver_ctx& ctx) {
+    auto const n = b.size(0);
+    auto const inc = b.stride(0);
+    int count = 1;
+    std::ptrdiff_t ld = n;
+    if constexpr (Rank > 1) {
+        count = b.size(1);
+        ld = b.stride(1);
+    }
+
+    for_each_block<2>(b.sizes(), b.strides(), [&](std::ptrdiff_t offset) {
+        auto* const first = b.data() + offset;
+        if (inc == 1 && (count == 1 || ld == n)) {
+            solve_with_factorized(a, first, ctx, count);
+        } else if (ld == 1) {
+            solve_with_factorized_strided(a, first, ctx, count, inc);
+        } else {
+            for (int j = 0; j < count; ++j) {
+                solve_with_factorized_strided(a, first + j * ld, ctx, 1, inc);
+            }
+        }
+    });
+}
+
+}  // namespace detail
+
+// Square matrices with kl = ku <= detail::max_static_band, which includes 1D matrices of B-spline
+// bases of low degree, are factorized and solved using kernels specialized for the band width,
+// others using LAPACK. The resulting factors are in the same format in both cases.
+
 inline void factorize(band_matrix& a, solver_ctx& ctx) {
-    dgbtrf_(&a.rows, &a.cols, &a.kl, &a.ku, a.full_buffer(), &ctx.lda, ctx.pivot(), &ctx.info);
+    detail::dispatch_band(a, [&](auto band) {
+        if constexpr (detail::is_static_band<decltype(band)>) {
+            ctx.info = detail::band_lu(a, ctx.pivot(), ctx.lda, band);
+        } else {
+            dgbtrf_(&a.rows, &a.cols, &a.kl, &a.ku, a.full_buffer(), &ctx.lda, ctx.pivot(),
+                    &ctx.info);
+        }
+    });
 }
 
 template <typename Rhs>
 inline void solve_with_factorized(const band_matrix& a, Rhs& b, solver_ctx& ctx) {
-    int nrhs = b.size() / b.size(0);
-    solve_with_factorized(a, b.data(), ctx, nrhs);
+    if constexpr (is_strided_view<std::remove_const_t<Rhs>>) {
+        detail::solve_view(a, b, std::as_const(ctx));
+    } else {
+        int nrhs = narrow_cast<int>(b.size() / b.size(0));
+        solve_with_factorized(a, b.data(), ctx, nrhs);
+    }
+}
+
+// Solves using a context shared with others (e.g. through the factorization cache), which is not
+// modified - the status code is not stored
+template <typename Rhs>
+inline void solve_with_factorized(const band_matrix& a, Rhs& b, const solver_ctx& ctx) {
+    if constexpr (is_strided_view<std::remove_const_t<Rhs>>) {
+        detail::solve_view(a, b, ctx);
+    } else {
+        int nrhs = narrow_cast<int>(b.size() / b.size(0));
+        solve_with_factorized(a, b.data(), ctx, nrhs);
+    }
+}
+
+// Does not modify the context, so that it can be safely shared by multiple threads solving
+// disjoint sets of right-hand sides. Returns LAPACK status code.
+inline int solve_with_factorized(const band_matrix& a, double* b, const solver_ctx& ctx, int nrhs) {
+    return detail::dispatch_band(a, [&](auto band) {
+        if constexpr (detail::is_static_band<decltype(band)>) {
+            detail::solve_packed(a.cols, b, nrhs, [&](double* x, int count, auto stride) {
+                detail::substitute_strided(a, x, ctx, count, stride, band);
+            });
+            return 0;
+        } else {
+            return detail::solve_lapack_batches(a.cols, b, nrhs, [&](double* x, int count) {
+                int info = 0;
+                const char* trans = "No transpose";
+                dgbtrs_(trans, &a.cols, &a.kl, &a.ku, &count, a.full_buffer(), &ctx.lda,
+                        ctx.pivot(), x, &a.cols, &info);
+                return info;
+            });
+        }
+    });
 }
 
 inline void solve_with_factorized(const band_matrix& a, double* b, solver_ctx& ctx, int nrhs) {
-    const char* trans = "No transpose";
+    ctx.info = solve_with_factorized(a, b, std::as_const(ctx), nrhs);
+}
 
-    dgbtrs_(trans, &a.cols, &a.kl, &a.ku, &nrhs, a.full_buffer(), &ctx.lda, ctx.pivot(), b, &a.cols,
-            &ctx.info);
+/**
+ * @brief Solves the factorized system for right-hand sides interleaved in memory.
+ *
+ * The i-th component of the r-th right-hand side is @c b[r + i * stride], for r in [0, count).
+ * This is the layout of lines along a non-leading dimension of a column-major tensor, which can
+ * thus be solved in place, without transposing the tensor first. Like @c solve_with_factorized with
+ * const context, this function can be called concurrently for disjoint right-hand sides.
+ *
+ * @param a matrix factorized with @c factorize
+ * @param b pointer to the first component of the first right-hand side
+ * @param ctx solver context used for the factorization
+ * @param count number of right-hand sides
+ * @param stride distance between consecutive components of each right-hand side
+ */
+inline void solve_with_factorized_strided(const band_matrix& a, double* b, const solver_ctx& ctx,
+                                          int count, std::ptrdiff_t stride) {
+    detail::dispatch_band(a, [&](auto band) {
+        detail::solve_strided_blocks(a.cols, b, count, stride, [&](double* x, int n, auto s) {
+            detail::substitute_strided(a, x, ctx, n, s, band);
+        });
+    });
 }
 
 template <typename Rhs>
@@ -36,6 +191,85 @@ inline void solve(band_matrix& a, Rhs& b, solver_ctx& ctx) {
     solve_with_factorized(a, b, ctx);
 }
 
+// Symmetric positive definite band matrices are factorized using Cholesky decomposition. As with
+// LU, matrices with band width up to detail::max_static_band use specialized kernels, others LAPACK
+// (dpbtrf/dpbtrs).
+
+inline void factorize(symmetric_band_matrix& a, solver_ctx& ctx) {
+    detail::dispatch_band(a, [&](auto band) {
+        if constexpr (detail::is_static_band<decltype(band)>) {
+            ctx.info = detail::band_cholesky(a, band);
+        } else {
+            dpbtrf_("U", &a.n, &a.kd, a.full_buffer(), &ctx.lda, &ctx.info);
+        }
+    });
+}
+
+template <typename Rhs>
+inline void solve_with_factorized(const symmetric_band_matrix& a, Rhs& b, solver_ctx& ctx) {
+    if constexpr (is_strided_view<std::remove_const_t<Rhs>>) {
+        detail::solve_view(a, b, std::as_const(ctx));
+    } else {
+        int nrhs = narrow_cast<int>(b.size() / b.size(0));
+        solve_with_factorized(a, b.data(), ctx, nrhs);
+    }
+}
+
+inline int solve_with_factorized(const symmetric_band_matrix& a, double* b, const solver_ctx& ctx,
+                                 int nrhs) {
+    return detail::dispatch_band(a, [&](auto band) {
+        if constexpr (detail::is_static_band<decltype(band)>) {
+            detail::solve_packed(a.n, b, nrhs, [&](double* x, int count, auto stride) {
+                detail::cholesky_substitute_strided(a, x, count, stride, band);
+            });
+            return 0;
+        } else {
+            return detail::solve_lapack_batches(a.n, b, nrhs, [&](double* x, int count) {
+                int info = 0;
+                dpbtrs_("U", &a.n, &a.kd, &count, a.full_buffer(), &ctx.lda, x, &a.n, &info);
+                return info;
+            });
+        }
+    });
+}
+
+inline void solve_with_factorized(const symmetric_band_matrix& a, double* b, solver_ctx& ctx,
+                                  int nrhs) {
+    ctx.info = solve_with_factorized(a, b, std::as_const(ctx), nrhs);
+}
+
+inline void solve_with_factorized_strided(const symmetric_band_matrix& a, double* b,
+                                          const solver_ctx& /*ctx*/, int count,
+                                          std::ptrdiff_t stride) {
+    detail::dispatch_band(a, [&](auto band) {
+        detail::solve_strided_blocks(a.n, b, count, stride, [&](double* x, int n, auto s) {
+            detail::cholesky_substitute_strided(a, x, n, s, band);
+        });
+    });
+}
+
+template <typename Rhs>
+inline void solve(symmetric_band_matrix& a, Rhs& b, solver_ctx& ctx) {
+    factorize(a, ctx);
+    solve_with_factorized(a, b, ctx);
+}
+
+// Solvers for lines along the first dimension of strided views (e.g. slices of tensors), which can
+// be passed directly as temporaries. Like other solvers with const context, they can be called
+// concurrently for disjoint views.
+
+template <typename T, std::size_t Rank>
+inline void solve_with_factorized(const band_matrix& a, const strided_view<T, Rank>& b,
+                                  const solver_ctx& ctx) {
+    detail::solve_view(a, b, ctx);
+}
+
+template <typename T, std::size_t Rank>
+inline void solve_with_factorized(const symmetric_band_matrix& a, const strided_view<T, Rank>& b,
+                                  const solver_ctx& ctx) {
+    detail::solve_view(a, b, ctx);
+}
+
 }  // namespace ads::lin
 
 #endif  // ADS_LIN_BAND_SOLVE_HPP
@@ -4,17 +4,20 @@
 #ifndef ADS_LIN_DENSE_MATRIX_HPP
 #define ADS_LIN_DENSE_MATRIX_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <iomanip>
 #include <iostream>
 #include <vector>
 
+#include "ads/lin/allocator.hpp"
 #include "ads/lin/lapack.hpp"
 
 namespace ads::lin {
 
 class dense_matrix {
 private:
-    std::vector<double> data_;
+    std::vector<double, default_allocator<double>> data_;
     int rows_;
     int cols_;
 
@@ -22,7 +25,9 @@ class dense_matrix {
     dense_matrix(int rows, int cols)
     : data_(rows * cols)
     , rows_(rows)
-    , cols_(cols) { }
+    , cols_(cols) {
+        zero();
+    }
 
     double& operator()(int i, int j) { return data_[j * rows_ + i]; }
 
@@ -65,8 +70,8 @@ inline void multiply(const dense_matrix& M, const Vec1& x, Vec2& y, int count =
     int cols = M.cols();
 
     for (int i = 0; i < count; ++i) {
-        auto in = x.data() + M.rows() * i;
-        auto out = y.data() + M.cols() * i;
+        auto in = x.data() + static_cast<std::ptrdiff_t>(M.rows()) * i;
+        auto out = y.data() + static_cast<std::ptrdiff_t>(M.cols()) * i;
         dgemv_(transpose, &rows, &cols, &alpha, M.data(), &lda, in, &incx, &beta, out, &incy);
     }
 }
@@ -5,10 +5,13 @@
 #define ADS_LIN_DENSE_SOLVE_HPP
 
 #include <iostream>
+#include <type_traits>
 
 #include "ads/lin/dense_matrix.hpp"
 #include "ads/lin/lapack.hpp"
 #include "ads/lin/solver_ctx.hpp"
+#include "ads/lin/tensor/strided_view.hpp"
+#include "ads/util.hpp"
 
 namespace ads::lin {
 
@@ -20,9 +23,15 @@ inline void factorize(dense_matrix& a, solver_ctx& ctx) {
 
 template <typename Rhs>
 inline void solve_with_factorized(const dense_matrix& a, Rhs& b, solver_ctx& ctx) {
-    int nrhs = b.size() / b.size(0);
+    static_assert(!is_strided_view<std::remove_const_t<Rhs>>,
+                  "Dense solver requires contiguous right-hand side");
+    int nrhs = narrow_cast<int>(b.size() / b.size(0));
     int n = a.rows();
-    dgetrs_("N", &n, &nrhs, a.data(), &ctx.lda, ctx.pivot(), b.data(), &n, &ctx.info);
+    ctx.info = detail::solve_lapack_batches(n, b.data(), nrhs, [&](double* x, int count) {
+        int info = 0;
+        dgetrs_("N", &n, &count, a.data(), &ctx.lda, ctx.pivot(), x, &n, &info);
+        return info;
+    });
 }
 
 }  // namespace ads::lin
@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_LIN_FAST_DIAGONALIZATION_HPP
+#define ADS_LIN_FAST_DIAGONALIZATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/dense_matrix.hpp"
+#include "ads/lin/lapack.hpp"
+#include "ads/lin/symmetric_band_matrix.hpp"
+#include "ads/lin/tensor.hpp"
+
+namespace ads::lin {
+
+/**
+ * @brief Simultaneous diagonalization of a pair of 1D matrices.
+ *
+ * For a symmetric positive definite matrix M (e.g. mass matrix) and a symmetric matrix K (e.g.
+ * stiffness matrix), solves the generalized eigenproblem K v = lambda M v. The eigenvectors,
+ * stored as columns of V, satisfy V^T M V = I and V^T K V = Lambda, so that M^-1 K = V Lambda V^-1
+ * with V^-1 = V^T M.
+ *
+ * If the computation fails, @c info holds the LAPACK (dsygv) status code.
+ */
+class generalized_eigenbasis {
+private:
+    dense_matrix vectors_;
+    std::vector<double> values_;
+
+public:
+    int info = 0;
+
+    generalized_eigenbasis(dense_matrix M, dense_matrix K)
+    : vectors_{std::move(K)}
+    , values_(vectors_.rows()) {
+        assert(M.rows() == vectors_.rows() && "Incompatible matrix sizes");
+        int const itype = 1;
+        int const n = vectors_.rows();
+        int const lwork = std::max(1, 3 * n - 1);
+        auto work = std::vector<double>(lwork);
+
+        dsygv_(&itype, "V", "U", &n, vectors_.data(), &n, M.data(), &n, values_.data(),
+               work.data(), &lwork, &info);
+    }
+
+    generalized_eigenbasis(const band_matrix& M, const band_matrix& K)
+    : generalized_eigenbasis{dense(M), dense(K)} { }
+
+    generalized_eigenbasis(const symmetric_band_matrix& M, const symmetric_band_matrix& K)
+    : generalized_eigenbasis{dense(M), dense(K)} { }
+
+    int size() const { return vectors_.rows(); }
+
+    // Matrix V with eigenvectors as columns
+    const dense_matrix& vectors() const { return vectors_; }
+
+    // Eigenvalues lambda in ascending order
+    const std::vector<double>& values() const { return values_; }
+
+private:
+    static dense_matrix dense(const band_matrix& M) {
+        dense_matrix out{M.rows, M.cols};
+        to_dense(M, out);
+        return out;
+    }
+
+    static dense_matrix dense(const symmetric_band_matrix& M) {
+        dense_matrix out{M.n, M.n};
+        to_dense(M, out);
+        return out;
+    }
+};
+
+// Which of the two matrices of a generalized_eigenbasis a Kronecker product term uses
+enum class kron_factor {
+    mass,       // M
+    stiffness,  // K
+};
+
+/**
+ * @brief Single term of a Kronecker sum - product of 1D matrices scaled by a coefficient.
+ *
+ * @c factors[d] is the 1D matrix acting along d-th dimension of the tensor, i.e. for Dim = 2 the
+ * term {c, {A, B}} maps u to c * v, where v(i, j) = sum_{k, l} A(i, k) B(j, l) u(k, l).
+ */
+template <std::size_t Dim>
+struct kronecker_term {
+    double coefficient;
+    std::array<kron_factor, Dim> factors;
+};
+
+/**
+ * @brief Direct solver for systems with Kronecker sum operators, using fast diagonalization.
+ *
+ * Solves systems whose matrix is a sum of terms of the form c * A_1 (x) ... (x) A_Dim, where each
+ * A_d is either M_d or K_d of d-th dimension, e.g.
+ *
+ *   M (x) M + eta (K (x) M + M (x) K) + eta^2 K (x) K
+ *
+ * Since all the terms are diagonalized by the same basis V = V_1 (x) ... (x) V_Dim, the inverse is
+ *
+ *   V D^-1 V^T
+ *
+ * where D is diagonal, with entries computed from the eigenvalues. Applying V^T and V amounts to
+ * dense matrix multiplications (GEMM) along each dimension, so the cost is O(N (n_1 + ... + n_Dim))
+ * for a problem of size N = n_1 * ... * n_Dim.
+ *
+ * Throws std::runtime_error if computing any of the eigenbases failed, or if the operator is
+ * singular, i.e. some entry of D vanishes.
+ *
+ * @tparam Dim number of dimensions (1, 2 or 3)
+ */
+template <std::size_t Dim>
+class fast_diagonalization_solver {
+private:
+    std::array<generalized_eigenbasis, Dim> bases_;
+    tensor<double, Dim> inverse_diagonal_;
+
+public:
+    static_assert(Dim >= 1 && Dim <= 3, "Only dimensions 1 to 3 are supported");
+
+    using term = kronecker_term<Dim>;
+
+    fast_diagonalization_solver(std::array<generalized_eigenbasis, Dim> bases,
+                                const std::vector<term>& terms)
+    : bases_{std::move(bases)}
+    , inverse_diagonal_{sizes()} {
+        for (auto const& basis : bases_) {
+            if (basis.info != 0) {
+                throw std::runtime_error{"dsygv failed for the generalized eigenproblem, info = "
+                                         + std::to_string(basis.info)};
+            }
+        }
+        compute_inverse_diagonal(terms);
+    }
+
+    std::array<int, Dim> sizes() const {
+        std::array<int, Dim> sizes;
+        for (std::size_t d = 0; d < Dim; ++d) {
+            sizes[d] = bases_[d].size();
+        }
+        return sizes;
+    }
+
+    const generalized_eigenbasis& basis(std::size_t d) const { return bases_[d]; }
+
+    /**
+     * @brief Solves the system in place.
+     *
+     * @param rhs right-hand side, overwritten with the solution
+     * @param buf auxiliary buffer large enough to store @p rhs
+     */
+    template <typename Rhs, typename Buf>
+    void solve(Rhs& rhs, Buf& buf) const {
+        assert(rhs.sizes() == sizes() && "Invalid right-hand side size");
+
+        apply_eigenvectors(rhs.data(), buf.data(), "T");
+
+        auto* const data = rhs.data();
+        auto const* const diag = inverse_diagonal_.data();
+        for (linear_index_type i = 0; i < inverse_diagonal_.size(); ++i) {
+            data[i] *= diag[i];
+        }
+
+        apply_eigenvectors(rhs.data(), buf.data(), "N");
+    }
+
+private:
+    // Applies V^T (trans = "T") or V (trans = "N") to x, using tmp as scratch space. Each step
+    // multiplies the leading dimension by V_d and rotates the dimensions, so that after Dim steps
+    // the original order is restored.
+    void apply_eigenvectors(double* x, double* tmp, const char* trans) const {
+        auto sizes = this->sizes();
+        auto const total = inverse_diagonal_.size();
+
+        for (std::size_t d = 0; d < Dim; ++d) {
+            auto const& V = bases_[d].vectors();
+            int const n = sizes[0];
+            int const cols = narrow_cast<int>(total / n);
+            double const alpha = 1;
+            double const beta = 0;
+
+            dgemm_(trans, "N", &n, &cols, &n, &alpha, V.data(), &n, x, &n, &beta, tmp, &n);
+
+            auto const product = as_tensor(tmp, sizes);
+            auto const transposed = cyclic_transpose(product, x);
+            sizes = transposed.sizes();
+        }
+    }
+
+    void compute_inverse_diagonal(const std::vector<term>& terms) {
+        auto const sizes = this->sizes();
+        auto index = std::array<int, Dim>{};
+        auto* const diag = inverse_diagonal_.data();
+
+        for (linear_index_type i = 0; i < inverse_diagonal_.size(); ++i) {
+            double sum = 0;
+            double scale = 0;
+            for (auto const& t : terms) {
+                double val = t.coefficient;
+                for (std::size_t d = 0; d < Dim; ++d) {
+                    if (t.factors[d] == kron_factor::stiffness) {
+                        val *= bases_[d].values()[index[d]];
+                    }
+                }
+                sum += val;
+                scale += std::abs(val);
+            }
+            // zero up to the rounding errors of the sum
+            if (!(std::abs(sum) > std::numeric_limits<double>::epsilon() * scale)) {
+                throw std::runtime_error{"Singular Kronecker sum in fast diagonalization solver"};
+            }
+            diag[i] = 1 / sum;
+
+            // next multi-index, first one changes fastest
+            for (std::size_t d = 0; d < Dim && ++index[d] == sizes[d]; ++d) {
+                index[d] = 0;
+            }
+        }
+    }
+};
+
+}  // namespace ads::lin
+
+#endif  // ADS_LIN_FAST_DIAGONALIZATION_HPP
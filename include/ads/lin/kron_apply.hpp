@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_LIN_KRON_APPLY_HPP
+#define ADS_LIN_KRON_APPLY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/range/counting_range.hpp>
+
+#include "ads/executor/chunking.hpp"
+#include "ads/executor/sequential.hpp"
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/dense_matrix.hpp"
+#include "ads/lin/lapack.hpp"
+#include "ads/lin/tensor/base.hpp"
+#include "ads/util.hpp"
+
+namespace ads::lin {
+
+/**
+ * @brief Non-owning reference to a 1D matrix used as a factor of a Kronecker product.
+ *
+ * Implicitly constructible from band and dense matrices, so that factors of different kinds can be
+ * passed in a single braced list. Band matrices may use either plain or LU storage layout, but
+ * need to hold the original (not factorized) entries.
+ */
+class kron_operand {
+private:
+    const band_matrix* band_ = nullptr;
+    const dense_matrix* dense_ = nullptr;
+
+public:
+    kron_operand(const band_matrix& a)  // NOLINT(google-explicit-constructor)
+    : band_{&a} { }
+
+    kron_operand(const dense_matrix& a)  // NOLINT(google-explicit-constructor)
+    : dense_{&a} { }
+
+    int rows() const { return band_ ? band_->rows : dense_->rows(); }
+
+    int cols() const { return band_ ? band_->cols : dense_->cols(); }
+
+    template <typename Fun>
+    decltype(auto) visit(Fun&& fun) const {
+        if (band_) {
+            return std::forward<Fun>(fun)(*band_);
+        }
+        return std::forward<Fun>(fun)(*dense_);
+    }
+};
+
+namespace detail {
+
+// Products of a matrix A (m x n) with lines of the input. Lines of length n are either contiguous
+// columns of x (leading dimension), or interleaved with the given stride. Computes
+// y = alpha A x + beta y for each line, y is not read if beta = 0.
+
+inline void kron_leading(const band_matrix& A, const double* x, double* y, int count,
+                         double alpha, double beta) {
+    int const lda = A.column_size();
+    int const inc = 1;
+    auto const* const band = A.full_buffer() + A.row_offset;
+
+    for (int i = 0; i < count; ++i) {
+        auto const* const in = x + static_cast<std::ptrdiff_t>(i) * A.cols;
+        auto* const out = y + static_cast<std::ptrdiff_t>(i) * A.rows;
+        dgbmv_("N", &A.rows, &A.cols, &A.kl, &A.ku, &alpha, band, &lda, in, &inc, &beta, out, &inc);
+    }
+}
+
+inline void kron_leading(const dense_matrix& A, const double* x, double* y, int count,
+                         double alpha, double beta) {
+    int const m = A.rows();
+    int const n = A.cols();
+    dgemm_("N", "N", &m, &count, &n, &alpha, A.data(), &m, x, &n, &beta, y, &m);
+}
+
+inline void kron_strided(const band_matrix& A, const double* x, double* y, int count,
+                         std::ptrdiff_t stride, double alpha, double beta) {
+    for (int i = 0; i < A.rows; ++i) {
+        auto* const out = y + i * stride;
+        if (beta == 0) {
+            std::fill(out, out + count, 0.0);
+        } else {
+            for (int j = 0; j < count; ++j) {
+                out[j] *= beta;
+            }
+        }
+        int const first = std::max(i - A.kl, 0);
+        int const last = std::min(i + A.ku, A.cols - 1);
+        for (int k = first; k <= last; ++k) {
+            double const a = alpha * A(i, k);
+            auto const* const in = x + k * stride;
+            for (int j = 0; j < count; ++j) {
+                out[j] += a * in[j];
+            }
+        }
+    }
+}
+
+inline void kron_strided(const dense_matrix& A, const double* x, double* y, int count,
+                         std::ptrdiff_t stride, double alpha, double beta) {
+    int const m = A.rows();
+    int const n = A.cols();
+    int const ld = narrow_cast<int>(stride);
+    dgemm_("N", "T", &count, &m, &n, &alpha, x, &ld, A.data(), &m, &beta, y, &ld);
+}
+
+// Chunks narrower than this are not worth the overhead of a separate task
+constexpr int kron_min_chunk_size = 8;
+
+inline int kron_chunk_count(std::ptrdiff_t columns, int max_chunks) {
+    auto const count = std::min<std::ptrdiff_t>(max_chunks, columns / kron_min_chunk_size);
+    return std::max(narrow_cast<int>(count), 1);
+}
+
+inline std::ptrdiff_t kron_chunk_begin(int i, std::ptrdiff_t columns, int count) {
+    return i * columns / count;
+}
+
+/**
+ * Multiplies the tensor x of given sizes by A along dimension d. The tensor is viewed as outer
+ * (stride x n) matrices, with lines along d as their rows. Lines are split into chunks, which are
+ * processed by the executor.
+ */
+template <std::size_t Rank, typename Executor>
+void kron_mode_product(const kron_operand& A, const double* x, double* y,
+                       const std::array<int, Rank>& sizes, std::size_t d, double alpha,
+                       double beta, int max_chunks, const Executor& executor) {
+    std::ptrdiff_t stride = 1;
+    for (std::size_t i = 0; i < d; ++i) {
+        stride *= sizes[i];
+    }
+    std::ptrdiff_t outer = 1;
+    for (std::size_t i = d + 1; i < Rank; ++i) {
+        outer *= sizes[i];
+    }
+    auto const n = static_cast<std::ptrdiff_t>(A.cols());
+    auto const m = static_cast<std::ptrdiff_t>(A.rows());
+
+    if (stride == 1) {
+        auto const count = kron_chunk_count(outer, max_chunks);
+        executor.for_each(boost::counting_range(0, count), [&](int i) {
+            auto const begin = kron_chunk_begin(i, outer, count);
+            auto const end = kron_chunk_begin(i + 1, outer, count);
+            A.visit([&](auto const& a) {
+                kron_leading(a, x + begin * n, y + begin * m, narrow_cast<int>(end - begin),
+                             alpha, beta);
+            });
+        });
+    } else {
+        auto const columns = stride * outer;
+        auto const count = kron_chunk_count(columns, max_chunks);
+        executor.for_each(boost::counting_range(0, count), [&](int i) {
+            auto const end = kron_chunk_begin(i + 1, columns, count);
+            for (auto col = kron_chunk_begin(i, columns, count); col < end;) {
+                auto const k = col / stride;
+                auto const size = std::min(end, (k + 1) * stride) - col;
+                auto const* const in = x + k * stride * n + col % stride;
+                auto* const out = y + k * stride * m + col % stride;
+                A.visit([&](auto const& a) {
+                    kron_strided(a, in, out, narrow_cast<int>(size), stride, alpha, beta);
+                });
+                col += size;
+            }
+        });
+    }
+}
+
+template <std::size_t Rank, typename Executor>
+void kron_apply(double* y, const double* x, std::array<int, Rank> sizes,
+                const kron_operand (&factors)[Rank], double alpha, double beta, int max_chunks,
+                const Executor& executor) {
+    if constexpr (Rank == 1) {
+        kron_mode_product(factors[0], x, y, sizes, 0, alpha, beta, max_chunks, executor);
+    } else {
+        // Sizes of intermediate results - dimensions 0, ..., d already multiplied
+        std::ptrdiff_t buffer_size = 0;
+        auto current = sizes;
+        for (std::size_t d = 0; d + 1 < Rank; ++d) {
+            current[d] = factors[d].rows();
+            std::ptrdiff_t size = 1;
+            for (auto s : current) {
+                size *= s;
+            }
+            buffer_size = std::max(buffer_size, size);
+        }
+        // Two buffers used alternately, a single one suffices for Rank = 2
+        auto buffers = std::vector<double>((Rank > 2 ? 2 : 1) * buffer_size);
+
+        const double* in = x;
+        for (std::size_t d = 0; d < Rank; ++d) {
+            bool const last = d + 1 == Rank;
+            auto const offset = static_cast<std::ptrdiff_t>(d % 2) * buffer_size;
+            double* const out = last ? y : buffers.data() + offset;
+            kron_mode_product(factors[d], in, out, sizes, d, last ? alpha : 1, last ? beta : 0,
+                              max_chunks, executor);
+            sizes[d] = factors[d].rows();
+            in = out;
+        }
+    }
+}
+
+template <std::size_t Rank, typename ImplY, typename ImplX>
+void check_kron_sizes([[maybe_unused]] const tensor_base<double, Rank, ImplY>& y,
+                      [[maybe_unused]] const tensor_base<double, Rank, ImplX>& x,
+                      [[maybe_unused]] const kron_operand (&factors)[Rank]) {
+    for (int d = 0; d < narrow_cast<int>(Rank); ++d) {
+        assert(x.size(d) == factors[d].cols() && "Invalid input tensor size");
+        assert(y.size(d) == factors[d].rows() && "Invalid output tensor size");
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Applies Kronecker product of 1D matrices to a tensor without assembling it.
+ *
+ * Computes y = alpha (A_1 (x) ... (x) A_Rank) x + beta y, where A_d acts along d-th dimension of
+ * the tensor, i.e. for Rank = 2
+ *
+ *   y(i, j) = alpha sum_{k, l} A_1(i, k) A_2(j, l) x(k, l) + beta y(i, j)
+ *
+ * The product is evaluated as a sequence of Rank sweeps, each multiplying lines along a single
+ * dimension by a 1D matrix (dgbmv for band matrices, GEMM for dense matrices), so the cost is
+ * O(N (w_1 + ... + w_Rank)) for a tensor of size N and matrices with w_d non-zero entries per row.
+ * Matrices may be rectangular. Sums of Kronecker products (e.g. K (x) M + M (x) K) are applied by
+ * accumulating successive terms with beta = 1.
+ *
+ * @p x and @p y must not overlap. Intermediate results of the sweeps are stored in temporary
+ * buffers.
+ */
+template <std::size_t Rank, typename ImplY, typename ImplX>
+void kron_apply(tensor_base<double, Rank, ImplY>& y, const tensor_base<double, Rank, ImplX>& x,
+                const kron_operand (&factors)[Rank], double alpha = 1, double beta = 0) {
+    detail::check_kron_sizes(y, x, factors);
+    detail::kron_apply(y.data(), x.data(), x.sizes(), factors, alpha, beta, 1,
+                       sequential_executor{});
+}
+
+/**
+ * @brief Applies Kronecker product of 1D matrices to a tensor, using executor to process the
+ * lines of each sweep in parallel.
+ *
+ * Lines of each sweep are split into chunks in the same manner as by @c parallel_sweep.
+ *
+ * @param chunks number of chunks each sweep is split into, chosen based on the number of threads
+ *        of the executor if not positive
+ */
+template <typename Executor, std::size_t Rank, typename ImplY, typename ImplX>
+void kron_apply(const Executor& executor, tensor_base<double, Rank, ImplY>& y,
+                const tensor_base<double, Rank, ImplX>& x, const kron_operand (&factors)[Rank],
+                double alpha = 1, double beta = 0, int chunks = 0) {
+    detail::check_kron_sizes(y, x, factors);
+    if (chunks <= 0) {
+        chunks = std::max(chunk_count(executor, x.size()), 1);
+    }
+    detail::kron_apply(y.data(), x.data(), x.sizes(), factors, alpha, beta, chunks, executor);
+}
+
+}  // namespace ads::lin
+
+#endif  // ADS_LIN_KRON_APPLY_HPP
@@ -4,6 +4,10 @@
 #ifndef ADS_LIN_LAPACK_HPP
 #define ADS_LIN_LAPACK_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
 // LAPACK routines
 extern "C" {
 
@@ -54,6 +58,20 @@ int dgbmv_(             //
     in_int incy         //
 );
 
+int dsbmv_(            //
+    const char* uplo,   //
+    in_int n,           //
+    in_int k,           //
+    in_double alpha,    //
+    const double* a,    //
+    in_int lda,         //
+    const double* x,    //
+    in_int incx,        //
+    in_double beta,     //
+    double* y,          //
+    in_int incy         //
+);
+
 int dgemv_(             //
     const char* trans,  //
     in_int m,           //
@@ -68,6 +86,58 @@ int dgemv_(             //
     in_int incy         //
 );                      //
 
+int dpbtrf_(            //
+    const char* uplo,   //
+    in_int n,           //
+    in_int kd,          //
+    double* ab,         //
+    in_int ldab,        //
+    out_int info        //
+);
+
+int dpbtrs_(            //
+    const char* uplo,   //
+    in_int n,           //
+    in_int kd,          //
+    in_int nrhs,        //
+    const double* ab,   //
+    in_int ldab,        //
+    double* b,          //
+    in_int ldb,         //
+    out_int info        //
+);
+
+int dgemm_(              //
+    const char* transa,  //
+    const char* transb,  //
+    in_int m,            //
+    in_int n,            //
+    in_int k,            //
+    in_double alpha,     //
+    const double* a,     //
+    in_int lda,          //
+    const double* b,     //
+    in_int ldb,          //
+    in_double beta,      //
+    double* c,           //
+    in_int ldc           //
+);
+
+int dsygv_(             //
+    in_int itype,       //
+    const char* jobz,   //
+    const char* uplo,   //
+    in_int n,           //
+    double* a,          //
+    in_int lda,         //
+    double* b,          //
+    in_int ldb,         //
+    double* w,          //
+    double* work,       //
+    in_int lwork,       //
+    out_int info        //
+);
+
 int dgetrf_(             //
     in_int m,            //
     in_int n,            //
@@ -90,4 +160,30 @@ int dgetrs_(            //
 );
 }
 
+namespace ads::lin::detail {
+
+// Largest number of right-hand sides of size n passed to a single LAPACK call, so that offsets
+// within the array of right-hand sides fit in 32-bit integers
+inline auto lapack_rhs_batch(int n) -> int {
+    return std::numeric_limits<int>::max() / std::max(n, 1);
+}
+
+// Solves right-hand sides stored contiguously in batches of at most lapack_rhs_batch(n), using
+// solve(b, count) returning LAPACK status code. Stops at the first failure.
+template <typename T, typename Solve>
+int solve_lapack_batches(int n, T* b, int nrhs, Solve&& solve) {
+    auto const batch = lapack_rhs_batch(n);
+    for (int begin = 0; begin < nrhs;) {
+        int count = std::min(batch, nrhs - begin);
+        int const info = solve(b + static_cast<std::ptrdiff_t>(begin) * n, count);
+        if (info != 0) {
+            return info;
+        }
+        begin += count;
+    }
+    return 0;
+}
+
+}  // namespace ads::lin::detail
+
 #endif  // ADS_LIN_LAPACK_HPP
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_LIN_NUMA_HPP
+#define ADS_LIN_NUMA_HPP
+
+#include <cstddef>
+
+namespace ads::lin {
+
+// Placement of memory pages on NUMA nodes
+enum class numa_policy {
+    first_touch,  // on the node of the thread that touches the page first (system default)
+    interleave,   // round-robin over all the nodes
+    bind,         // all the pages on a single node
+};
+
+struct numa_placement {
+    numa_policy policy = numa_policy::first_touch;
+    int node = 0;  // node used by the bind policy
+};
+
+// Number of NUMA nodes, 1 if ADS is built without NUMA support
+int numa_node_count();
+
+/**
+ * @brief Sets placement policy for pages of a memory region that has not been touched yet.
+ *
+ * Only pages entirely contained in the region are affected. Does nothing for the first touch
+ * policy, or if ADS is built without NUMA support (ADS_USE_NUMA).
+ *
+ * @return true if the policy has been applied
+ */
+bool apply_numa_placement(void* data, std::size_t bytes, const numa_placement& placement);
+
+}  // namespace ads::lin
+
+#endif  // ADS_LIN_NUMA_HPP
@@ -8,6 +8,7 @@
 
 #include "ads/lin/band_matrix.hpp"
 #include "ads/lin/dense_matrix.hpp"
+#include "ads/lin/symmetric_band_matrix.hpp"
 
 namespace ads::lin {
 
@@ -23,10 +24,16 @@ struct solver_ctx {
     explicit solver_ctx(const band_matrix& a)
     : solver_ctx(a.rows, 2 * a.kl + a.ku + 1) { }
 
+    // Cholesky factorization needs no pivots
+    explicit solver_ctx(const symmetric_band_matrix& a)
+    : solver_ctx(0, a.column_size()) { }
+
     explicit solver_ctx(const dense_matrix& a)
     : solver_ctx(a.rows(), a.rows()) { }
 
     int* pivot() { return pivot_vector.data(); }
+
+    const int* pivot() const { return pivot_vector.data(); }
 };
 
 }  // namespace ads::lin
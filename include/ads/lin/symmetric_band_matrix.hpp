@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_LIN_SYMMETRIC_BAND_MATRIX_HPP
+#define ADS_LIN_SYMMETRIC_BAND_MATRIX_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "ads/lin/allocator.hpp"
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/dense_matrix.hpp"
+#include "ads/lin/lapack.hpp"
+
+namespace ads::lin {
+
+/**
+ * @brief Symmetric band matrix with kd sub- and superdiagonals.
+ *
+ * Only the upper triangle is stored, in LAPACK symmetric band format (uplo = 'U'), i.e. entry
+ * (i, j) with i <= j is stored in row kd + i - j of column j, and entries (i, j) and (j, i) refer
+ * to the same value. Compared to @c band_matrix with kl = ku = kd prepared for LU factorization,
+ * it needs less than half the memory. Symmetric positive definite matrices (e.g. Gram matrices of
+ * B-spline bases) can be factorized using Cholesky decomposition, which needs no pivoting.
+ */
+class symmetric_band_matrix {
+private:
+    std::vector<double, default_allocator<double>> data_;
+
+public:
+    int kd = 0;
+    int n = 0;
+
+    symmetric_band_matrix() = default;
+
+    symmetric_band_matrix(int kd, int n)
+    : data_((kd + 1) * n)
+    , kd(kd)
+    , n(n) {
+        zero();
+    }
+
+    double& operator()(int i, int j) {
+        assert(inside_band(i, j));
+        return data_[index_(i, j)];
+    }
+
+    double operator()(int i, int j) const {
+        if (inside_band(i, j)) {
+            return data_[index_(i, j)];
+        }
+        return 0;
+    }
+
+    bool inside_band(int i, int j) const { return std::abs(i - j) <= kd; }
+
+    double* full_buffer() { return data_.data(); }
+
+    const double* full_buffer() const { return data_.data(); }
+
+    void zero() { std::fill(begin(data_), end(data_), 0); }
+
+    int column_size() const { return kd + 1; }
+
+private:
+    int index_(int i, int j) const {
+        if (i > j) {
+            std::swap(i, j);
+        }
+        return j * column_size() + kd + i - j;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const symmetric_band_matrix& M) {
+    for (int i = 0; i < M.n; ++i) {
+        for (int j = 0; j < M.n; ++j) {
+            os << std::setw(12) << M(i, j) << ' ';
+        }
+        os << std::endl;
+    }
+    return os;
+}
+
+template <typename Vec1, typename Vec2>
+inline void multiply(const symmetric_band_matrix& M, const Vec1& x, Vec2& y, int count = 1) {
+    double alpha = 1;
+    double beta = 0;
+    int incx = 1;
+    int incy = 1;
+    int lda = M.column_size();
+
+    for (int i = 0; i < count; ++i) {
+        auto in = x.data() + static_cast<std::ptrdiff_t>(M.n) * i;
+        auto out = y.data() + static_cast<std::ptrdiff_t>(M.n) * i;
+        dsbmv_("U", &M.n, &M.kd, &alpha, M.full_buffer(), &lda, in, &incx, &beta, out, &incy);
+    }
+}
+
+inline void to_dense(const symmetric_band_matrix& M, dense_matrix& out) {
+    for (int i = 0; i < M.n; ++i) {
+        for (int j = 0; j < M.n; ++j) {
+            out(i, j) = M(i, j);
+        }
+    }
+}
+
+// Extracts the symmetric part of a band matrix with equal number of sub- and superdiagonals,
+// taking entries from its upper triangle
+inline symmetric_band_matrix to_symmetric(const band_matrix& M) {
+    assert(M.kl == M.ku && M.rows == M.cols && "Matrix is not structurally symmetric");
+    auto S = symmetric_band_matrix{M.ku, M.cols};
+    for (int j = 0; j < M.cols; ++j) {
+        for (int i = std::max(0, j - M.ku); i <= j; ++i) {
+            S(i, j) = M(i, j);
+        }
+    }
+    return S;
+}
+
+}  // namespace ads::lin
+
+#endif  // ADS_LIN_SYMMETRIC_BAND_MATRIX_HPP
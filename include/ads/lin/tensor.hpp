@@ -10,7 +10,9 @@
 #include "ads/lin/tensor/equality.hpp"
 #include "ads/lin/tensor/for_each.hpp"
 #include "ads/lin/tensor/io.hpp"
+#include "ads/lin/tensor/ops.hpp"
 #include "ads/lin/tensor/reshape.hpp"
+#include "ads/lin/tensor/strided_view.hpp"
 #include "ads/lin/tensor/tensor.hpp"
 #include "ads/lin/tensor/view.hpp"
 
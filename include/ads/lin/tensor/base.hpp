@@ -6,6 +6,7 @@
 
 #include <cstddef>
 
+#include "ads/lin/tensor/strided_view.hpp"
 #include "ads/util/multi_array.hpp"
 
 namespace ads::lin {
@@ -27,6 +28,30 @@ struct tensor_base : multi_array_base<T, Rank, tensor_base<T, Rank, Impl>, rever
 
     const T* data() const { return self_()->data(); }
 
+    // Strided views of the whole tensor and its parts, see strided_view
+
+    strided_view<T, Rank> strided() { return {data(), this->sizes()}; }
+
+    strided_view<const T, Rank> strided() const { return {data(), this->sizes()}; }
+
+    template <std::size_t D>
+    strided_view<T, Rank - 1> slice(int i) {
+        return strided().template slice<D>(i);
+    }
+
+    template <std::size_t D>
+    strided_view<const T, Rank - 1> slice(int i) const {
+        return strided().template slice<D>(i);
+    }
+
+    strided_view<T, Rank> block(const size_array& begin, const size_array& sizes) {
+        return strided().block(begin, sizes);
+    }
+
+    strided_view<const T, Rank> block(const size_array& begin, const size_array& sizes) const {
+        return strided().block(begin, sizes);
+    }
+
 private:
     friend Base;
 
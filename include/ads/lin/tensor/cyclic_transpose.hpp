@@ -5,41 +5,114 @@
 #define ADS_LIN_TENSOR_CYCLIC_TRANSPOSE_HPP
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstddef>
+#include <type_traits>
+
+#include <boost/range/counting_range.hpp>
 
 #include "ads/lin/tensor/base.hpp"
+#include "ads/lin/tensor/strided_view.hpp"
 #include "ads/lin/tensor/view.hpp"
+#include "ads/util.hpp"
 
 namespace ads::lin {
 
 namespace detail {
 
-template <typename T, typename S, std::size_t Rank, typename Impl1, typename Impl2, std::size_t I,
-          typename... Indices>
-struct cyclic_transpose_helper {
-    using Input = const tensor_base<T, Rank, Impl1>&;
-    using Output = tensor_base<S, Rank, Impl2>&;
+// Cyclic transposition of a tensor with sizes (n0, n1, ..., nk) stored in reverse (column-major)
+// order is equivalent to transposing a n0 x (n1 * ... * nk) column-major matrix, since
+//
+//   a(i, j1, ..., jk) = a[i + n0 * J]  and  b(j1, ..., jk, i) = b[J + (n1 * ... * nk) * i]
+//
+// where J = j1 + n1 * (j2 + ...). Hence a single, cache-blocked matrix transposition kernel
+// handles tensors of all ranks.
+
+// Edge of square tiles the matrix is split into - a pair of tiles fits in L1 cache
+constexpr int transpose_tile_size = 32;
 
-    using Next = cyclic_transpose_helper<T, S, Rank, Impl1, Impl2, I + 1, int, Indices...>;
-    static constexpr std::size_t Index = Rank - I - 1;
+// Edge of fixed-size blocks within a tile - small enough to be kept in registers and fully
+// unrolled (and vectorized) by the compiler
+constexpr int transpose_block_size = 8;
 
-    static void do_transpose(Input a, Output b, Indices... indices) {
-        for (int i = 0; i < a.size(Index); ++i) {
-            Next::do_transpose(a, b, i, indices...);
+static_assert(transpose_tile_size % transpose_block_size == 0,
+              "Tile size must be a multiple of block size");
+
+template <typename T, typename S>
+void transpose_full_block(const T* a, S* b, std::ptrdiff_t rows, std::ptrdiff_t cols) {
+    constexpr int n = transpose_block_size;
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            b[j + cols * i] = a[i + rows * j];
         }
     }
-};
+}
 
-template <typename T, typename S, std::size_t Rank, typename Impl1, typename Impl2,
-          typename... Indices>
-struct cyclic_transpose_helper<T, S, Rank, Impl1, Impl2, Rank, int, Indices...> {
-    using Input = const tensor_base<T, Rank, Impl1>&;
-    using Output = tensor_base<S, Rank, Impl2>&;
+template <typename T, typename S>
+void transpose_partial_block(const T* a, S* b, std::ptrdiff_t rows, std::ptrdiff_t cols, int m,
+                             int n) {
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < m; ++i) {
+            b[j + cols * i] = a[i + rows * j];
+        }
+    }
+}
+
+// Transposes columns [col_begin, col_end) of column-major matrix a of size rows x cols, storing the
+// result in column-major matrix b of size cols x rows. The number of columns may exceed the range
+// of int (with 64-bit indices), the number of rows is the size of a single dimension.
+template <typename T, typename S>
+void transpose_columns(const T* a, S* b, int rows, linear_index_type cols,
+                       linear_index_type col_begin, linear_index_type col_end) {
+    constexpr linear_index_type tile = transpose_tile_size;
+    constexpr int block = transpose_block_size;
+
+    auto const lda = static_cast<std::ptrdiff_t>(rows);
+    auto const ldb = std::ptrdiff_t{cols};
+
+    for (linear_index_type j0 = col_begin; j0 < col_end; j0 += tile) {
+        auto const j1 = std::min(j0 + tile, col_end);
+
+        for (int i0 = 0; i0 < rows; i0 += transpose_tile_size) {
+            int const i1 = std::min(i0 + transpose_tile_size, rows);
+
+            for (linear_index_type j = j0; j < j1; j += block) {
+                for (int i = i0; i < i1; i += block) {
+                    const T* src = a + i + lda * j;
+                    S* dst = b + j + ldb * i;
+
+                    int const m = std::min(block, i1 - i);
+                    int const n = narrow_cast<int>(std::min<linear_index_type>(block, j1 - j));
 
-    static void do_transpose(Input a, Output b, int i, Indices... indices) {
-        b(indices..., i) = a(i, indices...);
+                    if (m == block && n == block) {
+                        transpose_full_block(src, dst, lda, ldb);
+                    } else {
+                        transpose_partial_block(src, dst, lda, ldb, m, n);
+                    }
+                }
+            }
+        }
     }
-};
+}
+
+template <typename T, typename S>
+void transpose_matrix(const T* a, S* b, int rows, int cols) {
+    transpose_columns(a, b, rows, cols, 0, cols);
+}
+
+// Parallel version - strips of tile_size columns are transposed as independent tasks
+template <typename T, typename S, typename Executor>
+void transpose_matrix(const T* a, S* b, int rows, int cols, const Executor& executor) {
+    constexpr int tile = transpose_tile_size;
+    int const strips = (cols + tile - 1) / tile;
+
+    executor.for_each(boost::counting_range(0, strips), [=](int s) {
+        int const begin = s * tile;
+        int const end = std::min(begin + tile, cols);
+        transpose_columns(a, b, rows, cols, begin, end);
+    });
+}
 
 template <std::size_t N>
 auto cyclic_transpose_sizes(const std::array<int, N>& sizes) -> std::array<int, N> {
@@ -48,17 +121,144 @@ auto cyclic_transpose_sizes(const std::array<int, N>& sizes) -> std::array<int,
     return tmp;
 }
 
+template <typename T, std::size_t Rank, typename Impl>
+auto leading_size(const tensor_base<T, Rank, Impl>& a) -> int {
+    return a.size(0);
+}
+
+template <typename T, std::size_t Rank, typename Impl>
+auto trailing_size(const tensor_base<T, Rank, Impl>& a) -> int {
+    return a.size(0) > 0 ? narrow_cast<int>(a.size() / a.size(0)) : 0;
+}
+
+// Transposes strided a, viewed as n0 x (n1 * ... * nk) matrix, into column-major matrix b with
+// leading dimension ldb
+template <typename T, typename S, std::size_t Rank>
+void transpose_strided(const strided_view<T, Rank>& a, S* b, std::ptrdiff_t ldb) {
+    auto const n = a.size(0);
+    auto const inc = a.stride(0);
+    std::ptrdiff_t col = 0;
+
+    for_each_block<1>(a.sizes(), a.strides(), [&](std::ptrdiff_t offset) {
+        auto const* const line = a.data() + offset;
+        for (int i = 0; i < n; ++i) {
+            b[col + ldb * i] = line[i * inc];
+        }
+        ++col;
+    });
+}
+
+template <typename T, std::size_t Rank>
+auto trailing_size(const strided_view<T, Rank>& a) -> std::ptrdiff_t {
+    return a.size(0) > 0 ? a.size() / a.size(0) : 0;
+}
+
+template <typename A, typename B>
+auto has_transposed_sizes(const A& a, const B& b) -> bool {
+    return b.sizes() == cyclic_transpose_sizes(a.sizes());
+}
+
 }  // namespace detail
 
 template <typename T, typename S, std::size_t Rank, typename Impl1, typename Impl2>
 void cyclic_transpose(const tensor_base<T, Rank, Impl1>& a, tensor_base<S, Rank, Impl2>& out) {
-    detail::cyclic_transpose_helper<T, S, Rank, Impl1, Impl2, 0>::do_transpose(a, out);
+    assert(detail::has_transposed_sizes(a, out) && "Invalid output tensor size");
+    detail::transpose_matrix(a.data(), out.data(), detail::leading_size(a),
+                             detail::trailing_size(a));
 }
 
 template <typename T, std::size_t Rank, typename Impl>
 tensor_view<T, Rank> cyclic_transpose(const tensor_base<T, Rank, Impl>& a, T* out) {
     tensor_view<T, Rank> view{out, detail::cyclic_transpose_sizes(a.sizes())};
-    detail::cyclic_transpose_helper<T, T, Rank, Impl, decltype(view), 0>::do_transpose(a, view);
+    cyclic_transpose(a, view);
+    return view;
+}
+
+/**
+ * @brief Cyclically transpose tensor, using executor to process parts of it in parallel.
+ *
+ * @param a tensor to transpose
+ * @param out output tensor, with dimensions of @p a rotated left by one
+ * @param executor executor used to run the tasks
+ */
+template <typename T, typename S, std::size_t Rank, typename Impl1, typename Impl2,
+          typename Executor>
+void cyclic_transpose(const tensor_base<T, Rank, Impl1>& a, tensor_base<S, Rank, Impl2>& out,
+                      const Executor& executor) {
+    assert(detail::has_transposed_sizes(a, out) && "Invalid output tensor size");
+    detail::transpose_matrix(a.data(), out.data(), detail::leading_size(a),
+                             detail::trailing_size(a), executor);
+}
+
+template <typename T, std::size_t Rank, typename Impl, typename Executor>
+tensor_view<T, Rank> cyclic_transpose(const tensor_base<T, Rank, Impl>& a, T* out,
+                                      const Executor& executor) {
+    tensor_view<T, Rank> view{out, detail::cyclic_transpose_sizes(a.sizes())};
+    cyclic_transpose(a, view, executor);
+    return view;
+}
+
+/**
+ * @brief Cyclically transposes a strided view (e.g. a block of a tensor) into a contiguous tensor.
+ *
+ * Contiguous views use the same kernel as tensors, others are transposed line by line.
+ */
+template <typename T, typename S, std::size_t Rank, typename Impl>
+void cyclic_transpose(const strided_view<T, Rank>& a, tensor_base<S, Rank, Impl>& out) {
+    assert(detail::has_transposed_sizes(a, out) && "Invalid output tensor size");
+    if (a.is_contiguous()) {
+        detail::transpose_matrix(a.data(), out.data(), a.size(0),
+                                 narrow_cast<int>(detail::trailing_size(a)));
+    } else {
+        detail::transpose_strided(a, out.data(), detail::trailing_size(a));
+    }
+}
+
+template <typename T, std::size_t Rank>
+auto cyclic_transpose(const strided_view<T, Rank>& a, std::remove_const_t<T>* out)
+    -> tensor_view<std::remove_const_t<T>, Rank> {
+    auto view = tensor_view<std::remove_const_t<T>, Rank>{
+        out, detail::cyclic_transpose_sizes(a.sizes())};
+    cyclic_transpose(a, view);
+    return view;
+}
+
+/**
+ * @brief Cyclically transposes a strided view, using executor to process parts of it in parallel.
+ *
+ * Parts with consecutive indices along the last dimension are transposed as independent tasks.
+ */
+template <typename T, typename S, std::size_t Rank, typename Impl, typename Executor>
+void cyclic_transpose(const strided_view<T, Rank>& a, tensor_base<S, Rank, Impl>& out,
+                      const Executor& executor) {
+    assert(detail::has_transposed_sizes(a, out) && "Invalid output tensor size");
+    if (a.is_contiguous()) {
+        detail::transpose_matrix(a.data(), out.data(), a.size(0),
+                                 narrow_cast<int>(detail::trailing_size(a)), executor);
+    } else if constexpr (Rank == 1) {
+        detail::transpose_strided(a, out.data(), 1);
+    } else {
+        constexpr auto last = Rank - 1;
+        auto const ldb = detail::trailing_size(a);
+        auto const part = a.size(last) > 0 ? ldb / a.size(last) : 0;
+        auto* const b = out.data();
+
+        executor.for_each(boost::counting_range(0, a.size(last)), [&](int k) {
+            auto begin = typename strided_view<T, Rank>::size_array{};
+            auto sizes = a.sizes();
+            begin[last] = k;
+            sizes[last] = 1;
+            detail::transpose_strided(a.block(begin, sizes), b + k * part, ldb);
+        });
+    }
+}
+
+template <typename T, std::size_t Rank, typename Executor>
+auto cyclic_transpose(const strided_view<T, Rank>& a, std::remove_const_t<T>* out,
+                      const Executor& executor) -> tensor_view<std::remove_const_t<T>, Rank> {
+    auto view = tensor_view<std::remove_const_t<T>, Rank>{
+        out, detail::cyclic_transpose_sizes(a.sizes())};
+    cyclic_transpose(a, view, executor);
     return view;
 }
 
@@ -16,7 +16,7 @@ namespace impl {
 
 template <typename T, std::size_t Rank>
 struct tensor_printer {
-    static_assert(Rank <= 3, "Too high tensor rank");
+    static_assert(Rank <= 4, "Too high tensor rank");
 };
 
 template <typename T>
@@ -60,6 +60,26 @@ struct tensor_printer<T, 3> {
     }
 };
 
+// Printed as a sequence of 3D blocks, one for each index of the last dimension
+template <typename T>
+struct tensor_printer<T, 4> {
+    template <typename Impl>
+    static void print(std::ostream& os, const tensor_base<T, 4, Impl>& t) {
+        for (int l = 0; l < t.size(3); ++l) {
+            os << "[" << l << "]" << std::endl;
+            for (int i = 0; i < t.size(0); ++i) {
+                for (int j = 0; j < t.size(1); ++j) {
+                    for (int k = 0; k < t.size(2); ++k) {
+                        os << std::setw(12) << t(i, j, k, l) << ' ';
+                    }
+                    os << std::endl;
+                }
+                os << std::endl;
+            }
+        }
+    }
+};
+
 }  // namespace impl
 
 template <typename T, std::size_t Rank, typename Impl>
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_LIN_TENSOR_OPS_HPP
+#define ADS_LIN_TENSOR_OPS_HPP
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "ads/lin/tensor/base.hpp"
+#include "ads/lin/tensor/strided_view.hpp"
+
+// BLAS level 1 style operations on tensors and strided views. Arguments may be any combination of
+// (contiguous) tensors and strided views of matching sizes. Lines along the first dimension are
+// processed by the inner loops, so they are fastest if it has unit stride.
+
+namespace ads::lin {
+
+namespace detail {
+
+template <typename T, std::size_t Rank, typename Impl>
+auto as_strided(tensor_base<T, Rank, Impl>& t) -> strided_view<T, Rank> {
+    return t.strided();
+}
+
+template <typename T, std::size_t Rank, typename Impl>
+auto as_strided(const tensor_base<T, Rank, Impl>& t) -> strided_view<const T, Rank> {
+    return t.strided();
+}
+
+template <typename T, std::size_t Rank>
+auto as_strided(const strided_view<T, Rank>& t) -> strided_view<T, Rank> {
+    return t;
+}
+
+template <typename X>
+using strided_of = decltype(as_strided(std::declval<X&>()));
+
+// Calls fun(x, y, n, incx, incy) for each pair of corresponding lines along the first dimension
+template <typename X, typename Y, typename Fun>
+void for_each_line_pair(const X& x, const Y& y, Fun&& fun) {
+    assert(x.sizes() == y.sizes() && "Incompatible tensor sizes");
+    auto const strides = std::array{x.strides(), y.strides()};
+    for_each_block<1>(x.sizes(), strides, [&](const auto& offsets) {
+        fun(x.data() + offsets[0], y.data() + offsets[1], x.size(0), x.stride(0), y.stride(0));
+    });
+}
+
+}  // namespace detail
+
+// y = value
+template <typename Y, typename T, typename = detail::strided_of<Y>>
+void assign(Y&& y, T value) {
+    auto const ys = detail::as_strided(y);
+    detail::for_each_block<1>(ys.sizes(), ys.strides(), [&](std::ptrdiff_t offset) {
+        auto* const line = ys.data() + offset;
+        auto const inc = ys.stride(0);
+        for (int i = 0; i < ys.size(0); ++i) {
+            line[i * inc] = value;
+        }
+    });
+}
+
+// y = x
+template <typename X, typename Y, typename = detail::strided_of<const X>,
+          typename = detail::strided_of<Y>>
+void copy(const X& x, Y&& y) {
+    detail::for_each_line_pair(detail::as_strided(x), detail::as_strided(y),
+                               [](const auto* in, auto* out, int n, auto incx, auto incy) {
+                                   for (int i = 0; i < n; ++i) {
+                                       out[i * incy] = in[i * incx];
+                                   }
+                               });
+}
+
+// y = y + alpha x
+template <typename T, typename X, typename Y, typename = detail::strided_of<const X>,
+          typename = detail::strided_of<Y>>
+void axpy(T alpha, const X& x, Y&& y) {
+    detail::for_each_line_pair(detail::as_strided(x), detail::as_strided(y),
+                               [alpha](const auto* in, auto* out, int n, auto incx, auto incy) {
+                                   for (int i = 0; i < n; ++i) {
+                                       out[i * incy] += alpha * in[i * incx];
+                                   }
+                               });
+}
+
+// y = alpha y
+template <typename T, typename Y, typename = detail::strided_of<Y>>
+void scale(T alpha, Y&& y) {
+    auto const ys = detail::as_strided(y);
+    detail::for_each_block<1>(ys.sizes(), ys.strides(), [&](std::ptrdiff_t offset) {
+        auto* const line = ys.data() + offset;
+        auto const inc = ys.stride(0);
+        for (int i = 0; i < ys.size(0); ++i) {
+            line[i * inc] *= alpha;
+        }
+    });
+}
+
+}  // namespace ads::lin
+
+#endif  // ADS_LIN_TENSOR_OPS_HPP
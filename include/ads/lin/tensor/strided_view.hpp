@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_LIN_TENSOR_STRIDED_VIEW_HPP
+#define ADS_LIN_TENSOR_STRIDED_VIEW_HPP
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "ads/util/multi_array/base.hpp"
+#include "ads/util/multi_array/ordering/strided.hpp"
+
+namespace ads::lin {
+
+/**
+ * @brief Non-owning view of a tensor with arbitrary strides.
+ *
+ * Describes lines, planes and blocks of other tensors without copying them. Slicing and taking
+ * blocks of a strided view gives another strided view, so they can be composed, e.g.
+ * @c t.slice<2>(k).block({1, 1}, {n - 2, m - 2}) is the interior of the k-th plane of t.
+ *
+ * Element type may be const-qualified, for views of const tensors.
+ */
+template <typename T, std::size_t Rank>
+struct strided_view : multi_array_base<T, Rank, strided_view<T, Rank>, strided_ordering> {
+private:
+    using Self = strided_view<T, Rank>;
+    using Base = multi_array_base<T, Rank, Self, strided_ordering>;
+    using Ordering = typename Base::Ordering;
+
+public:
+    using size_array = typename Ordering::size_array;
+    using stride_array = typename Ordering::stride_array;
+
+private:
+    T* data_;
+
+public:
+    strided_view(T* data, const size_array& sizes, const stride_array& strides)
+    : Base{Ordering{sizes, strides}}
+    , data_{data} { }
+
+    // View of contiguous memory in reverse_ordering layout
+    strided_view(T* data, const size_array& sizes)
+    : Base{Ordering{sizes}}
+    , data_{data} { }
+
+    // Views of non-const data convert to views of const data
+    template <typename S, typename = std::enable_if_t<std::is_convertible_v<S*, T*>>>
+    strided_view(const strided_view<S, Rank>& other)  // NOLINT(google-explicit-constructor)
+    : strided_view{other.data(), other.sizes(), other.strides()} { }
+
+    // Pointer to the element with all the indices equal to 0
+    T* data() const { return data_; }
+
+    std::ptrdiff_t stride(int dim) const { return this->ordering().stride(dim); }
+
+    stride_array strides() const { return this->ordering().strides(); }
+
+    bool is_contiguous() const { return this->ordering().is_contiguous(); }
+
+    /**
+     * @brief View of the sub-tensor with index along dimension @p D fixed to @p i.
+     */
+    template <std::size_t D>
+    strided_view<T, Rank - 1> slice(int i) const {
+        static_assert(D < Rank, "Index larger than rank");
+        static_assert(Rank > 1, "Slice of a 1D tensor is a single value");
+        assert(i < this->size(D) && "Index out of bounds");
+
+        auto const sizes = this->sizes();
+        auto const strides = this->strides();
+        auto sub_sizes = typename strided_view<T, Rank - 1>::size_array{};
+        auto sub_strides = typename strided_view<T, Rank - 1>::stride_array{};
+        for (std::size_t j = 0, k = 0; j < Rank; ++j) {
+            if (j != D) {
+                sub_sizes[k] = sizes[j];
+                sub_strides[k] = strides[j];
+                ++k;
+            }
+        }
+        return {data_ + i * strides[D], sub_sizes, sub_strides};
+    }
+
+    /**
+     * @brief View of the block of given sizes, starting at given multi-index.
+     */
+    strided_view block(const size_array& begin, const size_array& sizes) const {
+        [[maybe_unused]] auto const full = this->sizes();
+        auto const strides = this->strides();
+        std::ptrdiff_t offset = 0;
+        for (std::size_t i = 0; i < Rank; ++i) {
+            assert(begin[i] >= 0 && begin[i] + sizes[i] <= full[i] && "Invalid block");
+            offset += begin[i] * strides[i];
+        }
+        return {data_ + offset, sizes, strides};
+    }
+
+private:
+    friend Base;
+
+    T& storage_(std::size_t idx) const { return data_[idx]; }
+};
+
+template <typename T>
+constexpr bool is_strided_view = false;
+
+template <typename T, std::size_t Rank>
+constexpr bool is_strided_view<strided_view<T, Rank>> = true;
+
+namespace detail {
+
+/**
+ * Calls fun(offsets) for each block of Rank - First dimensional multi-index of dimensions First,
+ * ..., Rank - 1, with offsets of the first element of the block in each of the arrays described by
+ * strides. Index along dimension First changes fastest.
+ */
+template <std::size_t First, std::size_t Rank, std::size_t N, typename Fun>
+void for_each_block(const std::array<int, Rank>& sizes,
+                    const std::array<std::array<std::ptrdiff_t, Rank>, N>& strides, Fun&& fun) {
+    auto offsets = std::array<std::ptrdiff_t, N>{};
+    for (std::size_t d = First; d < Rank; ++d) {
+        if (sizes[d] == 0) {
+            return;
+        }
+    }
+    auto index = std::array<int, Rank>{};
+    while (true) {
+        fun(std::as_const(offsets));
+
+        // increment multi-index, first of the dimensions changing fastest
+        std::size_t d = First;
+        for (; d < Rank; ++d) {
+            ++index[d];
+            for (std::size_t k = 0; k < N; ++k) {
+                offsets[k] += strides[k][d];
+            }
+            if (index[d] < sizes[d]) {
+                break;
+            }
+            for (std::size_t k = 0; k < N; ++k) {
+                offsets[k] -= sizes[d] * strides[k][d];
+            }
+            index[d] = 0;
+        }
+        if (d >= Rank) {
+            return;
+        }
+    }
+}
+
+// Variant of the above for a single array, calls fun(offset)
+template <std::size_t First, std::size_t Rank, typename Fun>
+void for_each_block(const std::array<int, Rank>& sizes,
+                    const std::array<std::ptrdiff_t, Rank>& strides, Fun&& fun) {
+    auto const all_strides = std::array<std::array<std::ptrdiff_t, Rank>, 1>{strides};
+    for_each_block<First>(sizes, all_strides, [&](const auto& offsets) { fun(offsets[0]); });
+}
+
+}  // namespace detail
+
+}  // namespace ads::lin
+
+#endif  // ADS_LIN_TENSOR_STRIDED_VIEW_HPP
@@ -4,8 +4,15 @@
 #ifndef ADS_LIN_TENSOR_TENSOR_HPP
 #define ADS_LIN_TENSOR_TENSOR_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <vector>
 
+#include <boost/range/counting_range.hpp>
+
+#include "ads/executor/chunking.hpp"
+#include "ads/lin/allocator.hpp"
+#include "ads/lin/numa.hpp"
 #include "ads/lin/tensor/base.hpp"
 
 namespace ads::lin {
@@ -13,8 +20,8 @@ namespace ads::lin {
 namespace detail {
 
 template <std::size_t N>
-int product(const std::array<int, N>& ns) {
-    int p = 1;
+linear_index_type product(const std::array<int, N>& ns) {
+    linear_index_type p = 1;
     for (auto n : ns) {
         p *= n;
     }
@@ -23,32 +30,77 @@ int product(const std::array<int, N>& ns) {
 
 }  // namespace detail
 
-template <typename T, std::size_t Rank>
-struct tensor : tensor_base<T, Rank, tensor<T, Rank>> {
+/**
+ * @brief Tensor owning its data.
+ *
+ * @tparam Alloc allocator of the storage, should leave elements default-initialized (see
+ *         @c aligned_allocator), so that memory is first touched when the tensor is zeroed
+ */
+template <typename T, std::size_t Rank, typename Alloc = default_allocator<T>>
+struct tensor : tensor_base<T, Rank, tensor<T, Rank, Alloc>> {
 private:
-    using Self = tensor<T, Rank>;
+    using Self = tensor<T, Rank, Alloc>;
     using Base = tensor_base<T, Rank, Self>;
     using size_array = typename Base::size_array;
 
-    std::vector<T> buffer_;
+    std::vector<T, Alloc> buffer_;
 
 public:
     explicit tensor(const size_array& sizes)
     : Base{sizes}
-    , buffer_(detail::product(sizes)) { }
+    , buffer_(detail::product(sizes)) {
+        fill_with_zeros();
+    }
+
+    /**
+     * @brief Creates a zero-initialized tensor, with memory first touched in parallel.
+     *
+     * Contiguous parts of the tensor are zeroed by tasks run by the executor, so that with the
+     * first touch policy each part is placed on the NUMA node of the thread that initialized it.
+     * Loops later splitting the tensor into contiguous chunks in the same manner (e.g. the ones of
+     * @c parallel_sweep) then access mostly local memory.
+     *
+     * @param executor executor used to initialize the memory
+     * @param placement NUMA placement policy, applied before the memory is touched
+     */
+    template <typename Executor>
+    tensor(const size_array& sizes, const Executor& executor, const numa_placement& placement = {})
+    : Base{sizes}
+    , buffer_(detail::product(sizes)) {
+        apply_numa_placement(buffer_.data(), buffer_.size() * sizeof(T), placement);
+        fill_with_zeros(executor);
+    }
 
     T* data() { return buffer_.data(); }
 
     const T* data() const { return buffer_.data(); }
 
-    void fill_with_zeros() { buffer_.assign(buffer_.size(), T{}); }
+    void fill_with_zeros() { std::fill(begin(buffer_), end(buffer_), T{}); }
+
+    template <typename Executor>
+    void fill_with_zeros(const Executor& executor) {
+        auto const size = static_cast<std::ptrdiff_t>(buffer_.size());
+        auto const parts = chunk_count(executor, size);
+        auto* const data = buffer_.data();
+
+        executor.for_each(boost::counting_range(0, parts), [=](int i) {
+            auto const first = data + i * size / parts;
+            auto const last = data + (i + 1) * size / parts;
+            std::fill(first, last, T{});
+        });
+    }
 };
 
-template <typename T, std::size_t Rank>
-void zero(tensor<T, Rank>& tensor) {
+template <typename T, std::size_t Rank, typename Alloc>
+void zero(tensor<T, Rank, Alloc>& tensor) {
     tensor.fill_with_zeros();
 }
 
+template <typename T, std::size_t Rank, typename Alloc, typename Executor>
+void zero(tensor<T, Rank, Alloc>& tensor, const Executor& executor) {
+    tensor.fill_with_zeros(executor);
+}
+
 }  // namespace ads::lin
 
 #endif  // ADS_LIN_TENSOR_TENSOR_HPP
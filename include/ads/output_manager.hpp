@@ -145,6 +145,64 @@ struct output_manager<3> : output_manager_base<output_manager<3>> {
     }
 };
 
+// Space-time solutions are written as snapshots - 3D grids of values at given time instants
+template <>
+struct output_manager<4> {
+private:
+    using coeff_array = lin::tensor<double, 3>;
+    output_manager<3> space;
+    bspline::basis t;
+    bspline::eval_ctx t_ctx;
+    coeff_array coeffs;
+
+public:
+    output_manager(const bspline::basis& bx, const bspline::basis& by, const bspline::basis& bz,
+                   const bspline::basis& bt, std::size_t n)
+    : space{bx, by, bz, n}
+    , t{bt}
+    , t_ctx{bt.degree}
+    , coeffs{{bx.dofs(), by.dofs(), bz.dofs()}} { }
+
+    // Coefficients of the spatial solution at time s, valid until the next call
+    template <typename Solution>
+    const coeff_array& snapshot(const Solution& sol, double s) {
+        int const span = bspline::find_span(s, t);
+        double* const vals = t_ctx.basis_vals();
+        bspline::eval_basis(span, s, t, vals, t_ctx);
+        int const offset = span - t.degree;
+
+        for (int i = 0; i < coeffs.size(0); ++i) {
+            for (int j = 0; j < coeffs.size(1); ++j) {
+                for (int k = 0; k < coeffs.size(2); ++k) {
+                    double value = 0;
+                    for (int l = 0; l < t.dofs_per_element(); ++l) {
+                        value += sol(i, j, k, l + offset) * vals[l];
+                    }
+                    coeffs(i, j, k) = value;
+                }
+            }
+        }
+        return coeffs;
+    }
+
+    template <typename Solution>
+    void write(const Solution& sol, double s, std::ostream& os) {
+        space.write(snapshot(sol, s), os);
+    }
+
+    template <typename Solution>
+    void to_file(const Solution& sol, double s, const std::string& file_pattern, int iter) {
+        auto name = str(boost::format(file_pattern) % iter);
+        to_file(sol, s, name);
+    }
+
+    template <typename Solution>
+    void to_file(const Solution& sol, double s, const std::string& output_file) {
+        std::ofstream os{output_file};
+        write(sol, s, os);
+    }
+};
+
 }  // namespace ads
 
 #endif  // ADS_OUTPUT_MANAGER_HPP
@@ -152,6 +152,13 @@ void compute_projection(Rhs& u, const basis_data& d1, const basis_data& d2, cons
     project(u, f);
 }
 
+template <typename Rhs, typename Function>
+void compute_projection(Rhs& u, const basis_data& d1, const basis_data& d2, const basis_data& d3,
+                        const basis_data& d4, Function&& f) {
+    projector<4> project{{d1, d2, d3, d4}};
+    project(u, f);
+}
+
 }  // namespace ads
 
 #endif  // ADS_PROJECTION_HPP
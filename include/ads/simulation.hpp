@@ -9,6 +9,7 @@
 #include "ads/simulation/simulation_1d.hpp"
 #include "ads/simulation/simulation_2d.hpp"
 #include "ads/simulation/simulation_3d.hpp"
+#include "ads/simulation/simulation_4d.hpp"
 #include "ads/simulation/simulation_base.hpp"
 
 #endif  // ADS_SIMULATION_HPP
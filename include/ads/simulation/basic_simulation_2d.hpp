@@ -55,8 +55,8 @@ class basic_simulation_2d {
                           const dimension& y) const {
         auto loc = dof_global_to_local(e, a, x, y);
 
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
 
         double B1 = bx.b[e[0]][q[0]][0][loc[0]];
         double B2 = by.b[e[1]][q[1]][0][loc[1]];
@@ -74,8 +74,8 @@ class basic_simulation_2d {
                      const dimension& y) const {
         auto loc = dof_global_to_local(e, a, x, y);
 
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
 
         double B1 = bx.b[e[0]][q[0]][0][loc[0]];
         double B2 = by.b[e[1]][q[1]][0][loc[1]];
@@ -102,35 +102,35 @@ class basic_simulation_2d {
     }
 
     index_range quad_points(const dimension& x, const dimension& y) const {
-        auto rx = boost::counting_range(0, x.basis.quad_order);
-        auto ry = boost::counting_range(0, y.basis.quad_order);
+        auto rx = boost::counting_range(0, x.basis().quad_order);
+        auto ry = boost::counting_range(0, y.basis().quad_order);
         return util::product_range<index_type>(rx, ry);
     }
 
     index_range dofs_on_element(index_type e, const dimension& x, const dimension& y) const {
-        auto rx = x.basis.dof_range(e[0]);
-        auto ry = y.basis.dof_range(e[1]);
+        auto rx = x.basis().dof_range(e[0]);
+        auto ry = y.basis().dof_range(e[1]);
         return util::product_range<index_type>(rx, ry);
     }
 
     index_range elements_supporting_dof(index_type dof, const dimension& x,
                                         const dimension& y) const {
-        auto rx = x.basis.element_range(dof[0]);
-        auto ry = y.basis.element_range(dof[1]);
+        auto rx = x.basis().element_range(dof[0]);
+        auto ry = y.basis().element_range(dof[1]);
         return util::product_range<index_type>(rx, ry);
     }
 
     bool supported_in(index_type dof, index_type e, const dimension& x, const dimension& y) const {
-        auto xrange = x.basis.element_ranges[dof[0]];
-        auto yrange = y.basis.element_ranges[dof[1]];
+        auto xrange = x.basis().element_ranges[dof[0]];
+        auto yrange = y.basis().element_ranges[dof[1]];
         return e[0] >= xrange.first && e[0] <= xrange.second && e[1] >= yrange.first
             && e[1] <= yrange.second;
     }
 
     index_type dof_global_to_local(index_type e, index_type a, const dimension& x,
                                    const dimension& y) const {
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
         return {{a[0] - bx.first_dof(e[0]), a[1] - by.first_dof(e[1])}};
     }
 
@@ -156,16 +156,16 @@ class basic_simulation_2d {
     }
 
     double jacobian(index_type e, const dimension& x, const dimension& y) const {
-        return x.basis.J[e[0]] * y.basis.J[e[1]];
+        return x.basis().J[e[0]] * y.basis().J[e[1]];
     }
 
     double weight(index_type q, const dimension& x, const dimension& y) const {
-        return x.basis.w[q[0]] * y.basis.w[q[1]];
+        return x.basis().w[q[0]] * y.basis().w[q[1]];
     }
 
     point_type point(index_type e, index_type q, const dimension& x, const dimension& y) const {
-        double px = x.basis.x[e[0]][q[0]];
-        double py = y.basis.x[e[1]][q[1]];
+        double px = x.basis().x[e[0]][q[0]];
+        double py = y.basis().x[e[1]][q[1]];
         return {px, py};
     }
 
@@ -187,14 +187,14 @@ class basic_simulation_2d {
 
     index_range overlapping_dofs(index_type dof, const dimension& Ux, const dimension& Uy,
                                  const dimension& Vx, const dimension& Vy) const {
-        auto xrange = Ux.basis.element_ranges[dof[0]];
-        auto yrange = Uy.basis.element_ranges[dof[1]];
+        auto xrange = Ux.basis().element_ranges[dof[0]];
+        auto yrange = Uy.basis().element_ranges[dof[1]];
 
-        auto x0 = Vx.basis.first_dof(xrange.first);
-        auto x1 = Vx.basis.last_dof(xrange.second) + 1;
+        auto x0 = Vx.basis().first_dof(xrange.first);
+        auto x1 = Vx.basis().last_dof(xrange.second) + 1;
 
-        auto y0 = Vy.basis.first_dof(yrange.first);
-        auto y1 = Vy.basis.last_dof(yrange.second) + 1;
+        auto y0 = Vy.basis().first_dof(yrange.first);
+        auto y1 = Vy.basis().last_dof(yrange.second) + 1;
 
         auto rx = boost::counting_range(x0, x1);
         auto ry = boost::counting_range(y0, y1);
@@ -209,7 +209,8 @@ class basic_simulation_2d {
         return util::product_range<index_type>(rx, ry);
     }
 
-    int linear_index(index_type dof, const dimension& x, const dimension& y) const {
+    linear_index_type linear_index(index_type dof, const dimension& x,
+                                   const dimension& y) const {
         auto order = reverse_ordering<2>({x.dofs(), y.dofs()});
         return order.linear_index(dof[0], dof[1]);
     }
@@ -245,16 +246,15 @@ class basic_simulation_2d {
         const auto& other = horizontal ? y : x;
 
         lin::vector buf{{basis.dofs()}};
-        compute_projection(buf, basis.basis, std::forward<Fun>(fun));
-        lin::solve_with_factorized(basis.M, buf, basis.ctx);
+        compute_projection(buf, basis.basis(), std::forward<Fun>(fun));
+        auto const factors = basis.data();
+        lin::solve_with_factorized(factors.M, buf, factors.ctx);
 
         int idx = side == boundary::left || side == boundary::bottom ? 0 : other.dofs() - 1;
-        for (int i = 0; i < basis.dofs(); ++i) {
-            if (horizontal) {
-                u(i, idx) = buf(i);
-            } else {
-                u(idx, i) = buf(i);
-            }
+        if (horizontal) {
+            lin::copy(buf, u.template slice<1>(idx));
+        } else {
+            lin::copy(buf, u.template slice<0>(idx));
         }
     }
 
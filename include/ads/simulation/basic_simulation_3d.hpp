@@ -57,9 +57,9 @@ class basic_simulation_3d {
                           const dimension& y, const dimension& z) const {
         auto loc = dof_global_to_local(e, a, x, y, z);
 
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
-        const auto& bz = z.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
+        const auto& bz = z.basis();
 
         double B1 = bx.b[e[0]][q[0]][0][loc[0]];
         double B2 = by.b[e[1]][q[1]][0][loc[1]];
@@ -80,9 +80,9 @@ class basic_simulation_3d {
                      const dimension& y, const dimension& z) const {
         auto loc = dof_global_to_local(e, a, x, y, z);
 
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
-        const auto& bz = z.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
+        const auto& bz = z.basis();
 
         double B1 = bx.b[e[0]][q[0]][0][loc[0]];
         double B2 = by.b[e[1]][q[1]][0][loc[1]];
@@ -113,33 +113,33 @@ class basic_simulation_3d {
     }
 
     index_range quad_points(const dimension& x, const dimension& y, const dimension& z) const {
-        auto rx = boost::counting_range(0, x.basis.quad_order);
-        auto ry = boost::counting_range(0, y.basis.quad_order);
-        auto rz = boost::counting_range(0, z.basis.quad_order);
+        auto rx = boost::counting_range(0, x.basis().quad_order);
+        auto ry = boost::counting_range(0, y.basis().quad_order);
+        auto rz = boost::counting_range(0, z.basis().quad_order);
         return util::product_range<index_type>(rx, ry, rz);
     }
 
     index_range dofs_on_element(index_type e, const dimension& x, const dimension& y,
                                 const dimension& z) const {
-        auto rx = x.basis.dof_range(e[0]);
-        auto ry = y.basis.dof_range(e[1]);
-        auto rz = z.basis.dof_range(e[2]);
+        auto rx = x.basis().dof_range(e[0]);
+        auto ry = y.basis().dof_range(e[1]);
+        auto rz = z.basis().dof_range(e[2]);
         return util::product_range<index_type>(rx, ry, rz);
     }
 
     index_range elements_supporting_dof(index_type dof, const dimension& x, const dimension& y,
                                         const dimension& z) const {
-        auto rx = x.basis.element_range(dof[0]);
-        auto ry = y.basis.element_range(dof[1]);
-        auto rz = z.basis.element_range(dof[2]);
+        auto rx = x.basis().element_range(dof[0]);
+        auto ry = y.basis().element_range(dof[1]);
+        auto rz = z.basis().element_range(dof[2]);
         return util::product_range<index_type>(rx, ry, rz);
     }
 
     bool supported_in(index_type dof, index_type e, const dimension& x, const dimension& y,
                       const dimension& z) const {
-        auto xrange = x.basis.element_ranges[dof[0]];
-        auto yrange = y.basis.element_ranges[dof[1]];
-        auto zrange = z.basis.element_ranges[dof[2]];
+        auto xrange = x.basis().element_ranges[dof[0]];
+        auto yrange = y.basis().element_ranges[dof[1]];
+        auto zrange = z.basis().element_ranges[dof[2]];
 
         return e[0] >= xrange.first && e[0] <= xrange.second && e[1] >= yrange.first
             && e[1] <= yrange.second && e[2] >= zrange.first && e[2] <= zrange.second;
@@ -147,9 +147,9 @@ class basic_simulation_3d {
 
     index_type dof_global_to_local(index_type e, index_type a, const dimension& x,
                                    const dimension& y, const dimension& z) const {
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
-        const auto& bz = z.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
+        const auto& bz = z.basis();
         return {{a[0] - bx.first_dof(e[0]), a[1] - by.first_dof(e[1]), a[2] - bz.first_dof(e[2])}};
     }
 
@@ -178,18 +178,18 @@ class basic_simulation_3d {
 
     double jacobian(index_type e, const dimension& x, const dimension& y,
                     const dimension& z) const {
-        return x.basis.J[e[0]] * y.basis.J[e[1]] * z.basis.J[e[2]];
+        return x.basis().J[e[0]] * y.basis().J[e[1]] * z.basis().J[e[2]];
     }
 
     double weight(index_type q, const dimension& x, const dimension& y, const dimension& z) const {
-        return x.basis.w[q[0]] * y.basis.w[q[1]] * z.basis.w[q[2]];
+        return x.basis().w[q[0]] * y.basis().w[q[1]] * z.basis().w[q[2]];
     }
 
     point_type point(index_type e, index_type q, const dimension& x, const dimension& y,
                      const dimension& z) const {
-        double px = x.basis.x[e[0]][q[0]];
-        double py = y.basis.x[e[1]][q[1]];
-        double pz = z.basis.x[e[2]][q[2]];
+        double px = x.basis().x[e[0]][q[0]];
+        double py = y.basis().x[e[1]][q[1]];
+        double pz = z.basis().x[e[2]][q[2]];
         return {px, py, pz};
     }
 
@@ -214,18 +214,18 @@ class basic_simulation_3d {
     index_range overlapping_dofs(index_type dof, const dimension& Ux, const dimension& Uy,
                                  const dimension& Uz, const dimension& Vx, const dimension& Vy,
                                  const dimension& Vz) const {
-        auto xrange = Ux.basis.element_ranges[dof[0]];
-        auto yrange = Uy.basis.element_ranges[dof[1]];
-        auto zrange = Uz.basis.element_ranges[dof[2]];
+        auto xrange = Ux.basis().element_ranges[dof[0]];
+        auto yrange = Uy.basis().element_ranges[dof[1]];
+        auto zrange = Uz.basis().element_ranges[dof[2]];
 
-        auto x0 = Vx.basis.first_dof(xrange.first);
-        auto x1 = Vx.basis.last_dof(xrange.second) + 1;
+        auto x0 = Vx.basis().first_dof(xrange.first);
+        auto x1 = Vx.basis().last_dof(xrange.second) + 1;
 
-        auto y0 = Vy.basis.first_dof(yrange.first);
-        auto y1 = Vy.basis.last_dof(yrange.second) + 1;
+        auto y0 = Vy.basis().first_dof(yrange.first);
+        auto y1 = Vy.basis().last_dof(yrange.second) + 1;
 
-        auto z0 = Vz.basis.first_dof(zrange.first);
-        auto z1 = Vz.basis.last_dof(zrange.second) + 1;
+        auto z0 = Vz.basis().first_dof(zrange.first);
+        auto z1 = Vz.basis().last_dof(zrange.second) + 1;
 
         auto rx = boost::counting_range(x0, x1);
         auto ry = boost::counting_range(y0, y1);
@@ -242,8 +242,8 @@ class basic_simulation_3d {
         return util::product_range<index_type>(rx, ry, rz);
     }
 
-    int linear_index(index_type dof, const dimension& x, const dimension& y,
-                     const dimension& z) const {
+    linear_index_type linear_index(index_type dof, const dimension& x, const dimension& y,
+                                   const dimension& z) const {
         auto order = reverse_ordering<3>({x.dofs(), y.dofs(), z.dofs()});
         return order.linear_index(dof[0], dof[1], dof[2]);
     }
@@ -0,0 +1,241 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_SIMULATION_BASIC_SIMULATION_4D_HPP
+#define ADS_SIMULATION_BASIC_SIMULATION_4D_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include <boost/range/counting_range.hpp>
+
+#include "ads/lin/tensor.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/util/function_value.hpp"
+#include "ads/util/iter/product.hpp"
+
+namespace ads {
+
+// Counterpart of basic_simulation_3d for space-time formulations, with time as the fourth
+// dimension (t). Derivative with respect to it is stored in function_value_4d::dt.
+class basic_simulation_4d {
+public:
+    virtual ~basic_simulation_4d() = default;
+
+    basic_simulation_4d() = default;
+    basic_simulation_4d(const basic_simulation_4d&) = delete;
+    basic_simulation_4d& operator=(const basic_simulation_4d&) = delete;
+    basic_simulation_4d(basic_simulation_4d&&) = delete;
+    basic_simulation_4d& operator=(basic_simulation_4d&&) = delete;
+
+protected:
+    using vector_type = lin::tensor<double, 4>;
+    using vector_view = lin::tensor_view<double, 4>;
+    using value_type = function_value_4d;
+
+    using index_type = std::array<int, 4>;
+    using index_1d_iter_type = boost::counting_iterator<int>;
+    using index_iter_type = util::iter_product4<index_1d_iter_type, index_type>;
+    using index_range = boost::iterator_range<index_iter_type>;
+
+    using point_type = std::array<double, 4>;
+
+    struct L2 {
+        double operator()(value_type a) const { return a.val * a.val; }
+    };
+
+    // Spatial gradient only
+    struct H10 {
+        double operator()(value_type a) const { return a.dx * a.dx + a.dy * a.dy + a.dz * a.dz; }
+    };
+
+    struct H1 {
+        double operator()(value_type a) const {
+            return a.val * a.val + a.dx * a.dx + a.dy * a.dy + a.dz * a.dz;
+        }
+    };
+
+    value_type eval_basis(index_type e, index_type q, index_type a, const dimension& x,
+                          const dimension& y, const dimension& z, const dimension& t) const {
+        auto loc = dof_global_to_local(e, a, x, y, z, t);
+
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
+        const auto& bz = z.basis();
+        const auto& bt = t.basis();
+
+        double B1 = bx.b[e[0]][q[0]][0][loc[0]];
+        double B2 = by.b[e[1]][q[1]][0][loc[1]];
+        double B3 = bz.b[e[2]][q[2]][0][loc[2]];
+        double B4 = bt.b[e[3]][q[3]][0][loc[3]];
+        double dB1 = bx.b[e[0]][q[0]][1][loc[0]];
+        double dB2 = by.b[e[1]][q[1]][1][loc[1]];
+        double dB3 = bz.b[e[2]][q[2]][1][loc[2]];
+        double dB4 = bt.b[e[3]][q[3]][1][loc[3]];
+
+        double v = B1 * B2 * B3 * B4;
+        double dxv = dB1 * B2 * B3 * B4;
+        double dyv = B1 * dB2 * B3 * B4;
+        double dzv = B1 * B2 * dB3 * B4;
+        double dtv = B1 * B2 * B3 * dB4;
+
+        return {v, dxv, dyv, dzv, dtv};
+    }
+
+    template <typename Sol>
+    value_type eval(const Sol& v, index_type e, index_type q, const dimension& x,
+                    const dimension& y, const dimension& z, const dimension& t) const {
+        value_type u{};
+        for (auto b : dofs_on_element(e, x, y, z, t)) {
+            double c = v(b[0], b[1], b[2], b[3]);
+            value_type B = eval_basis(e, q, b, x, y, z, t);
+            u += c * B;
+        }
+        return u;
+    }
+
+    index_range elements(const dimension& x, const dimension& y, const dimension& z,
+                         const dimension& t) const {
+        return util::product_range<index_type>(x.element_indices(), y.element_indices(),
+                                               z.element_indices(), t.element_indices());
+    }
+
+    index_range quad_points(const dimension& x, const dimension& y, const dimension& z,
+                            const dimension& t) const {
+        auto rx = boost::counting_range(0, x.basis().quad_order);
+        auto ry = boost::counting_range(0, y.basis().quad_order);
+        auto rz = boost::counting_range(0, z.basis().quad_order);
+        auto rt = boost::counting_range(0, t.basis().quad_order);
+        return util::product_range<index_type>(rx, ry, rz, rt);
+    }
+
+    index_range dofs_on_element(index_type e, const dimension& x, const dimension& y,
+                                const dimension& z, const dimension& t) const {
+        auto rx = x.basis().dof_range(e[0]);
+        auto ry = y.basis().dof_range(e[1]);
+        auto rz = z.basis().dof_range(e[2]);
+        auto rt = t.basis().dof_range(e[3]);
+        return util::product_range<index_type>(rx, ry, rz, rt);
+    }
+
+    index_range elements_supporting_dof(index_type dof, const dimension& x, const dimension& y,
+                                        const dimension& z, const dimension& t) const {
+        auto rx = x.basis().element_range(dof[0]);
+        auto ry = y.basis().element_range(dof[1]);
+        auto rz = z.basis().element_range(dof[2]);
+        auto rt = t.basis().element_range(dof[3]);
+        return util::product_range<index_type>(rx, ry, rz, rt);
+    }
+
+    index_type dof_global_to_local(index_type e, index_type a, const dimension& x,
+                                   const dimension& y, const dimension& z,
+                                   const dimension& t) const {
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
+        const auto& bz = z.basis();
+        const auto& bt = t.basis();
+        return {{a[0] - bx.first_dof(e[0]), a[1] - by.first_dof(e[1]), a[2] - bz.first_dof(e[2]),
+                 a[3] - bt.first_dof(e[3])}};
+    }
+
+    template <typename RHS>
+    void update_global_rhs(RHS& global, const vector_type& local, index_type e, const dimension& x,
+                           const dimension& y, const dimension& z, const dimension& t) const {
+        for (auto a : dofs_on_element(e, x, y, z, t)) {
+            auto loc = dof_global_to_local(e, a, x, y, z, t);
+            global(a[0], a[1], a[2], a[3]) += local(loc[0], loc[1], loc[2], loc[3]);
+        }
+    }
+
+    index_range dofs(const dimension& x, const dimension& y, const dimension& z,
+                     const dimension& t) const {
+        auto rx = boost::counting_range(0, x.dofs());
+        auto ry = boost::counting_range(0, y.dofs());
+        auto rz = boost::counting_range(0, z.dofs());
+        auto rt = boost::counting_range(0, t.dofs());
+        return util::product_range<index_type>(rx, ry, rz, rt);
+    }
+
+    double jacobian(index_type e, const dimension& x, const dimension& y, const dimension& z,
+                    const dimension& t) const {
+        return x.basis().J[e[0]] * y.basis().J[e[1]] * z.basis().J[e[2]] * t.basis().J[e[3]];
+    }
+
+    double weight(index_type q, const dimension& x, const dimension& y, const dimension& z,
+                  const dimension& t) const {
+        return x.basis().w[q[0]] * y.basis().w[q[1]] * z.basis().w[q[2]] * t.basis().w[q[3]];
+    }
+
+    point_type point(index_type e, index_type q, const dimension& x, const dimension& y,
+                     const dimension& z, const dimension& t) const {
+        double px = x.basis().x[e[0]][q[0]];
+        double py = y.basis().x[e[1]][q[1]];
+        double pz = z.basis().x[e[2]][q[2]];
+        double pt = t.basis().x[e[3]][q[3]];
+        return {px, py, pz, pt};
+    }
+
+    linear_index_type linear_index(index_type dof, const dimension& x, const dimension& y,
+                                   const dimension& z, const dimension& t) const {
+        auto order = reverse_ordering<4>({x.dofs(), y.dofs(), z.dofs(), t.dofs()});
+        return order.linear_index(dof[0], dof[1], dof[2], dof[3]);
+    }
+
+    template <typename Sol, typename Norm>
+    double norm(const Sol& u, const dimension& Ux, const dimension& Uy, const dimension& Uz,
+                const dimension& Ut, Norm&& norm) const {
+        double val = 0;
+
+        for (auto e : elements(Ux, Uy, Uz, Ut)) {
+            double J = jacobian(e, Ux, Uy, Uz, Ut);
+            for (auto q : quad_points(Ux, Uy, Uz, Ut)) {
+                double w = weight(q, Ux, Uy, Uz, Ut);
+                value_type uu = eval(u, e, q, Ux, Uy, Uz, Ut);
+                val += norm(uu) * w * J;
+            }
+        }
+        return std::sqrt(val);
+    }
+
+    template <typename Sol>
+    double normL2(const Sol& u, const dimension& Ux, const dimension& Uy, const dimension& Uz,
+                  const dimension& Ut) const {
+        return norm(u, Ux, Uy, Uz, Ut, L2{});
+    }
+
+    template <typename Sol, typename Fun, typename Norm>
+    double error(const Sol& u, const dimension& Ux, const dimension& Uy, const dimension& Uz,
+                 const dimension& Ut, Norm&& norm, Fun&& fun) const {
+        double error = 0;
+
+        for (auto e : elements(Ux, Uy, Uz, Ut)) {
+            double J = jacobian(e, Ux, Uy, Uz, Ut);
+            for (auto q : quad_points(Ux, Uy, Uz, Ut)) {
+                double w = weight(q, Ux, Uy, Uz, Ut);
+                auto x = point(e, q, Ux, Uy, Uz, Ut);
+                value_type uu = eval(u, e, q, Ux, Uy, Uz, Ut);
+
+                auto d = uu - fun(x);
+                error += norm(d) * w * J;
+            }
+        }
+        return std::sqrt(error);
+    }
+
+    template <typename Sol, typename Fun>
+    double errorL2(const Sol& u, const dimension& Ux, const dimension& Uy, const dimension& Uz,
+                   const dimension& Ut, Fun&& fun) const {
+        return error(u, Ux, Uy, Uz, Ut, L2{}, fun);
+    }
+
+    template <typename Sol, typename Fun>
+    double errorH1(const Sol& u, const dimension& Ux, const dimension& Uy, const dimension& Uz,
+                   const dimension& Ut, Fun&& fun) const {
+        return error(u, Ux, Uy, Uz, Ut, H1{}, fun);
+    }
+};
+
+}  // namespace ads
+
+#endif  // ADS_SIMULATION_BASIC_SIMULATION_4D_HPP
@@ -55,6 +55,13 @@ struct config_3d {
     int derivatives;
 };
 
+// Three spatial dimensions and time as the fourth dimension of space-time formulations
+struct config_4d {
+    dim_config x, y, z, t;
+    timesteps_config steps;
+    int derivatives;
+};
+
 }  // namespace ads
 
 #endif  // ADS_SIMULATION_CONFIG_HPP
@@ -4,20 +4,39 @@
 #ifndef ADS_SIMULATION_DIMENSION_HPP
 #define ADS_SIMULATION_DIMENSION_HPP
 
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
 #include <boost/range/counting_range.hpp>
 
 #include "ads/basis_data.hpp"
 #include "ads/bspline/bspline.hpp"
 #include "ads/form_matrix.hpp"
 #include "ads/lin/band_matrix.hpp"
+#include "ads/lin/band_row_update.hpp"
 #include "ads/lin/band_solve.hpp"
 #include "ads/simulation/config.hpp"
+#include "ads/simulation/factorization_cache.hpp"
 #include "ads/solver.hpp"
 #include "ads/util.hpp"
 
 namespace ads {
 
+// Basis data, the mass matrix and its factorization are shared with other dimensions with the same
+// basis through the global factorization cache. Fixing dofs does not change the matrix - their rows
+// are replaced by a low-rank update of the shared factorization (see lin::band_row_update), so no
+// dimension needs to copy or factorize the matrix itself.
 class dimension {
+private:
+    std::shared_ptr<const basis_data> basis_data_;
+    std::shared_ptr<const lin::band_matrix> mass_matrix_;
+    std::shared_ptr<const factorized_matrix> factors_;
+    std::vector<int> fixed_;
+    std::optional<lin::band_row_update> update_;  // replaces rows of fixed dofs
+
 public:
     using element_range_type = decltype(boost::counting_range(0, 0));
 
@@ -26,9 +45,6 @@ class dimension {
     double a;
     double b;
     bspline::basis B;
-    lin::band_matrix M;
-    basis_data basis;
-    lin::solver_ctx ctx;
 
     dimension(bspline::basis basis, int quad_order, int derivatives, int elem_division = 1);
 
@@ -36,10 +52,35 @@ class dimension {
 
     int dofs() const { return B.dofs(); }
 
+    const basis_data& basis() const { return *basis_data_; }
+
+    // Mass matrix with no dofs fixed, shared with other dimensions
+    const lin::band_matrix& mass_matrix() const { return *mass_matrix_; }
+
     element_range_type element_indices() const { return boost::counting_range(0, elements); }
 
-    dim_data data() { return {M, ctx}; }
+    // Factorized matrix with rows of the fixed dofs replaced, requires factorize_matrix to have
+    // been called
+    updated_dim_data data() const {
+        assert(update_ && "Matrix of the dimension is not factorized");
+        return {*update_, factors_->ctx};
+    }
+
+    // Factorized matrix with rows replaced by the update, see row_update
+    updated_dim_data data(const lin::band_row_update& update) const {
+        return {update, data().ctx};
+    }
+
+    // Copy of the update replacing rows of the fixed dofs, which allows replacing other rows
+    // without modifying the dimension. Requires factorize_matrix to have been called.
+    lin::band_row_update row_update() const {
+        if (!update_) {
+            throw std::logic_error{"Row update requires the matrix to be factorized"};
+        }
+        return *update_;
+    }
 
+    // Replaces the row of the matrix by a row of identity, the matrix need not be factorized again
     void fix_dof(int k);
 
     void fix_left() { fix_dof(0); }
@@ -49,7 +90,9 @@ class dimension {
         fix_dof(last);
     }
 
-    void factorize_matrix() { lin::factorize(M, ctx); }
+    // Uses the factorization of the mass matrix shared through the cache, and replaces rows of the
+    // dofs fixed so far
+    void factorize_matrix();
 
 private:
     static bspline::basis bspline_basis(const dim_config& config) {
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_SIMULATION_FACTORIZATION_CACHE_HPP
+#define ADS_SIMULATION_FACTORIZATION_CACHE_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include "ads/basis_data.hpp"
+#include "ads/bspline/bspline.hpp"
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/solver_ctx.hpp"
+
+namespace ads {
+
+enum class matrix_kind { mass, stiffness };
+
+struct factorized_matrix {
+    lin::band_matrix M;
+    lin::solver_ctx ctx;
+};
+
+/**
+ * @brief Process-wide cache of 1D basis data and matrices.
+ *
+ * Dimensions using the same B-spline basis and quadrature (in most examples x, y and z are
+ * identical) share a single, immutable @c basis_data object, and the 1D matrices built from it are
+ * assembled and factorized only once. Matrices are stored in the layout expected by the LU
+ * factorization.
+ *
+ * Basis data is identified by the knot vector, degree, quadrature order, number of derivatives and
+ * element subdivision, matrices by the same attributes (except for derivatives) and matrix kind.
+ * Cached objects are kept alive until @c clear is called. All the member functions are
+ * thread-safe.
+ */
+class factorization_cache {
+private:
+    struct basis_key {
+        bspline::knot_vector knot;
+        int degree;
+        int quad_order;
+        int derivatives;
+        int elem_division;
+
+        friend bool operator<(const basis_key& a, const basis_key& b) {
+            return std::tie(a.degree, a.quad_order, a.derivatives, a.elem_division, a.knot)
+                 < std::tie(b.degree, b.quad_order, b.derivatives, b.elem_division, b.knot);
+        }
+    };
+
+    struct matrix_key {
+        bspline::knot_vector knot;
+        int degree;
+        int quad_order;
+        int elem_division;
+        matrix_kind kind;
+
+        friend bool operator<(const matrix_key& a, const matrix_key& b) {
+            return std::tie(a.kind, a.degree, a.quad_order, a.elem_division, a.knot)
+                 < std::tie(b.kind, b.degree, b.quad_order, b.elem_division, b.knot);
+        }
+    };
+
+    mutable std::mutex mutex_;
+    std::map<basis_key, std::shared_ptr<const basis_data>> bases_;
+    std::map<matrix_key, std::shared_ptr<const lin::band_matrix>> matrices_;
+    std::map<matrix_key, std::shared_ptr<const factorized_matrix>> factorizations_;
+    int hits_ = 0;
+    int misses_ = 0;
+
+public:
+    // Cache shared by all the dimensions
+    static factorization_cache& global();
+
+    std::shared_ptr<const basis_data> basis(const bspline::basis& B, int derivatives,
+                                            int quad_order, int elem_division = 1);
+
+    // Assembled (not factorized) matrix of given kind, stiffness requires derivatives
+    std::shared_ptr<const lin::band_matrix> matrix(const basis_data& basis, matrix_kind kind);
+
+    std::shared_ptr<const factorized_matrix> factorized(const basis_data& basis, matrix_kind kind);
+
+    void clear();
+
+    // Number of lookups that found an existing object
+    int hits() const;
+
+    // Number of lookups that created a new object
+    int misses() const;
+
+private:
+    static matrix_key key_of(const basis_data& basis, matrix_kind kind);
+
+    std::shared_ptr<const lin::band_matrix> matrix_unlocked(const basis_data& basis,
+                                                            matrix_kind kind);
+};
+
+}  // namespace ads
+
+#endif  // ADS_SIMULATION_FACTORIZATION_CACHE_HPP
@@ -33,33 +33,33 @@ class simulation_1d : public simulation_base {
 
     template <typename Function>
     void projection(vector_type& v, Function f) {
-        compute_projection(v, x.basis, f);
+        compute_projection(v, x.basis(), f);
     }
 
     double grad_dot(value_type a, value_type b) const { return a.dx * b.dx; }
 
     std::array<int, 1> shape() const { return {x.dofs()}; }
 
-    std::array<int, 1> local_shape() const { return {x.basis.dofs_per_element()}; }
+    std::array<int, 1> local_shape() const { return {x.basis().dofs_per_element()}; }
 
     void prepare_matrices() { x.factorize_matrix(); }
 
     index_range elements() const { return x.element_indices(); }
 
-    index_range quad_points() const { return boost::counting_range(0, x.basis.quad_order); }
+    index_range quad_points() const { return boost::counting_range(0, x.basis().quad_order); }
 
-    index_range dofs_on_element(index_type e) const { return x.basis.dof_range(e); }
+    index_range dofs_on_element(index_type e) const { return x.basis().dof_range(e); }
 
-    double jacobian(index_type e) const { return x.basis.J[e]; }
+    double jacobian(index_type e) const { return x.basis().J[e]; }
 
-    double weight(index_type q) const { return x.basis.w[q]; }
+    double weight(index_type q) const { return x.basis().w[q]; }
 
-    point_type point(index_type e, index_type q) const { return x.basis.x[e][q]; }
+    point_type point(index_type e, index_type q) const { return x.basis().x[e][q]; }
 
     value_type eval_basis(index_type e, index_type q, index_type a) const {
         auto loc = dof_global_to_local(e, a);
 
-        const auto& bx = x.basis;
+        const auto& bx = x.basis();
 
         double v = bx.b[e][q][0][loc];
         double dv = bx.b[e][q][1][loc];
@@ -68,8 +68,8 @@ class simulation_1d : public simulation_base {
     }
 
     value_type eval_fun(const vector_type& v, index_type e, index_type q) const {
-        int first = x.basis.first_dof(e);
-        int last = x.basis.last_dof(e);
+        int first = x.basis().first_dof(e);
+        int last = x.basis().last_dof(e);
 
         value_type u{};
         for (int b1 = first; b1 <= last; ++b1) {
@@ -81,7 +81,7 @@ class simulation_1d : public simulation_base {
     }
 
     index_type dof_global_to_local(index_type e, index_type a) const {
-        return a - x.basis.first_dof(e);
+        return a - x.basis().first_dof(e);
     }
 
     vector_type element_rhs() const { return vector_type{local_shape()}; }
@@ -36,13 +36,21 @@ class simulation_2d : public basic_simulation_2d, public simulation_base {
     using basic_simulation_2d::weight;
 
     dimension x, y;
-    vector_type buffer;
 
-    void solve(vector_type& rhs) { ads_solve(rhs, buffer, x.data(), y.data()); }
+    // Solves are transpose-free and need no buffer of the size of the right-hand side
+
+    void solve(vector_type& rhs) { ads_solve(rhs, x.data(), y.data()); }
+
+    template <typename Executor>
+    void solve(vector_type& rhs, const Executor& executor) {
+        ads_solve(parallel_sweep{executor}, rhs, x.data(), y.data());
+    }
+
+    void solve(vector_type& rhs, strided_sweep sweep) { ads_solve(sweep, rhs, x.data(), y.data()); }
 
     template <typename Function>
     void projection(vector_type& v, Function f) {
-        compute_projection(v, x.basis, y.basis, f);
+        compute_projection(v, x.basis(), y.basis(), f);
     }
 
     double grad_dot(value_type a, value_type b) const { return a.dx * b.dx + a.dy * b.dy; }
@@ -50,7 +58,7 @@ class simulation_2d : public basic_simulation_2d, public simulation_base {
     std::array<int, 2> shape() const { return {x.dofs(), y.dofs()}; }
 
     std::array<int, 2> local_shape() const {
-        return {x.basis.dofs_per_element(), y.basis.dofs_per_element()};
+        return {x.basis().dofs_per_element(), y.basis().dofs_per_element()};
     }
 
     void prepare_matrices() {
@@ -63,44 +71,44 @@ class simulation_2d : public basic_simulation_2d, public simulation_base {
     }
 
     index_range dofs() const {
-        auto rx = boost::counting_range(0, x.basis.dofs);
-        auto ry = boost::counting_range(0, y.basis.dofs);
+        auto rx = boost::counting_range(0, x.basis().dofs);
+        auto ry = boost::counting_range(0, y.basis().dofs);
         return util::product_range<index_type>(rx, ry);
     }
 
     index_range quad_points() const {
-        auto rx = boost::counting_range(0, x.basis.quad_order);
-        auto ry = boost::counting_range(0, y.basis.quad_order);
+        auto rx = boost::counting_range(0, x.basis().quad_order);
+        auto ry = boost::counting_range(0, y.basis().quad_order);
         return util::product_range<index_type>(rx, ry);
     }
 
     index_range dofs_on_element(index_type e) const {
-        auto rx = x.basis.dof_range(e[0]);
-        auto ry = y.basis.dof_range(e[1]);
+        auto rx = x.basis().dof_range(e[0]);
+        auto ry = y.basis().dof_range(e[1]);
         return util::product_range<index_type>(rx, ry);
     }
 
     index_range elements_supporting_dof(index_type dof) const {
-        auto rx = x.basis.element_range(dof[0]);
-        auto ry = y.basis.element_range(dof[1]);
+        auto rx = x.basis().element_range(dof[0]);
+        auto ry = y.basis().element_range(dof[1]);
         return util::product_range<index_type>(rx, ry);
     }
 
-    double jacobian(index_type e) const { return x.basis.J[e[0]] * y.basis.J[e[1]]; }
+    double jacobian(index_type e) const { return x.basis().J[e[0]] * y.basis().J[e[1]]; }
 
-    double weight(index_type q) const { return x.basis.w[q[0]] * y.basis.w[q[1]]; }
+    double weight(index_type q) const { return x.basis().w[q[0]] * y.basis().w[q[1]]; }
 
     point_type point(index_type e, index_type q) const {
-        double px = x.basis.x[e[0]][q[0]];
-        double py = y.basis.x[e[1]][q[1]];
+        double px = x.basis().x[e[0]][q[0]];
+        double py = y.basis().x[e[1]][q[1]];
         return {px, py};
     }
 
     value_type eval_basis(index_type e, index_type q, index_type a) const {
         auto loc = dof_global_to_local(e, a);
 
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
 
         double B1 = bx.b[e[0]][q[0]][0][loc[0]];
         double B2 = by.b[e[1]][q[1]][0][loc[1]];
@@ -125,8 +133,8 @@ class simulation_2d : public basic_simulation_2d, public simulation_base {
     }
 
     index_type dof_global_to_local(index_type e, index_type a) const {
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
         return {{a[0] - bx.first_dof(e[0]), a[1] - by.first_dof(e[1])}};
     }
 
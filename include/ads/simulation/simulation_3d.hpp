@@ -14,6 +14,8 @@
 #include "ads/simulation/dimension.hpp"
 #include "ads/simulation/simulation_base.hpp"
 #include "ads/solver.hpp"
+#include "ads/solver/mixed_precision.hpp"
+#include "ads/solver/pipelined.hpp"
 #include "ads/util/function_value.hpp"
 #include "ads/util/iter/product.hpp"
 #include "basic_simulation_3d.hpp"
@@ -36,13 +38,36 @@ class simulation_3d : public basic_simulation_3d, public simulation_base {
     using basic_simulation_3d::weight;
 
     dimension x, y, z;
-    vector_type buffer;
 
-    void solve(vector_type& rhs) { ads_solve(rhs, buffer, x.data(), y.data(), z.data()); }
+    // Solves are transpose-free and need no buffer of the size of the right-hand side
+
+    void solve(vector_type& rhs) { ads_solve(rhs, x.data(), y.data(), z.data()); }
+
+    template <typename Executor>
+    void solve(vector_type& rhs, const Executor& executor) {
+        ads_solve(parallel_sweep{executor}, rhs, x.data(), y.data(), z.data());
+    }
+
+    void solve(vector_type& rhs, strided_sweep sweep) {
+        ads_solve(sweep, rhs, x.data(), y.data(), z.data());
+    }
+
+    // Single precision solve with iterative refinement, solver needs to be created from x, y and z
+    // after they are factorized. Returns the number of refinement steps and whether they converged.
+    refinement_status solve(vector_type& rhs, mixed_precision_ads<3>& solver) {
+        return solver.solve(rhs);
+    }
+
+    // Solve with direction sweeps and transpositions overlapped, timings are kept by the solver.
+    // Unlike the other solves, it needs two buffers of the size of rhs, kept by the solver.
+    template <typename Executor>
+    void solve(vector_type& rhs, pipelined_ads<Executor>& solver) {
+        solver.solve(rhs, x.data(), y.data(), z.data());
+    }
 
     template <typename Function>
     void projection(vector_type& v, Function f) {
-        compute_projection(v, x.basis, y.basis, z.basis, f);
+        compute_projection(v, x.basis(), y.basis(), z.basis(), f);
     }
 
     double grad_dot(value_type a, value_type b) const {
@@ -52,7 +77,8 @@ class simulation_3d : public basic_simulation_3d, public simulation_base {
     std::array<int, 3> shape() const { return {x.dofs(), y.dofs(), z.dofs()}; }
 
     std::array<int, 3> local_shape() const {
-        return {x.basis.dofs_per_element(), y.basis.dofs_per_element(), z.basis.dofs_per_element()};
+        return {x.basis().dofs_per_element(), y.basis().dofs_per_element(),
+                z.basis().dofs_per_element()};
     }
 
     void prepare_matrices() {
@@ -67,40 +93,40 @@ class simulation_3d : public basic_simulation_3d, public simulation_base {
     }
 
     index_range quad_points() const {
-        auto rx = boost::counting_range(0, x.basis.quad_order);
-        auto ry = boost::counting_range(0, y.basis.quad_order);
-        auto rz = boost::counting_range(0, z.basis.quad_order);
+        auto rx = boost::counting_range(0, x.basis().quad_order);
+        auto ry = boost::counting_range(0, y.basis().quad_order);
+        auto rz = boost::counting_range(0, z.basis().quad_order);
         return util::product_range<index_type>(rx, ry, rz);
     }
 
     index_range dofs_on_element(index_type e) const {
-        auto rx = x.basis.dof_range(e[0]);
-        auto ry = y.basis.dof_range(e[1]);
-        auto rz = z.basis.dof_range(e[2]);
+        auto rx = x.basis().dof_range(e[0]);
+        auto ry = y.basis().dof_range(e[1]);
+        auto rz = z.basis().dof_range(e[2]);
         return util::product_range<index_type>(rx, ry, rz);
     }
 
     double jacobian(index_type e) const {
-        return x.basis.J[e[0]] * y.basis.J[e[1]] * z.basis.J[e[2]];
+        return x.basis().J[e[0]] * y.basis().J[e[1]] * z.basis().J[e[2]];
     }
 
     double weight(index_type q) const {
-        return x.basis.w[q[0]] * y.basis.w[q[1]] * z.basis.w[q[2]];
+        return x.basis().w[q[0]] * y.basis().w[q[1]] * z.basis().w[q[2]];
     }
 
     point_type point(index_type e, index_type q) const {
-        double px = x.basis.x[e[0]][q[0]];
-        double py = y.basis.x[e[1]][q[1]];
-        double pz = z.basis.x[e[2]][q[2]];
+        double px = x.basis().x[e[0]][q[0]];
+        double py = y.basis().x[e[1]][q[1]];
+        double pz = z.basis().x[e[2]][q[2]];
         return {px, py, pz};
     }
 
     value_type eval_basis(index_type e, index_type q, index_type a) const {
         auto loc = dof_global_to_local(e, a);
 
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
-        const auto& bz = z.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
+        const auto& bz = z.basis();
 
         double B1 = bx.b[e[0]][q[0]][0][loc[0]];
         double B2 = by.b[e[1]][q[1]][0][loc[1]];
@@ -128,9 +154,9 @@ class simulation_3d : public basic_simulation_3d, public simulation_base {
     }
 
     index_type dof_global_to_local(index_type e, index_type a) const {
-        const auto& bx = x.basis;
-        const auto& by = y.basis;
-        const auto& bz = z.basis;
+        const auto& bx = x.basis();
+        const auto& by = y.basis();
+        const auto& bz = z.basis();
 
         return {{a[0] - bx.first_dof(e[0]), a[1] - by.first_dof(e[1]), a[2] - bz.first_dof(e[2])}};
     }
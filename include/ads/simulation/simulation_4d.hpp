@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_SIMULATION_SIMULATION_4D_HPP
+#define ADS_SIMULATION_SIMULATION_4D_HPP
+
+#include <array>
+#include <cstddef>
+
+#include <boost/range/counting_range.hpp>
+
+#include "ads/lin/tensor.hpp"
+#include "ads/projection.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/simulation/simulation_base.hpp"
+#include "ads/solver.hpp"
+#include "ads/util/function_value.hpp"
+#include "ads/util/iter/product.hpp"
+#include "basic_simulation_4d.hpp"
+
+namespace ads {
+
+/**
+ * @brief Base class of space-time simulations, with time as the fourth dimension.
+ *
+ * The whole space-time domain (or a time slab, with steps moving between consecutive slabs) is
+ * discretized at once, so that all the time instants are coupled in one Kronecker system instead
+ * of being solved one after another.
+ */
+class simulation_4d : public basic_simulation_4d, public simulation_base {
+public:
+    using basic_simulation_4d::dof_global_to_local;
+    using basic_simulation_4d::dofs;
+    using basic_simulation_4d::dofs_on_element;
+    using basic_simulation_4d::elements;
+    using basic_simulation_4d::elements_supporting_dof;
+    using basic_simulation_4d::eval;
+    using basic_simulation_4d::eval_basis;
+    using basic_simulation_4d::jacobian;
+    using basic_simulation_4d::point;
+    using basic_simulation_4d::quad_points;
+    using basic_simulation_4d::update_global_rhs;
+    using basic_simulation_4d::weight;
+
+    dimension x, y, z, t;
+
+    // Solves are transpose-free and need no buffer of the size of the right-hand side
+
+    void solve(vector_type& rhs) { ads_solve(rhs, x.data(), y.data(), z.data(), t.data()); }
+
+    template <typename Executor>
+    void solve(vector_type& rhs, const Executor& executor) {
+        ads_solve(parallel_sweep{executor}, rhs, x.data(), y.data(), z.data(), t.data());
+    }
+
+    void solve(vector_type& rhs, strided_sweep sweep) {
+        ads_solve(sweep, rhs, x.data(), y.data(), z.data(), t.data());
+    }
+
+    template <typename Function>
+    void projection(vector_type& v, Function f) {
+        compute_projection(v, x.basis(), y.basis(), z.basis(), t.basis(), f);
+    }
+
+    // Spatial part of the gradient
+    double grad_dot(value_type a, value_type b) const {
+        return a.dx * b.dx + a.dy * b.dy + a.dz * b.dz;
+    }
+
+    std::array<int, 4> shape() const { return {x.dofs(), y.dofs(), z.dofs(), t.dofs()}; }
+
+    std::array<int, 4> local_shape() const {
+        return {x.basis().dofs_per_element(), y.basis().dofs_per_element(),
+                z.basis().dofs_per_element(), t.basis().dofs_per_element()};
+    }
+
+    void prepare_matrices() {
+        x.factorize_matrix();
+        y.factorize_matrix();
+        z.factorize_matrix();
+        t.factorize_matrix();
+    }
+
+    index_range elements() const {
+        return util::product_range<index_type>(x.element_indices(), y.element_indices(),
+                                               z.element_indices(), t.element_indices());
+    }
+
+    index_range quad_points() const {
+        auto rx = boost::counting_range(0, x.basis().quad_order);
+        auto ry = boost::counting_range(0, y.basis().quad_order);
+        auto rz = boost::counting_range(0, z.basis().quad_order);
+        auto rt = boost::counting_range(0, t.basis().quad_order);
+        return util::product_range<index_type>(rx, ry, rz, rt);
+    }
+
+    index_range dofs_on_element(index_type e) const {
+        auto rx = x.basis().dof_range(e[0]);
+        auto ry = y.basis().dof_range(e[1]);
+        auto rz = z.basis().dof_range(e[2]);
+        auto rt = t.basis().dof_range(e[3]);
+        return util::product_range<index_type>(rx, ry, rz, rt);
+    }
+
+    double jacobian(index_type e) const {
+        return x.basis().J[e[0]] * y.basis().J[e[1]] * z.basis().J[e[2]] * t.basis().J[e[3]];
+    }
+
+    double weight(index_type q) const {
+        return x.basis().w[q[0]] * y.basis().w[q[1]] * z.basis().w[q[2]] * t.basis().w[q[3]];
+    }
+
+    point_type point(index_type e, index_type q) const {
+        double px = x.basis().x[e[0]][q[0]];
+        double py = y.basis().x[e[1]][q[1]];
+        double pz = z.basis().x[e[2]][q[2]];
+        double pt = t.basis().x[e[3]][q[3]];
+        return {px, py, pz, pt};
+    }
+
+    value_type eval_basis(index_type e, index_type q, index_type a) const {
+        return basic_simulation_4d::eval_basis(e, q, a, x, y, z, t);
+    }
+
+    value_type eval_fun(const vector_type& v, index_type e, index_type q) const {
+        value_type u{};
+        for (auto b : dofs_on_element(e)) {
+            double c = v(b[0], b[1], b[2], b[3]);
+            value_type B = eval_basis(e, q, b);
+            u += c * B;
+        }
+        return u;
+    }
+
+    index_type dof_global_to_local(index_type e, index_type a) const {
+        return basic_simulation_4d::dof_global_to_local(e, a, x, y, z, t);
+    }
+
+    vector_type element_rhs() const { return vector_type{local_shape()}; }
+
+    void update_global_rhs(vector_type& global, const vector_type& local, index_type e) const {
+        for (auto a : dofs_on_element(e)) {
+            auto loc = dof_global_to_local(e, a);
+            global(a[0], a[1], a[2], a[3]) += local(loc[0], loc[1], loc[2], loc[3]);
+        }
+    }
+
+    explicit simulation_4d(const config_4d& config);
+
+    simulation_4d(const dimension& x, const dimension& y, const dimension& z, const dimension& t,
+                  const timesteps_config& steps);
+};
+
+}  // namespace ads
+
+#endif  // ADS_SIMULATION_SIMULATION_4D_HPP
@@ -9,11 +9,11 @@
 namespace ads {
 
 inline double min_element_size(const dimension& U) {
-    return 2 * *std::min_element(U.basis.J, U.basis.J + U.elements);
+    return 2 * *std::min_element(U.basis().J.begin(), U.basis().J.end());
 }
 
 inline double max_element_size(const dimension& U) {
-    return 2 * *std::max_element(U.basis.J, U.basis.J + U.elements);
+    return 2 * *std::max_element(U.basis().J.begin(), U.basis().J.end());
 }
 
 }  // namespace ads
@@ -0,0 +1,233 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_SOLUTION_CACHE_HPP
+#define ADS_SOLUTION_CACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "ads/assembly.hpp"
+#include "ads/basis_data.hpp"
+#include "ads/executor/sequential.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/sum_factorization.hpp"
+
+namespace ads {
+
+/**
+ * @brief Values, gradients and optionally Hessians of a function at quadrature points of all the
+ * elements.
+ *
+ * Evaluation is done in a single sum factorized pass over all the elements (see
+ * sum_factorization), and results are stored contiguously element by element, so that assembly
+ * loops read them instead of interpolating the function again for each test function.
+ *
+ * The cache is recomputed by update only if it was invalidated, or if it is given coefficients
+ * stored in a different tensor than previously. Modifying the coefficients in place requires
+ * calling invalidate.
+ *
+ * Data of each element consists of components, each being an array with one value per quadrature
+ * point (first coordinate changing fastest): value, partial derivatives (dx, dy, ...) and if
+ * enabled, second derivatives (i, j) for i <= j in lexicographic order.
+ */
+template <std::size_t Dim>
+class solution_cache {
+public:
+    using index_type = std::array<int, Dim>;
+    using value_type = typename quad_values<Dim>::value_type;
+    using bases_type = std::array<const basis_data*, Dim>;
+
+private:
+    bases_type bases_;
+    bool hessian_;
+    std::size_t components_;
+    std::ptrdiff_t points_ = 1;  // per element
+    std::vector<double> data_;
+
+    const double* source_ = nullptr;
+    bool dirty_ = true;
+
+public:
+    explicit solution_cache(const bases_type& bases, bool hessian = false)
+    : bases_{bases}
+    , hessian_{hessian}
+    , components_{quad_values<Dim>::components + (hessian ? Dim * (Dim + 1) / 2 : 0)} {
+        std::ptrdiff_t elements = 1;
+        for (auto const* basis : bases) {
+            assert((!hessian || basis->derivatives >= 2) && "Second derivatives are required");
+            points_ *= basis->quad_order;
+            elements *= basis->elements;
+        }
+        data_.resize(static_cast<std::size_t>(elements * element_size()));
+    }
+
+    const bases_type& bases() const { return bases_; }
+
+    bool has_hessian() const { return hessian_; }
+
+    std::size_t components() const { return components_; }
+
+    std::ptrdiff_t points_per_element() const { return points_; }
+
+    // Marks cached values as outdated, e.g. after the coefficients were modified in place
+    void invalidate() { dirty_ = true; }
+
+    bool dirty() const { return dirty_; }
+
+    /**
+     * @brief Evaluates the function with coefficients @p u, unless the cache is up to date.
+     */
+    template <typename Sol, typename Executor>
+    void update(const Sol& u, const Executor& executor) {
+        if (!dirty_ && source_ == u.data()) {
+            return;
+        }
+        auto evaluate_chunk = [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+            auto sf = sum_factorization<Dim>{bases_};
+            for (auto idx = begin; idx < end; ++idx) {
+                evaluate(sf, u, idx);
+            }
+        };
+        detail::for_each_element_chunk(bases_, executor, evaluate_chunk);
+        source_ = u.data();
+        dirty_ = false;
+    }
+
+    template <typename Sol>
+    void update(const Sol& u) {
+        update(u, sequential_executor{});
+    }
+
+    // Linear index of the element, first coordinate changing fastest
+    std::ptrdiff_t element_index(const index_type& e) const {
+        std::ptrdiff_t idx = 0;
+        for (std::size_t i = Dim; i-- > 0;) {
+            idx = idx * bases_[i]->elements + e[i];
+        }
+        return idx;
+    }
+
+    // Linear index of the quadrature point, first coordinate changing fastest
+    std::ptrdiff_t point_index(const index_type& q) const {
+        std::ptrdiff_t idx = 0;
+        for (std::size_t i = Dim; i-- > 0;) {
+            idx = idx * bases_[i]->quad_order + q[i];
+        }
+        return idx;
+    }
+
+    const double* component(const index_type& e, std::size_t k) const {
+        assert(!dirty_ && "Cache is not up to date");
+        assert(k < components_ && "Invalid component");
+        auto const offset = element_index(e) * element_size();
+        return data_.data() + offset + narrow_cast<std::ptrdiff_t>(k) * points_;
+    }
+
+    value_type value(const index_type& e, std::ptrdiff_t q) const {
+        auto c = std::array<double, quad_values<Dim>::components>{};
+        for (std::size_t k = 0; k < c.size(); ++k) {
+            c[k] = component(e, k)[q];
+        }
+        return detail::function_value_traits<Dim>::load(c.data());
+    }
+
+    value_type value(const index_type& e, const index_type& q) const {
+        return value(e, point_index(q));
+    }
+
+    // Second derivative with respect to coordinates i and j
+    double hessian(const index_type& e, std::ptrdiff_t q, std::size_t i, std::size_t j) const {
+        assert(hessian_ && "Hessian is not computed");
+        return component(e, hessian_component(i, j))[q];
+    }
+
+    // Copies values and gradients on element e
+    void load(const index_type& e, quad_values<Dim>& out) const {
+        assert(out.size() == points_ && "Invalid number of quadrature points");
+        for (std::size_t k = 0; k < quad_values<Dim>::components; ++k) {
+            auto const* const src = component(e, k);
+            std::copy(src, src + points_, out.component(k));
+        }
+    }
+
+private:
+    std::ptrdiff_t element_size() const {
+        return narrow_cast<std::ptrdiff_t>(components_) * points_;
+    }
+
+    static std::size_t hessian_component(std::size_t i, std::size_t j) {
+        if (i > j) {
+            std::swap(i, j);
+        }
+        // entries (k, l), k <= l, preceding (i, j)
+        auto const before = i * Dim - i * (i - 1) / 2 + (j - i);
+        return quad_values<Dim>::components + before;
+    }
+
+    template <typename Sol>
+    void evaluate(sum_factorization<Dim>& sf, const Sol& u, std::ptrdiff_t idx) {
+        auto const e = detail::element_index(idx, bases_);
+        auto* const out = data_.data() + idx * element_size();
+        sf.load(u, e);
+
+        std::size_t k = 0;
+        auto next = [&](const index_type& orders) {
+            sf.derivative(orders, out + narrow_cast<std::ptrdiff_t>(k) * points_);
+            ++k;
+        };
+        next(index_type{});
+        for (std::size_t i = 0; i < Dim; ++i) {
+            auto orders = index_type{};
+            orders[i] = 1;
+            next(orders);
+        }
+        if (hessian_) {
+            for (std::size_t i = 0; i < Dim; ++i) {
+                for (std::size_t j = i; j < Dim; ++j) {
+                    auto orders = index_type{};
+                    ++orders[i];
+                    ++orders[j];
+                    next(orders);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief Assembles right-hand side like assemble_rhs, with values and gradients of the function
+ * taken from @p cache.
+ *
+ * The cache needs to be up to date, test space is the one of the cache.
+ */
+template <std::size_t Dim, typename RhsImpl, typename Form, typename Executor>
+void assemble_rhs(lin::tensor_base<double, Dim, RhsImpl>& rhs, const solution_cache<Dim>& cache,
+                  Form&& form, const Executor& executor,
+                  assembly_mode mode = assembly_mode::colored) {
+    auto const& bases = cache.bases();
+    auto make_worker = [&]() {
+        auto sf = sum_factorization<Dim>{bases};
+        auto values = quad_values<Dim>{cache.points_per_element()};
+        return [&, sf, values](const auto& e, auto& local) mutable {
+            cache.load(e, values);
+            sf.apply_form(e, values, form);
+            sf.integrate(e, values, local);
+        };
+    };
+    assemble_elements(rhs, bases, executor, mode, make_worker);
+}
+
+template <std::size_t Dim, typename RhsImpl, typename Form>
+void assemble_rhs(lin::tensor_base<double, Dim, RhsImpl>& rhs, const solution_cache<Dim>& cache,
+                  Form&& form) {
+    assemble_rhs(rhs, cache, std::forward<Form>(form), sequential_executor{});
+}
+
+}  // namespace ads
+
+#endif  // ADS_SOLUTION_CACHE_HPP
@@ -4,10 +4,18 @@
 #ifndef ADS_SOLVER_HPP
 #define ADS_SOLVER_HPP
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 
+#include <boost/range/counting_range.hpp>
+
+#include "ads/executor/chunking.hpp"
 #include "ads/lin/band_matrix.hpp"
+#include "ads/lin/band_row_update.hpp"
 #include "ads/lin/band_solve.hpp"
 #include "ads/lin/tensor/view.hpp"
 #include "ads/util.hpp"
@@ -16,9 +24,173 @@ namespace ads {
 
 struct dim_data {
     lin::band_matrix const& M;
+    lin::solver_ctx const& ctx;
+};
+
+// Dimension with symmetric positive definite matrix factorized using Cholesky decomposition
+struct spd_dim_data {
+    lin::symmetric_band_matrix const& M;
     lin::solver_ctx& ctx;
 };
 
+// Dimension with factorized matrix, some rows of which are replaced by low-rank updates (e.g.
+// boundary conditions), ctx is the context of the original factorization
+struct updated_dim_data {
+    lin::band_row_update const& M;
+    lin::solver_ctx const& ctx;
+};
+
+// True for objects describing a dimension by its factorized 1D matrix
+template <typename T>
+constexpr bool is_dim_data = std::is_convertible_v<T, dim_data>
+                          || std::is_convertible_v<T, spd_dim_data>
+                          || std::is_convertible_v<T, updated_dim_data>;
+
+/**
+ * @brief Default ADS execution policy - each direction sweep is a single LAPACK call.
+ */
+struct sequential_sweep {
+    template <typename Dim, typename Rhs>
+    auto operator()(Dim const& dim, Rhs& rhs) const -> void {
+        lin::solve_with_factorized(dim.M, rhs, dim.ctx);
+    }
+
+    template <typename Rhs, typename T>
+    auto transpose(Rhs const& rhs, T* out) const {
+        return lin::cyclic_transpose(rhs, out);
+    }
+};
+
+/**
+ * @brief ADS execution policy solving right-hand sides of each direction sweep in parallel.
+ *
+ * Columns of the right-hand side are split into contiguous chunks, which are solved as independent
+ * tasks using the supplied executor. Transpositions between sweeps are parallelized as well.
+ * Factorized matrices and solver contexts are only read, so they can be shared by all the tasks,
+ * and the result is bit-identical to the one of the sequential sweep.
+ *
+ * @tparam Executor executor used to run the tasks (e.g. @c galois_executor)
+ */
+template <typename Executor>
+class parallel_sweep {
+private:
+    const Executor& executor_;
+    int chunks_;
+
+public:
+    // Default number of chunks leaves some room for load balancing
+    static constexpr int chunks_per_thread = default_chunks_per_thread;
+
+    // Chunks narrower than this are not worth the overhead of a separate task
+    static constexpr int min_chunk_size = 8;
+
+    /**
+     * @param executor executor used to run the tasks
+     * @param chunks number of chunks to split the right-hand sides into, chosen based on the
+     *        number of threads of the executor and size of the problem if not positive
+     */
+    explicit parallel_sweep(const Executor& executor, int chunks = 0)
+    : executor_{executor}
+    , chunks_{chunks} { }
+
+    template <typename Dim, typename Rhs>
+    auto operator()(Dim const& dim, Rhs& rhs) const -> void {
+        auto const n = static_cast<std::ptrdiff_t>(rhs.size(0));
+        auto const nrhs = narrow_cast<int>(rhs.size() / n);
+        auto const count = std::min(chunk_count(nrhs), nrhs);
+
+        if (count <= 1) {
+            lin::solve_with_factorized(dim.M, rhs, dim.ctx);
+            return;
+        }
+
+        auto* const data = rhs.data();
+        auto const& ctx = std::as_const(dim.ctx);
+
+        executor_.for_each(boost::counting_range(0, count), [&](int i) {
+            auto const begin = chunk_begin(i, nrhs, count);
+            auto const end = chunk_begin(i + 1, nrhs, count);
+            lin::solve_with_factorized(dim.M, data + begin * n, ctx, end - begin);
+        });
+    }
+
+    template <typename Rhs, typename T>
+    auto transpose(Rhs const& rhs, T* out) const {
+        return lin::cyclic_transpose(rhs, out, executor_);
+    }
+
+    /**
+     * @brief Solves lines along dimension d of a column-major tensor in place, without transposing.
+     *
+     * Lines along a non-leading dimension are interleaved, so they are split into chunks of
+     * consecutive columns of the (stride x n) matrices the tensor consists of, where stride is the
+     * product of sizes of dimensions preceding d.
+     */
+    template <typename Dim, std::size_t Rank>
+    auto solve_in_place(Dim const& dim, double* data, std::array<int, Rank> const& sizes,
+                        std::size_t d) const -> void {
+        std::ptrdiff_t stride = 1;
+        for (std::size_t i = 0; i < d; ++i) {
+            stride *= sizes[i];
+        }
+        std::ptrdiff_t outer = 1;
+        for (std::size_t i = d + 1; i < Rank; ++i) {
+            outer *= sizes[i];
+        }
+        auto const n = static_cast<std::ptrdiff_t>(sizes[d]);
+        auto const& ctx = std::as_const(dim.ctx);
+
+        if (d == 0) {
+            auto const nrhs = narrow_cast<int>(outer);
+            auto const count = std::max(std::min(chunk_count(nrhs), nrhs), 1);
+
+            executor_.for_each(boost::counting_range(0, count), [&](int i) {
+                auto const begin = chunk_begin(i, nrhs, count);
+                auto const end = chunk_begin(i + 1, nrhs, count);
+                lin::solve_with_factorized(dim.M, data + begin * n, ctx, end - begin);
+            });
+        } else {
+            auto const columns = narrow_cast<int>(stride * outer);
+            auto const count = std::max(std::min(chunk_count(columns), columns), 1);
+
+            executor_.for_each(boost::counting_range(0, count), [&](int i) {
+                auto const end = chunk_begin(i + 1, columns, count);
+                for (auto col = chunk_begin(i, columns, count); col < end;) {
+                    auto const k = col / stride;
+                    auto const size = std::min<std::ptrdiff_t>(end, (k + 1) * stride) - col;
+                    auto* const block = data + k * stride * n + col % stride;
+                    lin::solve_with_factorized_strided(dim.M, block, ctx, narrow_cast<int>(size),
+                                                       stride);
+                    col += narrow_cast<int>(size);
+                }
+            });
+        }
+    }
+
+private:
+    auto chunk_count(int nrhs) const -> int {
+        if (chunks_ > 0) {
+            return chunks_;
+        }
+        return ads::chunk_count(executor_, nrhs / min_chunk_size, chunks_per_thread);
+    }
+
+    static auto chunk_begin(int i, int nrhs, int count) -> int {
+        return narrow_cast<int>(static_cast<std::int64_t>(i) * nrhs / count);
+    }
+};
+
+/**
+ * @brief Transpose-free ADS execution policy.
+ *
+ * Each direction is solved in place: lines along the leading dimension are contiguous and solved
+ * by LAPACK, lines along other dimensions are solved by a band substitution that processes many
+ * interleaved lines at once (see @c lin::solve_with_factorized_strided). Since the right-hand side
+ * is never transposed, no auxiliary buffer is needed. Only the standard ADS (all dimensions given
+ * by @c dim_data, @c spd_dim_data or @c updated_dim_data) is supported.
+ */
+struct strided_sweep { };
+
 namespace detail {
 
 // Recursive implementation of the standard (Kronecker product) ADS.
@@ -27,31 +199,30 @@ namespace detail {
 // 1. Solve all the right-hand sides with a corresponding 1D matrix
 // 2. Cyclically transpose dimensions to bring the next one "to the front"
 
-template <typename Rhs, typename Buf>
-auto solve_with_dim_data(Rhs&, Buf&) -> void {
+template <typename Sweep, typename Rhs, typename Buf>
+auto solve_with_dim_data(Sweep const&, Rhs&, Buf&) -> void {
     // base case
 }
 
-template <typename Rhs, typename Buf, typename Dim, typename... Dims>
-auto solve_with_dim_data(Rhs& rhs, Buf& buf, Dim&& dim, Dims&&... dims) -> void {
-    lin::solve_with_factorized(dim.M, rhs, dim.ctx);
-    auto F = lin::cyclic_transpose(rhs, buf.data());
+template <typename Sweep, typename Rhs, typename Buf, typename Dim, typename... Dims>
+auto solve_with_dim_data(Sweep const& sweep, Rhs& rhs, Buf& buf, Dim&& dim, Dims&&... dims)
+    -> void {
+    sweep(dim, rhs);
+    auto F = sweep.transpose(rhs, buf.data());
 
-    solve_with_dim_data(F, rhs, std::forward<Dims>(dims)...);
+    solve_with_dim_data(sweep, F, rhs, std::forward<Dims>(dims)...);
 }
 
 // Auxiliary functions that compute the index of the dimension requiring custom handling in the
 // generalized version of the ADS
 
-// SFINAE needed since Fun&& can be a better match for dim_data arguments
-template <typename Fun, typename... Dims,  //
-          std::enable_if_t<!std::is_convertible_v<Fun, dim_data>, int> = 0>
+template <typename Fun, typename... Dims, std::enable_if_t<!is_dim_data<Fun>, int> = 0>
 auto find_special_dim(Fun&&, Dims&&...) -> int {
     return 0;
 }
 
-template <typename... Dims>
-auto find_special_dim(dim_data const&, Dims&&... dims) -> int {
+template <typename Dim, typename... Dims, std::enable_if_t<is_dim_data<Dim>, int> = 0>
+auto find_special_dim(Dim&&, Dims&&... dims) -> int {
     return 1 + find_special_dim(std::forward<Dims>(dims)...);
 }
 
@@ -71,17 +242,18 @@ auto find_special_dim(dim_data const&, Dims&&... dims) -> int {
 // solution resides in memory originally pointed to by either rhs or buf, depending on the number of
 // dimensions (after the call, memory of rhs and buf may be swapped).
 
-template <typename Rhs, typename Fun, typename... Dims,
+template <typename Sweep, typename Rhs, typename Fun, typename... Dims,
           std::enable_if_t<std::is_invocable_v<Fun, Rhs&>, int> = 0>
-auto solve_with_special_dim(Rhs& rhs, Rhs& buf, Fun&& fun, Dims&&... dims) -> void {
+auto solve_with_special_dim(Sweep const& sweep, Rhs& rhs, Rhs& buf, Fun&& fun, Dims&&... dims)
+    -> void {
     fun(rhs);
-    auto transposed = lin::cyclic_transpose(rhs, buf.data());
+    auto transposed = sweep.transpose(rhs, buf.data());
 
     constexpr auto N = sizeof...(Dims);
 
     // rhs is in the memory of buf, then solve_with_dim_data
     // swaps it N times between buf and rhs
-    solve_with_dim_data(transposed, rhs, std::forward<Dims>(dims)...);
+    solve_with_dim_data(sweep, transposed, rhs, std::forward<Dims>(dims)...);
 
     // ensure rhs point to the memory with solution
     if (N % 2 == 0) {
@@ -90,17 +262,19 @@ auto solve_with_special_dim(Rhs& rhs, Rhs& buf, Fun&& fun, Dims&&... dims) -> vo
     }
 }
 
-template <typename Rhs, typename... Dims>
-auto solve_with_special_dim(Rhs& rhs, Rhs& buf, dim_data const& dim, Dims&&... dims) -> void {
-    solve_with_special_dim(rhs, buf, std::forward<Dims>(dims)..., dim);
+template <typename Sweep, typename Rhs, typename Dim, typename... Dims,
+          std::enable_if_t<is_dim_data<Dim>, int> = 0>
+auto solve_with_special_dim(Sweep const& sweep, Rhs& rhs, Rhs& buf, Dim&& dim, Dims&&... dims)
+    -> void {
+    solve_with_special_dim(sweep, rhs, buf, std::forward<Dims>(dims)..., std::forward<Dim>(dim));
 }
 
-template <typename T, std::size_t Rank>
-auto do_n_cyclic_transpose(lin::tensor_view<T, Rank>& rhs, T* buf, int n)
+template <typename Sweep, typename T, std::size_t Rank>
+auto do_n_cyclic_transpose(Sweep const& sweep, lin::tensor_view<T, Rank>& rhs, T* buf, int n)
     -> lin::tensor_view<T, Rank> {
     if (n > 0) {
-        auto F = lin::cyclic_transpose(rhs, buf);
-        return do_n_cyclic_transpose(F, rhs.data(), n - 1);
+        auto F = sweep.transpose(rhs, buf);
+        return do_n_cyclic_transpose(sweep, F, rhs.data(), n - 1);
     } else {
         return rhs;
     }
@@ -111,11 +285,11 @@ auto do_n_cyclic_transpose(lin::tensor_view<T, Rank>& rhs, T* buf, int n)
 // Transposed tensor physically resides in the memory originally pointed to by either rhs of buf.
 // After the call, rhs points to the memory containing the transposed tensor and buf to the other
 // memory region.
-template <typename T, std::size_t Rank>
-auto n_cyclic_transpose(lin::tensor_view<T, Rank>& rhs, lin::tensor_view<T, Rank>& buf, int n)
-    -> lin::tensor_view<T, Rank> {
+template <typename Sweep, typename T, std::size_t Rank>
+auto n_cyclic_transpose(Sweep const& sweep, lin::tensor_view<T, Rank>& rhs,
+                        lin::tensor_view<T, Rank>& buf, int n) -> lin::tensor_view<T, Rank> {
     if (n > 0) {
-        auto res = do_n_cyclic_transpose(rhs, buf.data(), n);
+        auto res = do_n_cyclic_transpose(sweep, rhs, buf.data(), n);
 
         // do_n_cyclic_transpose copies data between memory pointed to by rhs and buf n times
         // Transposed data is physically either in memory of rhs or in memory of buf
@@ -130,24 +304,53 @@ auto n_cyclic_transpose(lin::tensor_view<T, Rank>& rhs, lin::tensor_view<T, Rank
     }
 }
 
+// Solves the system along dimension d of a column-major tensor with given sizes, in place. Tensor
+// is viewed as a sequence of (stride x n) matrices, where stride is the product of sizes of
+// dimensions preceding d - rows of each such matrix are the lines to solve.
+template <typename Dim, typename T, std::size_t Rank>
+auto solve_strided(Dim const& dim, T* data, std::array<int, Rank> const& sizes, std::size_t d)
+    -> void {
+    std::ptrdiff_t stride = 1;
+    for (std::size_t i = 0; i < d; ++i) {
+        stride *= sizes[i];
+    }
+    std::ptrdiff_t outer = 1;
+    for (std::size_t i = d + 1; i < Rank; ++i) {
+        outer *= sizes[i];
+    }
+    auto const n = sizes[d];
+
+    if (d == 0) {
+        lin::solve_with_factorized(dim.M, data, std::as_const(dim.ctx), narrow_cast<int>(outer));
+    } else {
+        for (std::ptrdiff_t k = 0; k < outer; ++k) {
+            auto* const block = data + k * stride * n;
+            lin::solve_with_factorized_strided(dim.M, block, dim.ctx, narrow_cast<int>(stride),
+                                               stride);
+        }
+    }
+}
+
 // Tag structs used to dispatch ads_solve to its correct implementation
 struct only_dim_data { };
 struct with_special_dim { };
 
 // Chooses appropriate implementation tag based on whether all the dimension describing objects are
-// of type dim_data.
+// of type dim_data, spd_dim_data or updated_dim_data.
 template <typename... Dims>
-using choose_impl = std::conditional_t<                          //
-    std::conjunction_v<std::is_convertible<Dims, dim_data>...>,  //
-    only_dim_data,                                               //
-    with_special_dim                                             //
+using choose_impl = std::conditional_t<                            //
+    std::conjunction_v<std::bool_constant<is_dim_data<Dims>>...>,  //
+    only_dim_data,                                                 //
+    with_special_dim                                               //
     >;
 
-// Standard ADS implementation. All dims arguments are of type dim_data.
+// Standard ADS implementation. All dims arguments are of type dim_data, spd_dim_data or
+// updated_dim_data.
 // This is only called for the number of dimensions > 1.
-template <typename Rhs, typename... Dims>
-auto ads_solve_impl(Rhs& rhs, Rhs& buf, only_dim_data, Dims&&... dims) -> void {
-    solve_with_dim_data(rhs, buf, std::forward<Dims>(dims)...);
+template <typename Sweep, typename Rhs, typename... Dims>
+auto ads_solve_impl(Sweep const& sweep, Rhs& rhs, Rhs& buf, only_dim_data, Dims&&... dims)
+    -> void {
+    solve_with_dim_data(sweep, rhs, buf, std::forward<Dims>(dims)...);
 
     constexpr auto N = sizeof...(Dims);
 
@@ -160,31 +363,32 @@ auto ads_solve_impl(Rhs& rhs, Rhs& buf, only_dim_data, Dims&&... dims) -> void {
 }
 //
 // Specialized implementation that avoids needless transpositions.
-template <typename Rhs>
-void ads_solve_impl(Rhs& rhs, Rhs& /*buf*/, only_dim_data, dim_data const& dim) {
-    lin::solve_with_factorized(dim.M, rhs, dim.ctx);
+template <typename Sweep, typename Rhs, typename Dim>
+void ads_solve_impl(Sweep const& sweep, Rhs& rhs, Rhs& /*buf*/, only_dim_data, Dim const& dim) {
+    sweep(dim, rhs);
 }
 
 // Generalized ADS implementation. One of the dims arguments should be a callable object that
 // accepts Rhs.
-template <typename Rhs, typename... Dims>
-auto ads_solve_impl(Rhs& rhs, Rhs& buf, with_special_dim, Dims&&... dims) -> void {
+template <typename Sweep, typename Rhs, typename... Dims>
+auto ads_solve_impl(Sweep const& sweep, Rhs& rhs, Rhs& buf, with_special_dim, Dims&&... dims)
+    -> void {
     auto const n = detail::find_special_dim(std::forward<Dims>(dims)...);
 
     // solve_with_special_dim operates on tensor views
     auto rhs_view = lin::as_tensor(rhs.data(), rhs.sizes());
     auto buf_view = lin::as_tensor(buf.data(), buf.sizes());
 
-    auto rhs_trans = n_cyclic_transpose(rhs_view, buf_view, n);
+    auto rhs_trans = n_cyclic_transpose(sweep, rhs_view, buf_view, n);
     auto buf_trans = lin::as_tensor(buf_view.data(), rhs_trans.sizes());
 
-    solve_with_special_dim(rhs_trans, buf_trans, std::forward<Dims>(dims)...);
+    solve_with_special_dim(sweep, rhs_trans, buf_trans, std::forward<Dims>(dims)...);
 
     // if n = 0, special dimension was first and no additional transpositions
     // were necessary before calling solve_with_special_dim
     if (n != 0) {
         constexpr auto N = sizeof...(Dims);
-        n_cyclic_transpose(rhs_trans, buf_trans, narrow_cast<int>(N - n));
+        n_cyclic_transpose(sweep, rhs_trans, buf_trans, narrow_cast<int>(N - n));
     }
 
     // transpositions move data between rhs and buf, here we ensure it ends up in rhs
@@ -194,12 +398,100 @@ auto ads_solve_impl(Rhs& rhs, Rhs& buf, with_special_dim, Dims&&... dims) -> voi
     }
 }
 
+// Batched ADS - the right-hand side has an additional, last axis enumerating fields. Direction
+// sweeps solve all the fields at once, while transpositions are applied to each field separately,
+// so that the field axis stays last.
+
+template <std::size_t Rank>
+auto field_sizes(std::array<int, Rank> const& sizes) -> std::array<int, Rank - 1> {
+    auto out = std::array<int, Rank - 1>{};
+    std::copy_n(begin(sizes), Rank - 1, begin(out));
+    return out;
+}
+
+template <typename Sweep, typename T, std::size_t Rank>
+auto transpose_fields(Sweep const& sweep, lin::tensor_view<T, Rank>& rhs, T* out)
+    -> lin::tensor_view<T, Rank> {
+    auto const sizes = field_sizes(rhs.sizes());
+    auto const fields = rhs.size(Rank - 1);
+    auto const field_size = fields > 0 ? rhs.size() / fields : 0;
+
+    for (int i = 0; i < fields; ++i) {
+        auto const field = lin::as_tensor(rhs.data() + i * field_size, sizes);
+        sweep.transpose(field, out + i * field_size);
+    }
+
+    auto transposed = rhs.sizes();
+    std::rotate(begin(transposed), begin(transposed) + 1, end(transposed) - 1);
+    return lin::as_tensor(out, transposed);
+}
+
+template <typename Sweep, typename T, std::size_t Rank>
+auto solve_batch_with_dim_data(Sweep const&, lin::tensor_view<T, Rank>& rhs, T*)
+    -> lin::tensor_view<T, Rank> {
+    return rhs;
+}
+
+// Returns view of the solution, which resides in the memory of either rhs or buf
+template <typename Sweep, typename T, std::size_t Rank, typename Dim, typename... Dims>
+auto solve_batch_with_dim_data(Sweep const& sweep, lin::tensor_view<T, Rank>& rhs, T* buf,
+                               Dim&& dim, Dims&&... dims) -> lin::tensor_view<T, Rank> {
+    sweep(dim, rhs);
+    auto F = transpose_fields(sweep, rhs, buf);
+
+    return solve_batch_with_dim_data(sweep, F, rhs.data(), std::forward<Dims>(dims)...);
+}
+
+template <typename Sweep, typename Rhs, typename... Dims>
+auto ads_solve_batch_impl(Sweep const& sweep, Rhs& rhs, Rhs& buf, Dims&&... dims) -> void {
+    static_assert(std::conjunction_v<std::bool_constant<is_dim_data<Dims>>...>,
+                  "Batched ADS supports only dim_data, spd_dim_data and "
+                  "updated_dim_data dimensions");
+    static_assert(std::tuple_size_v<decltype(rhs.sizes())> == sizeof...(Dims) + 1,
+                  "Batched RHS needs one axis per dimension and a field axis");
+
+    auto rhs_view = lin::as_tensor(rhs.data(), rhs.sizes());
+    auto const solution =
+        solve_batch_with_dim_data(sweep, rhs_view, buf.data(), std::forward<Dims>(dims)...);
+
+    if (solution.data() != rhs.data()) {
+        using std::swap;
+        swap(rhs, buf);
+    }
+}
+
 }  // namespace detail
 
 // For one dimension no auxiliary buffer is necessary
 template <typename Rhs>
 auto ads_solve(Rhs& rhs, dim_data const& dim) -> void {
-    lin::solve_with_factorized(dim.M, rhs, dim.ctx);
+    sequential_sweep{}(dim, rhs);
+}
+
+template <typename Rhs>
+auto ads_solve(Rhs& rhs, spd_dim_data const& dim) -> void {
+    sequential_sweep{}(dim, rhs);
+}
+
+template <typename Rhs>
+auto ads_solve(Rhs& rhs, updated_dim_data const& dim) -> void {
+    sequential_sweep{}(dim, rhs);
+}
+
+template <typename Executor, typename Rhs>
+auto ads_solve(parallel_sweep<Executor> const& sweep, Rhs& rhs, dim_data const& dim) -> void {
+    sweep(dim, rhs);
+}
+
+template <typename Executor, typename Rhs>
+auto ads_solve(parallel_sweep<Executor> const& sweep, Rhs& rhs, spd_dim_data const& dim) -> void {
+    sweep(dim, rhs);
+}
+
+template <typename Executor, typename Rhs>
+auto ads_solve(parallel_sweep<Executor> const& sweep, Rhs& rhs, updated_dim_data const& dim)
+    -> void {
+    sweep(dim, rhs);
 }
 
 /**
@@ -208,7 +500,9 @@ auto ads_solve(Rhs& rhs, dim_data const& dim) -> void {
  * There are two modes the ADS can operate in:
  *
  * - If each of @c dims is a @c dim_data object, the matrix of the system being solved is simply the
- *   Kronecker product of 1D matrices in @c dims (standard ADS)
+ *   Kronecker product of 1D matrices in @c dims (standard ADS). Dimensions with symmetric
+ *   positive definite matrices can be given as @c spd_dim_data instead, and ones with some rows
+ *   replaced by low-rank updates as @c updated_dim_data.
  *
  * - Otherwise, exactly one of @c dims should be a callable object that accepts @c Rhs
  *
@@ -222,7 +516,122 @@ auto ads_solve(Rhs& rhs, dim_data const& dim) -> void {
 template <typename Rhs, typename... Dims>
 auto ads_solve(Rhs& rhs, Rhs& buf, Dims&&... dims) -> void {
     using impl_tag = detail::choose_impl<Dims...>;
-    detail::ads_solve_impl(rhs, buf, impl_tag{}, std::forward<Dims>(dims)...);
+    detail::ads_solve_impl(sequential_sweep{}, rhs, buf, impl_tag{}, std::forward<Dims>(dims)...);
+}
+
+/**
+ * @brief Solve the system of linear equations using ADS with parallel direction sweeps.
+ *
+ * Same as the sequential version, except that each 1D solve in @c dim_data dimensions is
+ * distributed across threads by @p sweep. Callable objects describing special dimensions are
+ * invoked as is, and are responsible for their own parallelization.
+ *
+ * @param sweep parallel execution policy
+ * @param rhs right-hand side of the system
+ * @param buf auxiliary buffer large enough to store @p rhs
+ * @param dims objects describing dimensions the full matrix is decomposed into
+ */
+template <typename Executor, typename Rhs, typename... Dims>
+auto ads_solve(parallel_sweep<Executor> const& sweep, Rhs& rhs, Rhs& buf, Dims&&... dims) -> void {
+    using impl_tag = detail::choose_impl<Dims...>;
+    detail::ads_solve_impl(sweep, rhs, buf, impl_tag{}, std::forward<Dims>(dims)...);
+}
+
+/**
+ * @brief Solve the system of linear equations using transpose-free ADS.
+ *
+ * Solves the same system as the standard ADS, but in place, without transposing the right-hand
+ * side between directions, and so with no auxiliary buffer.
+ *
+ * @param rhs right-hand side of the system, overwritten with the solution
+ * @param dims objects describing dimensions the full matrix is decomposed into, one per dimension
+ *        of @p rhs
+ */
+template <typename Rhs, typename... Dims>
+auto ads_solve(strided_sweep, Rhs& rhs, Dims&&... dims) -> void {
+    static_assert(std::conjunction_v<std::bool_constant<is_dim_data<Dims>>...>,
+                  "Transpose-free ADS supports only dim_data, spd_dim_data and "
+                  "updated_dim_data dimensions");
+
+    auto const sizes = rhs.sizes();
+    static_assert(std::tuple_size_v<decltype(sizes)> == sizeof...(Dims),
+                  "Number of dimensions does not match the RHS");
+
+    std::size_t d = 0;
+    (detail::solve_strided(dims, rhs.data(), sizes, d++), ...);
+}
+
+/**
+ * @brief Solve the system of linear equations using ADS, without an auxiliary buffer.
+ *
+ * Solves the same system as the standard ADS, using the transpose-free algorithm. Apart from the
+ * right-hand side, only small scratch buffers proportional to the size of a single line (or a
+ * block of lines) are allocated. Only the standard ADS is supported.
+ *
+ * @param rhs right-hand side of the system, overwritten with the solution
+ * @param dims objects describing dimensions the full matrix is decomposed into, one per dimension
+ *        of @p rhs
+ */
+template <typename Rhs, typename... Dims,
+          std::enable_if_t<(sizeof...(Dims) > 1) && (is_dim_data<Dims> && ...), int> = 0>
+auto ads_solve(Rhs& rhs, Dims&&... dims) -> void {
+    ads_solve(strided_sweep{}, rhs, std::forward<Dims>(dims)...);
+}
+
+/**
+ * @brief Solve the system of linear equations using ADS with parallel direction sweeps, without an
+ * auxiliary buffer.
+ *
+ * Transpose-free version of the parallel ADS, lines of each direction are split into chunks solved
+ * as independent tasks, see @c parallel_sweep::solve_in_place.
+ */
+template <typename Executor, typename Rhs, typename... Dims,
+          std::enable_if_t<(sizeof...(Dims) > 1) && (is_dim_data<Dims> && ...), int> = 0>
+auto ads_solve(parallel_sweep<Executor> const& sweep, Rhs& rhs, Dims&&... dims) -> void {
+    auto const sizes = rhs.sizes();
+    static_assert(std::tuple_size_v<decltype(sizes)> == sizeof...(Dims),
+                  "Number of dimensions does not match the RHS");
+
+    std::size_t d = 0;
+    (sweep.solve_in_place(dims, rhs.data(), sizes, d++), ...);
+}
+
+/**
+ * @brief Solve the systems of linear equations for multiple fields using ADS.
+ *
+ * Solves the same system as the standard ADS for several right-hand sides of the same shape,
+ * stored in a single tensor with an additional, last axis enumerating the fields, i.e.
+ * @c rhs(i, j, k, f) is the (i, j, k) entry of the f-th field. Each direction is solved for all
+ * the fields with a single call, which amortizes the per-sweep overhead.
+ *
+ * @param rhs right-hand sides of the systems, with one more axis than there are dimensions
+ * @param buf auxiliary buffer large enough to store @p rhs
+ * @param dims objects describing dimensions the full matrix is decomposed into
+ */
+template <typename Rhs, typename... Dims>
+auto ads_solve_batch(Rhs& rhs, Rhs& buf, Dims&&... dims) -> void {
+    detail::ads_solve_batch_impl(sequential_sweep{}, rhs, buf, std::forward<Dims>(dims)...);
+}
+
+template <typename Executor, typename Rhs, typename... Dims>
+auto ads_solve_batch(parallel_sweep<Executor> const& sweep, Rhs& rhs, Rhs& buf, Dims&&... dims)
+    -> void {
+    detail::ads_solve_batch_impl(sweep, rhs, buf, std::forward<Dims>(dims)...);
+}
+
+// Transpose-free variant - the field axis simply becomes part of the outermost lines
+template <typename Rhs, typename... Dims>
+auto ads_solve_batch(strided_sweep, Rhs& rhs, Dims&&... dims) -> void {
+    static_assert(std::conjunction_v<std::bool_constant<is_dim_data<Dims>>...>,
+                  "Transpose-free ADS supports only dim_data, spd_dim_data and "
+                  "updated_dim_data dimensions");
+
+    auto const sizes = rhs.sizes();
+    static_assert(std::tuple_size_v<decltype(sizes)> == sizeof...(Dims) + 1,
+                  "Batched RHS needs one axis per dimension and a field axis");
+
+    std::size_t d = 0;
+    (detail::solve_strided(dims, rhs.data(), sizes, d++), ...);
 }
 
 }  // namespace ads
@@ -0,0 +1,292 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_SOLVER_DISTRIBUTED_HPP
+#define ADS_SOLVER_DISTRIBUTED_HPP
+
+#include "ads/config.hpp"
+
+#ifdef ADS_USE_MPI
+
+#    include <mpi.h>
+
+#    include <algorithm>
+#    include <array>
+#    include <cassert>
+#    include <cstddef>
+#    include <limits>
+#    include <tuple>
+#    include <type_traits>
+#    include <utility>
+#    include <vector>
+
+#    include "ads/solver.hpp"
+#    include "ads/util.hpp"
+
+namespace ads {
+
+/**
+ * @brief Partition of indices [0, n) into contiguous blocks of (almost) equal size.
+ */
+class block_partition {
+private:
+    std::vector<int> begins_;
+
+public:
+    block_partition(int n, int parts)
+    : begins_(parts + 1) {
+        for (int i = 0; i <= parts; ++i) {
+            begins_[i] = narrow_cast<int>(static_cast<long>(i) * n / parts);
+        }
+    }
+
+    int parts() const { return narrow_cast<int>(begins_.size()) - 1; }
+
+    int begin(int i) const { return begins_[i]; }
+
+    int end(int i) const { return begins_[i + 1]; }
+
+    int size(int i) const { return end(i) - begin(i); }
+};
+
+/**
+ * @brief ADS for tensors distributed between processes of an MPI communicator.
+ *
+ * Each process owns a slab of the tensor - indices [local_begin(), local_end()) along the last
+ * dimension, with all the indices along other dimensions - stored as a local column-major tensor
+ * of size local_sizes(). All the directions except the last one are solved locally. Before solving
+ * the last direction, the tensor is redistributed using MPI_Alltoallv, so that each process holds
+ * complete lines along the last dimension for a block of indices along the first one, and after
+ * solving it the original distribution is restored. These redistributions take place of the cyclic
+ * transpositions of the standard ADS.
+ *
+ * Every process needs all the factorized 1D matrices, e.g. each one may construct and factorize
+ * the same dimensions. Only the standard ADS (all dimensions given by @c dim_data, @c spd_dim_data
+ * or @c updated_dim_data) is supported.
+ *
+ * Sizes of the exchanged parts are not limited by the range of int. With MPI 4 they are sent using
+ * the large-count MPI_Alltoallv_c, otherwise using point-to-point messages (tagged with
+ * exchange_tag) split into chunks of at most INT_MAX values.
+ *
+ * @tparam Rank number of dimensions of the tensor (at least 2)
+ */
+template <std::size_t Rank>
+class distributed_ads {
+private:
+    static_assert(Rank >= 2, "Distributed ADS requires at least two dimensions");
+
+    MPI_Comm comm_;
+    int rank_;
+    std::array<int, Rank> sizes_;
+    block_partition slabs_;
+    block_partition columns_;
+
+#    if MPI_VERSION >= 4
+    using count_type = MPI_Count;
+    using offset_type = MPI_Aint;
+#    else
+    using count_type = std::ptrdiff_t;
+    using offset_type = std::ptrdiff_t;
+#    endif
+
+    std::vector<double> packed_;
+    std::vector<double> lines_;
+    std::vector<count_type> packed_counts_;
+    std::vector<offset_type> packed_offsets_;
+    std::vector<count_type> lines_counts_;
+    std::vector<offset_type> lines_offsets_;
+#    if MPI_VERSION < 4
+    std::vector<MPI_Request> requests_;
+#    endif
+
+public:
+    // Tag of point-to-point messages used to redistribute the tensor if MPI 4 is not available
+    static constexpr int exchange_tag = 0x4144;
+
+    /**
+     * @param comm communicator of the processes sharing the tensor
+     * @param sizes global sizes of the tensor
+     */
+    distributed_ads(MPI_Comm comm, const std::array<int, Rank>& sizes)
+    : comm_{comm}
+    , rank_{comm_rank(comm)}
+    , sizes_{sizes}
+    , slabs_{sizes[Rank - 1], comm_size(comm)}
+    , columns_{sizes[0], comm_size(comm)} {
+        compute_layout();
+    }
+
+    const std::array<int, Rank>& sizes() const { return sizes_; }
+
+    // Range of indices along the last dimension owned by this process
+    int local_begin() const { return slabs_.begin(rank_); }
+
+    int local_end() const { return slabs_.end(rank_); }
+
+    std::array<int, Rank> local_sizes() const {
+        auto sizes = sizes_;
+        sizes[Rank - 1] = slabs_.size(rank_);
+        return sizes;
+    }
+
+    /**
+     * @brief Solves the system, collective operation.
+     *
+     * @param rhs local part of the right-hand side, overwritten with the solution
+     * @param dims objects describing dimensions the full matrix is decomposed into
+     */
+    template <typename Rhs, typename... Dims>
+    void solve(Rhs& rhs, Dims&&... dims) {
+        static_assert(sizeof...(Dims) == Rank, "Invalid number of dimensions");
+        static_assert(std::conjunction_v<std::bool_constant<is_dim_data<Dims>>...>,
+                      "Distributed ADS supports only dim_data, spd_dim_data and "
+                      "updated_dim_data dimensions");
+        assert(rhs.sizes() == local_sizes() && "Invalid right-hand side size");
+
+        auto const local = local_sizes();
+        std::size_t d = 0;
+        auto const solve_local = [&](auto const& dim) {
+            if (d < Rank - 1) {
+                detail::solve_strided(dim, rhs.data(), local, d);
+            }
+            ++d;
+        };
+        (solve_local(dims), ...);
+
+        gather_lines(rhs.data());
+        auto const& last = std::get<Rank - 1>(std::forward_as_tuple(dims...));
+        detail::solve_strided(last, lines_.data(), line_sizes(), Rank - 1);
+        scatter_lines(rhs.data());
+    }
+
+private:
+    static int comm_rank(MPI_Comm comm) {
+        int rank;
+        MPI_Comm_rank(comm, &rank);
+        return rank;
+    }
+
+    static int comm_size(MPI_Comm comm) {
+        int size;
+        MPI_Comm_size(comm, &size);
+        return size;
+    }
+
+    // Product of sizes of the dimensions between the first and the last one
+    std::ptrdiff_t middle_size() const {
+        std::ptrdiff_t size = 1;
+        for (std::size_t i = 1; i < Rank - 1; ++i) {
+            size *= sizes_[i];
+        }
+        return size;
+    }
+
+    // Sizes of the local tensor with complete lines along the last dimension
+    std::array<int, Rank> line_sizes() const {
+        auto sizes = sizes_;
+        sizes[0] = columns_.size(rank_);
+        return sizes;
+    }
+
+    // Process p sends to process q the part of its slab lying in the block of columns of q. In the
+    // packed buffer the parts are stored one after another, in the lines buffer the part coming
+    // from process q occupies indices of its slab along the last dimension.
+    void compute_layout() {
+        auto const processes = slabs_.parts();
+        auto const middle = middle_size();
+
+        packed_counts_.resize(processes);
+        packed_offsets_.resize(processes);
+        lines_counts_.resize(processes);
+        lines_offsets_.resize(processes);
+
+        std::ptrdiff_t packed_offset = 0;
+        for (int q = 0; q < processes; ++q) {
+            auto const packed_count = columns_.size(q) * middle * slabs_.size(rank_);
+            packed_counts_[q] = packed_count;
+            packed_offsets_[q] = packed_offset;
+            packed_offset += packed_count;
+
+            lines_counts_[q] = columns_.size(rank_) * middle * slabs_.size(q);
+            lines_offsets_[q] = columns_.size(rank_) * middle * slabs_.begin(q);
+        }
+
+        packed_.resize(static_cast<std::size_t>(packed_offset));
+        lines_.resize(static_cast<std::size_t>(columns_.size(rank_) * middle * sizes_[Rank - 1]));
+    }
+
+    // Calls fun(line, size, packed) for each part of a line along the first dimension of the local
+    // slab that is sent to some process, where packed points to its position in the packed buffer
+    template <typename Fun>
+    void for_each_packed_block(double* data, Fun&& fun) {
+        auto const n = sizes_[0];
+        auto const lines = middle_size() * slabs_.size(rank_);
+
+        for (int q = 0; q < columns_.parts(); ++q) {
+            auto const begin = columns_.begin(q);
+            auto const size = columns_.size(q);
+            auto* packed = packed_.data() + packed_offsets_[q];
+
+            for (std::ptrdiff_t k = 0; k < lines; ++k) {
+                fun(data + k * n + begin, size, packed);
+                packed += size;
+            }
+        }
+    }
+
+    void gather_lines(double* data) {
+        for_each_packed_block(data, [](double* line, int size, double* packed) {
+            std::copy_n(line, size, packed);
+        });
+        exchange(packed_.data(), packed_counts_, packed_offsets_,  //
+                 lines_.data(), lines_counts_, lines_offsets_);
+    }
+
+    void scatter_lines(double* data) {
+        exchange(lines_.data(), lines_counts_, lines_offsets_,  //
+                 packed_.data(), packed_counts_, packed_offsets_);
+        for_each_packed_block(data, [](double* line, int size, double* packed) {
+            std::copy_n(packed, size, line);
+        });
+    }
+
+    // Sends parts of the send buffer to all the processes and receives their parts into the receive
+    // buffer, the same as MPI_Alltoallv but with counts and offsets that may exceed the int range
+    void exchange(const double* send, const std::vector<count_type>& send_counts,
+                  const std::vector<offset_type>& send_offsets, double* recv,
+                  const std::vector<count_type>& recv_counts,
+                  const std::vector<offset_type>& recv_offsets) {
+#    if MPI_VERSION >= 4
+        MPI_Alltoallv_c(send, send_counts.data(), send_offsets.data(), MPI_DOUBLE,  //
+                        recv, recv_counts.data(), recv_offsets.data(), MPI_DOUBLE, comm_);
+#    else
+        constexpr std::ptrdiff_t max_chunk = std::numeric_limits<int>::max();
+        auto const processes = slabs_.parts();
+
+        // Messages between a pair of processes are non-overtaking, so the chunks are matched in
+        // the order they are posted
+        requests_.clear();
+        for (int q = 0; q < processes; ++q) {
+            for (std::ptrdiff_t i = 0; i < recv_counts[q]; i += max_chunk) {
+                auto const count = narrow_cast<int>(std::min(max_chunk, recv_counts[q] - i));
+                MPI_Irecv(recv + recv_offsets[q] + i, count, MPI_DOUBLE, q, exchange_tag, comm_,
+                          &requests_.emplace_back());
+            }
+        }
+        for (int q = 0; q < processes; ++q) {
+            for (std::ptrdiff_t i = 0; i < send_counts[q]; i += max_chunk) {
+                auto const count = narrow_cast<int>(std::min(max_chunk, send_counts[q] - i));
+                MPI_Isend(send + send_offsets[q] + i, count, MPI_DOUBLE, q, exchange_tag, comm_,
+                          &requests_.emplace_back());
+            }
+        }
+        MPI_Waitall(narrow_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+#    endif
+    }
+};
+
+}  // namespace ads
+
+#endif  // ADS_USE_MPI
+
+#endif  // ADS_SOLVER_DISTRIBUTED_HPP
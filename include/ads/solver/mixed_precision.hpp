@@ -0,0 +1,341 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_SOLVER_MIXED_PRECISION_HPP
+#define ADS_SOLVER_MIXED_PRECISION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ads/lin/band_kernels.hpp"
+#include "ads/lin/band_row_update.hpp"
+#include "ads/lin/band_solve.hpp"
+#include "ads/solver.hpp"
+#include "ads/util.hpp"
+
+namespace ads {
+
+namespace detail {
+
+// Applies kernel(x, count, stride) to all the lines along dimension d of a column-major tensor with
+// given sizes. Contiguous lines of the leading dimension are interleaved in blocks first.
+template <typename T, std::size_t Rank, typename Kernel>
+auto for_each_line(T* data, std::array<int, Rank> const& sizes, std::size_t d, Kernel&& kernel)
+    -> void {
+    std::ptrdiff_t stride = 1;
+    for (std::size_t i = 0; i < d; ++i) {
+        stride *= sizes[i];
+    }
+    std::ptrdiff_t outer = 1;
+    for (std::size_t i = d + 1; i < Rank; ++i) {
+        outer *= sizes[i];
+    }
+    auto const n = sizes[d];
+
+    if (d == 0) {
+        lin::detail::solve_packed(n, data, narrow_cast<int>(outer), kernel);
+    } else {
+        for (std::ptrdiff_t k = 0; k < outer; ++k) {
+            auto* const block = data + k * stride * n;
+            lin::detail::solve_strided_blocks(n, block, narrow_cast<int>(stride), stride, kernel);
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Factorized 1D matrix of a single dimension, with factors rounded to single precision.
+ *
+ * Refers to the double precision factors it was created from, which are used to multiply by the
+ * original matrix. It needs to be recreated if the dimension is factorized again. Matrices with
+ * rows replaced by a low-rank update are factorized again with the rows replaced, since single
+ * precision factors of the original matrix are not a good enough preconditioner for them. Entries
+ * of the original matrix are recovered from the factors once, to form residuals without a full-size
+ * buffer (see mixed_precision_ads).
+ */
+class mixed_precision_dim {
+private:
+    struct own_factors {
+        lin::band_matrix M;
+        lin::solver_ctx ctx;
+    };
+
+    std::shared_ptr<const own_factors> own_;  // set for matrices with replaced rows
+    lin::detail::band_factors<double> factors_;
+    std::vector<float> single_;
+    std::vector<double> matrix_;
+    int kl_;
+    int ku_;
+    bool cholesky_;
+
+public:
+    explicit mixed_precision_dim(dim_data const& dim)
+    : mixed_precision_dim{lin::detail::factors_of(dim.M, dim.ctx), dim.M.kl, dim.M.ku, false} { }
+
+    explicit mixed_precision_dim(spd_dim_data const& dim)
+    : mixed_precision_dim{lin::detail::factors_of(dim.M), dim.M.kd, dim.M.kd, true} { }
+
+    explicit mixed_precision_dim(updated_dim_data const& dim)
+    : mixed_precision_dim{dim.M.rank() > 0 ? factorize(dim.M) : nullptr,
+                          dim_data{dim.M.factors(), dim.ctx}} { }
+
+    int size() const { return factors_.n; }
+
+    int kl() const { return kl_; }
+
+    int ku() const { return ku_; }
+
+    // Entry (i, j) of the original matrix, requires i - kl <= j <= i + ku
+    double entry(int i, int j) const {
+        auto const width = kl_ + ku_ + 1;
+        return matrix_[static_cast<std::size_t>(i + (j % width) * size())];
+    }
+
+    // Solves the system along dimension d in single precision, in place
+    template <std::size_t Rank>
+    void solve(float* data, std::array<int, Rank> const& sizes, std::size_t d) const {
+        auto const single = single_factors();
+        dispatch([&](auto band) {
+            detail::for_each_line(data, sizes, d, [&](float* x, int count, auto stride) {
+                if (cholesky_) {
+                    lin::detail::cholesky_substitute_strided(single, x, count, stride, band);
+                } else {
+                    lin::detail::substitute_strided(single, x, count, stride, band);
+                }
+            });
+        });
+    }
+
+    // Multiplies by the original matrix along dimension d in double precision, in place
+    template <std::size_t Rank>
+    void multiply(double* data, std::array<int, Rank> const& sizes, std::size_t d) const {
+        dispatch([&](auto band) {
+            detail::for_each_line(data, sizes, d, [&](double* x, int count, auto stride) {
+                if (cholesky_) {
+                    lin::detail::cholesky_multiply_strided(factors_, x, count, stride, band);
+                } else {
+                    lin::detail::multiply_factorized_strided(factors_, x, count, stride, band);
+                }
+            });
+        });
+    }
+
+private:
+    mixed_precision_dim(std::shared_ptr<const own_factors> own, dim_data const& dim)
+    : mixed_precision_dim{own ? dim_data{own->M, own->ctx} : dim} {
+        own_ = std::move(own);
+    }
+
+    static std::shared_ptr<const own_factors> factorize(const lin::band_row_update& update) {
+        auto M = update.matrix();
+        auto ctx = lin::solver_ctx{M};
+        lin::factorize(M, ctx);
+        return std::make_shared<const own_factors>(own_factors{std::move(M), std::move(ctx)});
+    }
+
+    mixed_precision_dim(lin::detail::band_factors<double> factors, int kl, int ku, bool cholesky)
+    : factors_{factors}
+    , single_(static_cast<std::size_t>(factors.ld * factors.n))
+    , kl_{kl}
+    , ku_{ku}
+    , cholesky_{cholesky} {
+        std::transform(factors.ab, factors.ab + single_.size(), begin(single_),
+                       [](double v) { return static_cast<float>(v); });
+        recover_matrix();
+    }
+
+    // Columns j of the band matrix with the same j mod (kl + ku + 1) have disjoint rows of nonzero
+    // entries, so the matrix is recovered by multiplying by the sums of such columns of identity
+    void recover_matrix() {
+        auto const n = size();
+        auto const width = kl_ + ku_ + 1;
+        matrix_.assign(static_cast<std::size_t>(n * width), 0.0);
+        for (int j = 0; j < n; ++j) {
+            matrix_[static_cast<std::size_t>(j + (j % width) * n)] = 1;
+        }
+        multiply(matrix_.data(), std::array<int, 2>{n, width}, 0);
+    }
+
+    lin::detail::band_factors<float> single_factors() const {
+        return {single_.data(), factors_.ld, factors_.n, factors_.ipiv};
+    }
+
+    template <typename Fun>
+    void dispatch(Fun&& fun) const {
+        if (kl_ == ku_) {
+            lin::detail::dispatch_band_impl<1>(kl_, std::forward<Fun>(fun));
+        } else {
+            fun(lin::detail::dynamic_band{kl_, ku_});
+        }
+    }
+};
+
+/**
+ * @brief Outcome of a solve with iterative refinement.
+ */
+struct refinement_status {
+    // Number of refinement steps performed, not counting the initial solve
+    int steps;
+
+    // False if the refinement stopped after max_iterations steps without reaching the tolerance
+    bool converged;
+};
+
+/**
+ * @brief ADS with single precision sweeps and iterative refinement in double precision.
+ *
+ * Factors of the 1D matrices are rounded to single precision, and the ADS sweeps operate on single
+ * precision data, which halves the memory traffic of the sweeps. Solution accurate to double
+ * precision is recovered by iterative refinement:
+ *
+ *   x_0 = 0,  x_{k+1} = x_k + S (b - A x_k)
+ *
+ * where S is the single precision ADS and A the Kronecker product of the 1D matrices, applied in
+ * double precision using the original factors. Refinement stops once the relative size (maximum
+ * norm) of the correction drops below @c tolerance, or after @c max_iterations steps.
+ *
+ * Since the sweeps are transpose-free, no buffer is needed for them. Besides the right-hand side,
+ * the refinement keeps the solution in double precision and the correction in single precision.
+ * The residual is formed directly in the correction buffer, slab by slab along the last dimension,
+ * so products of A need only kl + ku + 1 slabs of the last matrix bandwidth.
+ *
+ * @tparam Dim number of dimensions
+ */
+template <std::size_t Dim>
+class mixed_precision_ads {
+private:
+    std::array<mixed_precision_dim, Dim> dims_;
+    std::vector<double> solution_;
+    std::vector<float> correction_;
+    std::vector<double> slabs_;
+
+public:
+    int max_iterations = 10;
+    double tolerance = 1e-13;
+
+    // Dimensions need to be factorized already, only dim_data and spd_dim_data are supported
+    template <typename... Dims>
+    explicit mixed_precision_ads(Dims const&... dims)
+    : dims_{mixed_precision_dim{dims}...} {
+        static_assert(sizeof...(Dims) == Dim, "Invalid number of dimensions");
+    }
+
+    /**
+     * @brief Solves the system.
+     *
+     * The solution is written to @c rhs even if the refinement does not converge.
+     *
+     * @param rhs right-hand side, overwritten with the solution
+     * @return number of refinement steps performed and whether the tolerance was reached
+     */
+    template <typename Rhs>
+    refinement_status solve(Rhs& rhs) {
+        auto const sizes = rhs.sizes();
+        auto const n = static_cast<std::size_t>(rhs.size());
+        solution_.resize(n);
+        correction_.resize(n);
+
+        const double* const b = rhs.data();
+        double* const x = solution_.data();
+        float* const dx = correction_.data();
+
+        std::fill_n(x, n, 0.0);
+        for (std::size_t i = 0; i < n; ++i) {
+            dx[i] = static_cast<float>(b[i]);
+        }
+
+        auto status = refinement_status{0, false};
+        while (true) {
+            solve_single(dx, sizes);
+            status.converged = add_correction(x, dx, n);
+            if (status.converged || status.steps == max_iterations) {
+                break;
+            }
+            residual(b, x, dx, sizes);
+            ++status.steps;
+        }
+
+        std::copy_n(x, n, rhs.data());
+        return status;
+    }
+
+private:
+    void solve_single(float* data, std::array<int, Dim> const& sizes) const {
+        for (std::size_t d = 0; d < Dim; ++d) {
+            dims_[d].solve(data, sizes, d);
+        }
+    }
+
+    // Adds the correction to the solution, returns true if it is small enough to stop
+    bool add_correction(double* x, const float* dx, std::size_t n) const {
+        double correction_norm = 0;
+        double solution_norm = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] += dx[i];
+            correction_norm = std::max(correction_norm, std::abs(double{dx[i]}));
+            solution_norm = std::max(solution_norm, std::abs(x[i]));
+        }
+        return correction_norm <= tolerance * solution_norm;
+    }
+
+    // Computes r = b - A x rounded to single precision. Slabs of x (indices along the last
+    // dimension) are multiplied by the matrices of the other dimensions in double precision when
+    // they first enter the band of the current row of the last matrix, and kept in a ring buffer
+    // until they leave it. One more slab accumulates the row in double precision.
+    void residual(const double* b, const double* x, float* r, std::array<int, Dim> const& sizes) {
+        auto const& last = dims_[Dim - 1];
+        auto const n = sizes[Dim - 1];
+        auto const kl = last.kl();
+        auto const ku = last.ku();
+        auto const width = kl + ku + 1;
+
+        auto slab_sizes = std::array<int, Dim - 1>{};
+        std::copy_n(begin(sizes), Dim - 1, begin(slab_sizes));
+        std::ptrdiff_t slab = 1;
+        for (auto const size : slab_sizes) {
+            slab *= size;
+        }
+        slabs_.resize(static_cast<std::size_t>(slab * (width + 1)));
+        auto const product = [&](int k) { return slabs_.data() + (k % width) * slab; };
+        double* const row = slabs_.data() + width * slab;
+
+        int ready = 0;
+        for (int j = 0; j < n; ++j) {
+            for (; ready <= std::min(n - 1, j + ku); ++ready) {
+                auto* const y = product(ready);
+                std::copy_n(x + ready * slab, slab, y);
+                multiply_slab(y, slab_sizes);
+            }
+
+            std::copy_n(b + j * slab, slab, row);
+            for (int k = std::max(0, j - kl); k <= std::min(n - 1, j + ku); ++k) {
+                auto const a = last.entry(j, k);
+                const double* const y = product(k);
+                for (std::ptrdiff_t i = 0; i < slab; ++i) {
+                    row[i] -= a * y[i];
+                }
+            }
+            std::transform(row, row + slab, r + j * slab,
+                           [](double v) { return static_cast<float>(v); });
+        }
+    }
+
+    void multiply_slab(double* data, std::array<int, Dim - 1> const& sizes) const {
+        for (std::size_t d = 0; d + 1 < Dim; ++d) {
+            dims_[d].multiply(data, sizes, d);
+        }
+    }
+};
+
+template <typename... Dims>
+mixed_precision_ads(Dims const&...) -> mixed_precision_ads<sizeof...(Dims)>;
+
+}  // namespace ads
+
+#endif  // ADS_SOLVER_MIXED_PRECISION_HPP
@@ -16,6 +16,7 @@
 #    include <iostream>
 #    include <vector>
 
+#    include "ads/lin/allocator.hpp"
 #    include "ads/util.hpp"
 
 namespace ads::mumps {
@@ -35,9 +36,11 @@ struct problem {
         values_.push_back(value);
     }
 
-    int nonzero_entries() const { return narrow_cast<int>(values_.size()); }
+    linear_index_type nonzero_entries() const {
+        return narrow_cast<linear_index_type>(values_.size());
+    }
 
-    void reserve(int entries) {
+    void reserve(linear_index_type entries) {
         rows_.reserve(entries);
         cols_.reserve(entries);
         values_.reserve(entries);
@@ -56,9 +59,9 @@ struct problem {
     void rhs(double* data) { rhs_ = data; }
 
 private:
-    std::vector<int> rows_;
-    std::vector<int> cols_;
-    std::vector<double> values_;
+    std::vector<int, lin::default_allocator<int>> rows_;
+    std::vector<int, lin::default_allocator<int>> cols_;
+    std::vector<double, lin::default_allocator<double>> values_;
     double* rhs_;
     int n;
 };
@@ -172,7 +175,12 @@ class solver {
 private:
     void prepare_(problem& problem) {
         id.n = problem.dofs();
+#    ifdef ADS_USE_64BIT_INDICES
+        // 64-bit number of entries (MUMPS 5.1+), row and column indices remain 32-bit
+        id.nnz = problem.nonzero_entries();
+#    else
         id.nz = problem.nonzero_entries();
+#    endif
 
         id.irn = problem.irn();
         id.jcn = problem.jcn();
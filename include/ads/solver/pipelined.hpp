@@ -0,0 +1,326 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_SOLVER_PIPELINED_HPP
+#define ADS_SOLVER_PIPELINED_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/range/counting_range.hpp>
+
+#include "ads/lin/band_solve.hpp"
+#include "ads/lin/tensor/cyclic_transpose.hpp"
+#include "ads/solver.hpp"
+#include "ads/util.hpp"
+
+namespace ads {
+
+/**
+ * @brief Timings of a single stage (direction) of the pipelined ADS.
+ *
+ * Solve and transposition times are summed over all the tasks of the stage, so with several
+ * workers they may exceed the wall time. Stages overlap if the begin of one precedes the end of
+ * the previous one.
+ */
+struct pipeline_stage_stats {
+    double solve = 0;      // time of 1D solves, in seconds
+    double transpose = 0;  // time of transpositions, in seconds
+    double begin = 0;      // start of the first task, relative to the start of the solve
+    double end = 0;        // end of the last task, relative to the start of the solve
+};
+
+/**
+ * @brief Standard ADS with direction sweeps and transpositions overlapped in a task graph.
+ *
+ * The transposing ADS solves the whole tensor in one direction, transposes it and moves to the
+ * next direction, so each step waits for the previous one to finish. Here the tensor is split into
+ * slabs along its last dimension instead. Lines of all the directions but the last one lie within
+ * a single slab, so each slab is streamed through solve -> transpose -> solve -> ... independently
+ * of the others. Transposition of one slab thus overlaps with the solves of other slabs. The last
+ * direction needs all the slabs, and is solved in chunks of columns once they are all done.
+ *
+ * Tasks are run by a fixed number of workers started with the executor, which pick the tasks whose
+ * dependencies are satisfied from a shared queue.
+ *
+ * Transpositions write to a different memory region than the one they read, and a slab of the
+ * transposed tensor is scattered over the whole tensor. The data thus rotates over three regions
+ * (the right-hand side and two buffers owned by the solver) and a slab is transposed into the
+ * region read by the stage two steps back only once that stage is complete.
+ *
+ * The solve thus needs three times the memory of the right-hand side. The buffers are kept between
+ * solves, so that a time loop allocates them only once, and can be freed with release_buffers.
+ * Depending on the number of dimensions, the last stage may write the solution to one of the
+ * buffers (e.g. in 4D), in which case it is copied back to the right-hand side at the end.
+ *
+ * @tparam Executor executor used to start the workers (e.g. @c galois_executor)
+ */
+template <typename Executor>
+class pipelined_ads {
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct task {
+        int stage;
+        int index;
+    };
+
+    const Executor& executor_;
+    int workers_;
+    int slabs_;
+    std::array<std::vector<double>, 2> buffers_;
+    std::vector<pipeline_stage_stats> stats_;
+    double wall_time_ = 0;
+
+public:
+    // Default number of slabs leaves some room for load balancing
+    static constexpr int slabs_per_worker = 4;
+
+    /**
+     * @param executor executor used to start the workers
+     * @param workers number of workers, equal to the number of hardware threads if not positive
+     * @param slabs number of slabs to split the tensor into, chosen based on the number of workers
+     *        if not positive
+     */
+    explicit pipelined_ads(const Executor& executor, int workers = 0, int slabs = 0)
+    : executor_{executor}
+    , workers_{workers > 0 ? workers : default_workers()}
+    , slabs_{slabs > 0 ? slabs : slabs_per_worker * workers_} { }
+
+    /**
+     * @brief Solves the system.
+     *
+     * @param rhs right-hand side, overwritten with the solution
+     * @param dims factorized 1D matrices, one per dimension of @p rhs
+     */
+    template <typename Rhs, typename... Dims>
+    void solve(Rhs& rhs, Dims const&... dims) {
+        static_assert(std::conjunction_v<std::bool_constant<is_dim_data<Dims>>...>,
+                      "Pipelined ADS supports only dim_data, spd_dim_data and "
+                      "updated_dim_data dimensions");
+
+        constexpr auto Rank = sizeof...(Dims);
+        auto const sizes = rhs.sizes();
+        static_assert(std::tuple_size_v<decltype(sizes)> == Rank,
+                      "Number of dimensions does not match the RHS");
+
+        auto const solvers = std::array<std::function<void(double*, int)>, Rank>{
+            [&dims](double* b, int nrhs) {
+                lin::solve_with_factorized(dims.M, b, std::as_const(dims.ctx), nrhs);
+            }...};
+
+        stats_.assign(Rank, pipeline_stage_stats{});
+        auto const start = clock::now();
+
+        if constexpr (Rank == 1) {
+            solvers[0](rhs.data(), 1);
+        } else {
+            run(rhs.data(), sizes, solvers, start);
+        }
+        wall_time_ = seconds_since(start);
+    }
+
+    // Timings of the stages of the last solve, one per direction
+    const std::vector<pipeline_stage_stats>& stats() const { return stats_; }
+
+    // Wall time of the last solve, in seconds
+    double wall_time() const { return wall_time_; }
+
+    int workers() const { return workers_; }
+
+    // Frees the buffers, the next solve allocates them again
+    void release_buffers() { buffers_ = {}; }
+
+private:
+    static int default_workers() {
+        return std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+
+    static double seconds_since(clock::time_point start) {
+        return std::chrono::duration<double>(clock::now() - start).count();
+    }
+
+    static linear_index_type part_begin(int i, linear_index_type size, int count) {
+        return narrow_cast<linear_index_type>(std::int64_t{i} * size / count);
+    }
+
+    template <std::size_t Rank, typename Solvers>
+    void run(double* rhs, std::array<int, Rank> const& sizes, Solvers const& solvers,
+             clock::time_point start) {
+        constexpr int R = Rank;
+        auto const size = std::accumulate(begin(sizes), end(sizes), linear_index_type{1},
+                                          std::multiplies<>{});
+        for (auto& buf : buffers_) {
+            buf.resize(static_cast<std::size_t>(size));
+        }
+        auto const memory = std::array<double*, 3>{rhs, buffers_[0].data(), buffers_[1].data()};
+
+        // Stages 0, ..., R - 2 are split into slabs along the last dimension, stage R - 1 into
+        // chunks of columns of the tensor with the last dimension brought to the front
+        int const slabs = std::min(slabs_, sizes[R - 1]);
+        auto const last_columns = size / sizes[R - 1];
+        int const chunks = narrow_cast<int>(std::min<linear_index_type>(slabs_, last_columns));
+
+        int const last_in = (R - 1) % 3;
+        int const last_out = last_in != 0 ? 0 : 1;
+
+        // Sizes of the tensor as seen by stage d
+        auto const layout = [&](int d) {
+            auto rotated = sizes;
+            std::rotate(begin(rotated), begin(rotated) + d, end(rotated));
+            return rotated;
+        };
+
+        // Solves and transposes given columns of the tensor in stage d, stores timings in stats
+        auto const process = [&](int d, linear_index_type col_begin, linear_index_type col_end,
+                                 double* in, double* out, pipeline_stage_stats& stats) {
+            int const rows = sizes[d];
+            auto const cols = size / rows;
+
+            auto const before_solve = clock::now();
+            // number of right-hand sides of a single solve is limited to the range of int
+            for (auto c = col_begin; c < col_end;) {
+                auto const count = narrow_cast<int>(
+                    std::min<linear_index_type>(col_end - c, std::numeric_limits<int>::max()));
+                solvers[d](in + std::ptrdiff_t{c} * rows, count);
+                c += count;
+            }
+            auto const before_transpose = clock::now();
+            lin::detail::transpose_columns(in, out, rows, cols, col_begin, col_end);
+            auto const after = clock::now();
+
+            stats.solve += std::chrono::duration<double>(before_transpose - before_solve).count();
+            stats.transpose += std::chrono::duration<double>(after - before_transpose).count();
+        };
+
+        // Slab of the last dimension is a set of column ranges of the tensor in layout of stage d
+        auto const run_slab = [&](int d, int s, pipeline_stage_stats& stats) {
+            auto const shape = layout(d);
+            int const p = R - 1 - d;
+            auto const k0 = part_begin(s, sizes[R - 1], slabs);
+            auto const k1 = part_begin(s + 1, sizes[R - 1], slabs);
+
+            linear_index_type inner = 1;
+            for (int i = 1; i < p; ++i) {
+                inner *= shape[i];
+            }
+            linear_index_type outer = 1;
+            for (int i = p + 1; i < R; ++i) {
+                outer *= shape[i];
+            }
+            for (linear_index_type o = 0; o < outer; ++o) {
+                auto const base = o * sizes[R - 1];
+                process(d, (base + k0) * inner, (base + k1) * inner, memory[d % 3],
+                        memory[(d + 1) % 3], stats);
+            }
+        };
+
+        auto const run_task = [&](task t, pipeline_stage_stats& stats) {
+            if (t.stage < R - 1) {
+                run_slab(t.stage, t.index, stats);
+            } else {
+                auto const c0 = part_begin(t.index, last_columns, chunks);
+                auto const c1 = part_begin(t.index + 1, last_columns, chunks);
+                process(R - 1, c0, c1, memory[last_in], memory[last_out], stats);
+            }
+        };
+
+        // Scheduler state, guarded by mutex
+        auto mutex = std::mutex{};
+        auto task_ready = std::condition_variable{};
+        auto ready = std::deque<task>{};
+        auto done = std::vector<char>(static_cast<std::size_t>(slabs * (R - 1)));
+        auto completed = std::vector<int>(R);
+        int remaining = slabs * (R - 1) + chunks;
+
+        auto const is_done = [&](int d, int s) { return done[d * slabs + s] != 0; };
+        auto const stage_complete = [&](int d) { return d < 0 || completed[d] == slabs; };
+
+        // Slab s of stage d needs to be solved in stage d - 1, and it may only be transposed into
+        // the memory of stage d - 2 once no slab of that stage reads it anymore
+        auto const complete = [&](task t) {
+            --remaining;
+            if (t.stage == R - 1) {
+                return;
+            }
+            int const d = t.stage;
+            done[d * slabs + t.index] = 1;
+            ++completed[d];
+
+            if (d + 1 < R - 1 && stage_complete(d - 1)) {
+                ready.push_back({d + 1, t.index});
+            }
+            if (stage_complete(d)) {
+                if (d + 2 < R - 1) {
+                    for (int s = 0; s < slabs; ++s) {
+                        if (is_done(d + 1, s)) {
+                            ready.push_back({d + 2, s});
+                        }
+                    }
+                }
+                if (d == R - 2) {
+                    for (int c = 0; c < chunks; ++c) {
+                        ready.push_back({R - 1, c});
+                    }
+                }
+            }
+        };
+
+        for (int s = 0; s < slabs; ++s) {
+            ready.push_back({0, s});
+        }
+
+        auto const worker = [&](int) {
+            auto lock = std::unique_lock{mutex};
+            while (true) {
+                task_ready.wait(lock, [&] { return !ready.empty() || remaining == 0; });
+                if (ready.empty()) {
+                    return;
+                }
+                auto const t = ready.front();
+                ready.pop_front();
+                lock.unlock();
+
+                auto const task_begin = seconds_since(start);
+                auto task_stats = pipeline_stage_stats{};
+                run_task(t, task_stats);
+                auto const task_end = seconds_since(start);
+
+                lock.lock();
+                auto& stats = stats_[t.stage];
+                if (stats.end == 0 || task_begin < stats.begin) {
+                    stats.begin = task_begin;
+                }
+                stats.end = std::max(stats.end, task_end);
+                stats.solve += task_stats.solve;
+                stats.transpose += task_stats.transpose;
+
+                complete(t);
+                task_ready.notify_all();
+            }
+        };
+
+        executor_.for_each(boost::counting_range(0, workers_), worker);
+
+        if (last_out != 0) {
+            std::copy_n(memory[last_out], size, rhs);
+        }
+    }
+};
+
+}  // namespace ads
+
+#endif  // ADS_SOLVER_PIPELINED_HPP
@@ -0,0 +1,464 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_SUM_FACTORIZATION_HPP
+#define ADS_SUM_FACTORIZATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "ads/assembly.hpp"
+#include "ads/basis_data.hpp"
+#include "ads/executor/sequential.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/util/function_value.hpp"
+
+namespace ads {
+
+namespace detail {
+
+// Conversion of function_value_Nd to and from an array of its components (value, dx, dy, ...)
+
+template <std::size_t Dim>
+struct function_value_traits;
+
+template <>
+struct function_value_traits<1> {
+    using type = function_value_1d;
+
+    static type load(const double* c) { return {c[0], c[1]}; }
+
+    static void store(const type& v, double* c) {
+        c[0] = v.val;
+        c[1] = v.dx;
+    }
+};
+
+template <>
+struct function_value_traits<2> {
+    using type = function_value_2d;
+
+    static type load(const double* c) { return {c[0], c[1], c[2]}; }
+
+    static void store(const type& v, double* c) {
+        c[0] = v.val;
+        c[1] = v.dx;
+        c[2] = v.dy;
+    }
+};
+
+template <>
+struct function_value_traits<3> {
+    using type = function_value_3d;
+
+    static type load(const double* c) { return {c[0], c[1], c[2], c[3]}; }
+
+    static void store(const type& v, double* c) {
+        c[0] = v.val;
+        c[1] = v.dx;
+        c[2] = v.dy;
+        c[3] = v.dz;
+    }
+};
+
+template <>
+struct function_value_traits<4> {
+    using type = function_value_4d;
+
+    static type load(const double* c) { return {c[0], c[1], c[2], c[3], c[4]}; }
+
+    static void store(const type& v, double* c) {
+        c[0] = v.val;
+        c[1] = v.dx;
+        c[2] = v.dy;
+        c[3] = v.dz;
+        c[4] = v.dt;
+    }
+};
+
+/**
+ * Multiplies tensor x of given (column-major) sizes by m x n matrix A stored row by row along
+ * dimension d, and stores the result in y. Size of dimension d is updated to m.
+ */
+template <std::size_t Dim>
+void mode_product(const double* A, int m, const double* x, double* y, std::array<int, Dim>& sizes,
+                  std::size_t d) {
+    int const n = sizes[d];
+    std::ptrdiff_t stride = 1;
+    for (std::size_t i = 0; i < d; ++i) {
+        stride *= sizes[i];
+    }
+    std::ptrdiff_t outer = 1;
+    for (std::size_t i = d + 1; i < Dim; ++i) {
+        outer *= sizes[i];
+    }
+
+    for (std::ptrdiff_t k = 0; k < outer; ++k) {
+        auto const* const in = x + k * n * stride;
+        auto* const out = y + k * m * stride;
+        for (int r = 0; r < m; ++r) {
+            auto* const line = out + r * stride;
+            std::fill(line, line + stride, 0.0);
+            for (int j = 0; j < n; ++j) {
+                double const a = A[r * n + j];
+                auto const* const src = in + j * stride;
+                for (std::ptrdiff_t i = 0; i < stride; ++i) {
+                    line[i] += a * src[i];
+                }
+            }
+        }
+    }
+    sizes[d] = m;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Values and first derivatives of a function at the quadrature points of an element.
+ *
+ * Components (value, dx, dy, ...) are stored in separate arrays, each one indexed by the linear
+ * index of the quadrature point (first coordinate changing fastest).
+ */
+template <std::size_t Dim>
+class quad_values {
+public:
+    using value_type = typename detail::function_value_traits<Dim>::type;
+
+    static constexpr std::size_t components = Dim + 1;
+
+private:
+    std::ptrdiff_t size_ = 0;
+    std::vector<double> data_;
+
+public:
+    quad_values() = default;
+
+    explicit quad_values(std::ptrdiff_t points)
+    : size_{points}
+    , data_(components * static_cast<std::size_t>(points)) { }
+
+    std::ptrdiff_t size() const { return size_; }
+
+    double* component(std::size_t k) { return data_.data() + k * static_cast<std::size_t>(size_); }
+
+    const double* component(std::size_t k) const {
+        return data_.data() + k * static_cast<std::size_t>(size_);
+    }
+
+    value_type operator[](std::ptrdiff_t q) const {
+        auto c = std::array<double, components>{};
+        for (std::size_t k = 0; k < components; ++k) {
+            c[k] = component(k)[q];
+        }
+        return detail::function_value_traits<Dim>::load(c.data());
+    }
+
+    void set(std::ptrdiff_t q, const value_type& v) {
+        auto c = std::array<double, components>{};
+        detail::function_value_traits<Dim>::store(v, c.data());
+        for (std::size_t k = 0; k < components; ++k) {
+            component(k)[q] = c[k];
+        }
+    }
+};
+
+/**
+ * @brief Evaluation and integration on tensor product elements by sum factorization.
+ *
+ * Instead of evaluating each of the (p + 1)^d basis functions at each of the q^d quadrature
+ * points of an element, 1D tables of basis function values and derivatives taken from
+ * basis_data::b are contracted with the element tensor one dimension at a time. Computing values
+ * and gradients of a function at all the quadrature points of an element, as well as integrating
+ * a linear form against all the basis functions, costs O(d (p + 1)^(d + 1)) per component instead
+ * of O((p + 1)^(2d)).
+ *
+ * Objects hold buffers reused between elements, so each thread needs a separate one. Bases need
+ * to include first derivatives, second derivatives are available if bases include them.
+ */
+template <std::size_t Dim>
+class sum_factorization {
+public:
+    using index_type = std::array<int, Dim>;
+    using point_type = std::array<double, Dim>;
+    using value_type = typename detail::function_value_traits<Dim>::type;
+    using bases_type = std::array<const basis_data*, Dim>;
+
+private:
+    // Values (0) and derivatives (1, 2) of basis functions at quadrature points of an element, as
+    // quad x dofs matrices (stored in basis_data), and transpositions of the first two
+    struct tables {
+        std::vector<const double*> eval;
+        std::array<std::vector<double>, 2> integrate;
+    };
+
+    bases_type bases_;
+    index_type dofs_;
+    index_type points_;
+    std::array<tables, Dim> tables_;
+    index_type loaded_;  // element the tables were loaded for
+    std::array<std::vector<double>, 2> buffers_;
+    std::vector<double> coeffs_;
+    std::vector<double> sum_;
+    quad_values<Dim> values_;
+
+public:
+    explicit sum_factorization(const bases_type& bases)
+    : bases_{bases} {
+        loaded_.fill(-1);
+        std::ptrdiff_t buffer_size = 1;
+        std::ptrdiff_t dof_count = 1;
+        std::ptrdiff_t point_count = 1;
+        for (std::size_t i = 0; i < Dim; ++i) {
+            assert(bases[i]->derivatives >= 1 && "Basis derivatives are required");
+            dofs_[i] = bases[i]->dofs_per_element();
+            points_[i] = bases[i]->quad_order;
+            buffer_size *= std::max(dofs_[i], points_[i]);
+            dof_count *= dofs_[i];
+            point_count *= points_[i];
+
+            auto const size = static_cast<std::size_t>(dofs_[i] * points_[i]);
+            auto const orders = static_cast<std::size_t>(std::min(bases[i]->derivatives, 2) + 1);
+            tables_[i].eval.resize(orders);
+            for (auto& t : tables_[i].integrate) {
+                t.resize(size);
+            }
+        }
+        for (auto& buf : buffers_) {
+            buf.resize(static_cast<std::size_t>(buffer_size));
+        }
+        coeffs_.resize(static_cast<std::size_t>(dof_count));
+        sum_.resize(static_cast<std::size_t>(dof_count));
+        values_ = quad_values<Dim>{point_count};
+    }
+
+    const index_type& dofs_per_element() const { return dofs_; }
+
+    const index_type& quad_points_per_element() const { return points_; }
+
+    /**
+     * @brief Computes values and gradients of function with coefficients @p u at the quadrature
+     * points of element @p e.
+     */
+    template <typename Sol>
+    void evaluate(const Sol& u, const index_type& e, quad_values<Dim>& out) {
+        load(u, e);
+        for (std::size_t k = 0; k < quad_values<Dim>::components; ++k) {
+            auto orders = index_type{};
+            if (k > 0) {
+                orders[k - 1] = 1;
+            }
+            derivative(orders, out.component(k));
+        }
+    }
+
+    /**
+     * @brief Loads coefficients of function @p u on element @p e, for use by derivative.
+     */
+    template <typename Sol>
+    void load(const Sol& u, const index_type& e) {
+        load_tables(e);
+        auto first = index_type{};
+        for (std::size_t i = 0; i < Dim; ++i) {
+            first[i] = bases_[i]->first_dof(e[i]);
+        }
+        lin::copy(u.block(first, dofs_), lin::tensor_view<double, Dim>{coeffs_.data(), dofs_});
+    }
+
+    /**
+     * @brief Computes partial derivative of the last loaded function at the quadrature points of
+     * its element.
+     *
+     * @param orders order of the derivative along each dimension (at most 2)
+     * @param out    array of size equal to the number of quadrature points of an element
+     */
+    void derivative(const index_type& orders, double* out) {
+        auto table = std::array<const double*, Dim>{};
+        for (std::size_t i = 0; i < Dim; ++i) {
+            auto const order = static_cast<std::size_t>(orders[i]);
+            assert(order < tables_[i].eval.size() && "Derivative of too high order");
+            table[i] = tables_[i].eval[order];
+        }
+        contract(table, points_, coeffs_.data(), dofs_, out);
+    }
+
+    /**
+     * @brief Integrates against basis functions of element @p e the linear form with coefficients
+     * given at quadrature points, i.e.
+     *
+     *   local(a) = sum_q in(q).val B_a(x_q) + in(q).dx dB_a/dx (x_q) + ...
+     *
+     * Quadrature weights and jacobian need to be included in @p in. Previous contents of @p local
+     * are overwritten.
+     */
+    template <typename Local>
+    void integrate(const index_type& e, const quad_values<Dim>& in, Local& local) {
+        assert(local.sizes() == dofs_ && "Invalid local tensor size");
+        load_tables(e);
+        auto* const result = local.data();
+        std::fill(result, result + local.size(), 0.0);
+
+        for (std::size_t k = 0; k < quad_values<Dim>::components; ++k) {
+            auto table = std::array<const double*, Dim>{};
+            for (std::size_t i = 0; i < Dim; ++i) {
+                table[i] = tables_[i].integrate[k == i + 1 ? 1 : 0].data();
+            }
+            contract(table, dofs_, in.component(k), points_, sum_.data());
+            for (std::size_t a = 0; a < sum_.size(); ++a) {
+                result[a] += sum_[a];
+            }
+        }
+    }
+
+    /**
+     * @brief Replaces values at the quadrature points of element @p e by w J form(x, value), where
+     * w is the quadrature weight and J the jacobian of the element.
+     */
+    template <typename Form>
+    void apply_form(const index_type& e, quad_values<Dim>& values, Form&& form) const {
+        assert(values.size() == values_.size() && "Invalid number of quadrature points");
+        double J = 1;
+        for (std::size_t i = 0; i < Dim; ++i) {
+            J *= bases_[i]->J[e[i]];
+        }
+        auto q = index_type{};
+        for (std::ptrdiff_t idx = 0; idx < values.size(); ++idx) {
+            auto x = point_type{};
+            double w = J;
+            for (std::size_t i = 0; i < Dim; ++i) {
+                x[i] = bases_[i]->x[e[i]][q[i]];
+                w *= bases_[i]->w[q[i]];
+            }
+            auto r = form(x, values[idx]);
+            r *= w;
+            values.set(idx, r);
+
+            // next quadrature point, first coordinate changing fastest
+            for (std::size_t i = 0; i < Dim && ++q[i] == points_[i]; ++i) {
+                q[i] = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Computes element right-hand side of the form
+     *
+     *   local(a) = int_e form(x, u(x)) . (B_a, grad B_a) dx
+     *
+     * where @p form returns coefficients of the value and partial derivatives of the test function,
+     * given the point and value with gradient of the function with coefficients @p u.
+     */
+    template <typename Sol, typename Local, typename Form>
+    void element_rhs(const index_type& e, const Sol& u, Local& local, Form&& form) {
+        evaluate(u, e, values_);
+        apply_form(e, values_, form);
+        integrate(e, values_, local);
+    }
+
+    /**
+     * @brief Same as above, with @p u from a different (trial) space, evaluated by @p trial.
+     *
+     * Both spaces need to use the same elements and quadratures.
+     */
+    template <typename Sol, typename Local, typename Form>
+    void element_rhs(const index_type& e, sum_factorization& trial, const Sol& u, Local& local,
+                     Form&& form) {
+        assert(trial.points_ == points_ && "Spaces use different quadratures");
+        trial.evaluate(u, e, values_);
+        apply_form(e, values_, form);
+        integrate(e, values_, local);
+    }
+
+private:
+    void load_tables(const index_type& e) {
+        if (e == loaded_) {
+            return;
+        }
+        loaded_ = e;
+        for (std::size_t i = 0; i < Dim; ++i) {
+            auto const& b = bases_[i]->b;
+            int const n = dofs_[i];
+            int const m = points_[i];
+            auto& t = tables_[i];
+            for (std::size_t d = 0; d < t.eval.size(); ++d) {
+                t.eval[d] = b.table(e[i], narrow_cast<int>(d));
+            }
+            for (std::size_t d = 0; d < 2; ++d) {
+                auto const* const table = t.eval[d];
+                for (int q = 0; q < m; ++q) {
+                    for (int a = 0; a < n; ++a) {
+                        t.integrate[d][a * m + q] = table[q * n + a];
+                    }
+                }
+            }
+        }
+    }
+
+    // Applies matrices from table (rows[i] x sizes[i]) along consecutive dimensions of x
+    void contract(const std::array<const double*, Dim>& table, const index_type& rows,
+                  const double* x, index_type sizes, double* y) {
+        const double* in = x;
+        for (std::size_t i = 0; i < Dim; ++i) {
+            double* const out = i + 1 == Dim ? y : buffers_[i % 2].data();
+            detail::mode_product(table[i], rows[i], in, out, sizes, i);
+            in = out;
+        }
+    }
+};
+
+/**
+ * @brief Assembles right-hand side of the form
+ *
+ *   rhs(a) += int form(x, u(x)) . (B_a, grad B_a) dx
+ *
+ * using sum factorization on each element, see sum_factorization::element_rhs. Elements are
+ * processed in parallel by the executor, with updates of @p rhs done as specified by @p mode (see
+ * assemble_elements).
+ */
+template <std::size_t Dim, typename RhsImpl, typename SolImpl, typename Form, typename Executor>
+void assemble_rhs(lin::tensor_base<double, Dim, RhsImpl>& rhs,
+                  const lin::tensor_base<double, Dim, SolImpl>& u,
+                  const std::array<const basis_data*, Dim>& bases, Form&& form,
+                  const Executor& executor, assembly_mode mode = assembly_mode::colored) {
+    auto make_worker = [&]() {
+        return [&, sf = sum_factorization<Dim>{bases}](const auto& e, auto& local) mutable {
+            sf.element_rhs(e, u, local, form);
+        };
+    };
+    assemble_elements(rhs, bases, executor, mode, make_worker);
+}
+
+template <std::size_t Dim, typename RhsImpl, typename SolImpl, typename Form>
+void assemble_rhs(lin::tensor_base<double, Dim, RhsImpl>& rhs,
+                  const lin::tensor_base<double, Dim, SolImpl>& u,
+                  const std::array<const basis_data*, Dim>& bases, Form&& form) {
+    assemble_rhs(rhs, u, bases, std::forward<Form>(form), sequential_executor{});
+}
+
+/**
+ * @brief Same as above, with the right-hand side in the test space and @p u in the trial space.
+ *
+ * Both spaces need to use the same elements and quadratures.
+ */
+template <std::size_t Dim, typename RhsImpl, typename SolImpl, typename Form, typename Executor>
+void assemble_rhs(lin::tensor_base<double, Dim, RhsImpl>& rhs,
+                  const std::array<const basis_data*, Dim>& test,
+                  const lin::tensor_base<double, Dim, SolImpl>& u,
+                  const std::array<const basis_data*, Dim>& trial, Form&& form,
+                  const Executor& executor, assembly_mode mode = assembly_mode::colored) {
+    auto make_worker = [&]() {
+        auto test_sf = sum_factorization<Dim>{test};
+        auto trial_sf = sum_factorization<Dim>{trial};
+        return [&, test_sf, trial_sf](const auto& e, auto& local) mutable {
+            test_sf.element_rhs(e, trial_sf, u, local, form);
+        };
+    };
+    assemble_elements(rhs, test, executor, mode, make_worker);
+}
+
+}  // namespace ads
+
+#endif  // ADS_SUM_FACTORIZATION_HPP
@@ -4,10 +4,23 @@
 #ifndef ADS_UTIL_HPP
 #define ADS_UTIL_HPP
 
+#include <cstdint>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "ads/config.hpp"
+
 namespace ads {
 
+// Type of linear indices and total sizes of tensors. Sizes along single dimensions (and thus sizes
+// of 1D problems passed to LAPACK) are always int.
+#ifdef ADS_USE_64BIT_INDICES
+using linear_index_type = std::int64_t;
+#else
+using linear_index_type = int;
+#endif
+
 template <typename T, typename TMin, typename TMax>
 auto clamp(T v, TMin min, TMax max) {
     return v < min ? min : v > max ? max : v;
@@ -7,5 +7,6 @@
 #include "ads/util/function_value/function_value_1d.hpp"
 #include "ads/util/function_value/function_value_2d.hpp"
 #include "ads/util/function_value/function_value_3d.hpp"
+#include "ads/util/function_value/function_value_4d.hpp"
 
 #endif  // ADS_UTIL_FUNCTION_VALUE_HPP
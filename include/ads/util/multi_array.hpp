@@ -7,6 +7,7 @@
 #include "ads/util/multi_array/base.hpp"
 #include "ads/util/multi_array/ordering/reverse.hpp"
 #include "ads/util/multi_array/ordering/standard.hpp"
+#include "ads/util/multi_array/ordering/strided.hpp"
 #include "ads/util/multi_array/reshape.hpp"
 #include "ads/util/multi_array/wrapper.hpp"
 
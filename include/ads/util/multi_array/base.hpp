@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <type_traits>
 
+#include "ads/util.hpp"
 #include "ads/util/meta.hpp"
 #include "ads/util/multi_array/ordering/standard.hpp"
 
@@ -26,6 +27,9 @@ struct multi_array_base : private Order<Rank> {
     explicit multi_array_base(const size_array& sizes)
     : Ordering{sizes} { }
 
+    explicit multi_array_base(const Ordering& ordering)
+    : Ordering{ordering} { }
+
     template <typename... Indices>
     const T& operator()(Indices... indices) const {
         check_indices_(indices...);
@@ -42,10 +46,13 @@ struct multi_array_base : private Order<Rank> {
 
     int size(int dim) const { return Ordering::size(dim); }
 
-    int size() const { return Ordering::size(); }
+    linear_index_type size() const { return Ordering::size(); }
 
     size_array sizes() const { return Ordering::sizes(); }
 
+protected:
+    const Ordering& ordering() const { return *this; }
+
 private:
     template <typename... Indices>
     void check_indices_(Indices...) const {
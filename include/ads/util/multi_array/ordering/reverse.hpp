@@ -25,12 +25,12 @@ struct reverse_ordering_indexer_ : reverse_ordering_indexer_<I - 1, Rank> {
     : Base{sizes} { }
 
     template <typename... Indices>
-    int linearize(int idx, Indices... indices) const {
+    linear_index_type linearize(int idx, Indices... indices) const {
         assert(idx < n() && "Index out of bounds");
         return idx + n() * Base::linearize(indices...);
     }
 
-    int size() const { return n() * Base::size(); }
+    linear_index_type size() const { return n() * Base::size(); }
 
 private:
     int n() const { return std::get<Rank - I>(Base::sizes); }
@@ -45,9 +45,9 @@ struct reverse_ordering_indexer_<0, Rank> {
     explicit reverse_ordering_indexer_(size_array sizes)
     : sizes(sizes) { }
 
-    int linearize() const { return 0; }
+    linear_index_type linearize() const { return 0; }
 
-    int size() const { return 1; }
+    linear_index_type size() const { return 1; }
 };
 
 }  // namespace impl
@@ -61,7 +61,7 @@ struct reverse_ordering : private impl::reverse_ordering_indexer_<Rank, Rank> {
     : Indexer{sizes} { }
 
     template <typename... Indices>
-    int linear_index(Indices... indices) const {
+    linear_index_type linear_index(Indices... indices) const {
         static_assert(util::all_<std::is_integral, Indices...>::value,
                       "Indices need to be of integral type");
         return Indexer::linearize(indices...);
@@ -72,7 +72,7 @@ struct reverse_ordering : private impl::reverse_ordering_indexer_<Rank, Rank> {
         return Indexer::sizes[dim];
     }
 
-    int size() const { return Indexer::size(); }
+    linear_index_type size() const { return Indexer::size(); }
 
     size_array sizes() const { return Indexer::sizes; }
 };
@@ -27,12 +27,12 @@ struct standard_ordering_indexer_ : standard_ordering_indexer_<I + 1, Rank> {
     : Base{sizes} { }
 
     template <typename... Indices>
-    int linearize(int base, int idx, Indices... indices) const {
+    linear_index_type linearize(linear_index_type base, int idx, Indices... indices) const {
         assert(idx < n() && "Index out of bounds");
         return Base::linearize(base * n() + idx, indices...);
     }
 
-    int size() const { return n() * Base::size(); }
+    linear_index_type size() const { return n() * Base::size(); }
 
 private:
     int n() const { return std::get<I>(Base::sizes); }
@@ -47,9 +47,9 @@ struct standard_ordering_indexer_<Rank, Rank> {
     explicit standard_ordering_indexer_(size_array sizes)
     : sizes(sizes) { }
 
-    int linearize(int base) const { return base; }
+    linear_index_type linearize(linear_index_type base) const { return base; }
 
-    int size() const { return 1; }
+    linear_index_type size() const { return 1; }
 };
 
 }  // namespace impl
@@ -64,7 +64,7 @@ struct standard_ordering : private impl::standard_ordering_indexer_<0, Rank> {
     : Indexer{sizes} { }
 
     template <typename... Indices>
-    int linear_index(Indices... indices) const {
+    linear_index_type linear_index(Indices... indices) const {
         static_assert(util::all_<std::is_integral, Indices...>::value,
                       "Indices need to be of integral type");
         return Indexer::linearize(0, indices...);
@@ -75,7 +75,7 @@ struct standard_ordering : private impl::standard_ordering_indexer_<0, Rank> {
         return Indexer::sizes[dim];
     }
 
-    int size() const { return Indexer::size(); }
+    linear_index_type size() const { return Indexer::size(); }
 
     size_array sizes() const { return Indexer::sizes(); }
 };
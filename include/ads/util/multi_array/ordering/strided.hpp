@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef ADS_UTIL_MULTI_ARRAY_ORDERING_STRIDED_HPP
+#define ADS_UTIL_MULTI_ARRAY_ORDERING_STRIDED_HPP
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "ads/util.hpp"
+#include "ads/util/meta.hpp"
+
+namespace ads {
+
+// Memory layout with arbitrary (non-negative) distance between consecutive elements along each
+// dimension - describes sub-arrays (slices, blocks) of arrays with other layouts
+template <std::size_t Rank>
+struct strided_ordering {
+    using size_array = std::array<int, Rank>;
+    using stride_array = std::array<std::ptrdiff_t, Rank>;
+
+private:
+    size_array sizes_;
+    stride_array strides_;
+
+public:
+    // Contiguous layout, with the first index changing fastest (same as reverse_ordering)
+    explicit strided_ordering(const size_array& sizes)
+    : sizes_{sizes}
+    , strides_{packed_strides(sizes)} { }
+
+    strided_ordering(const size_array& sizes, const stride_array& strides)
+    : sizes_{sizes}
+    , strides_{strides} { }
+
+    template <typename... Indices>
+    std::ptrdiff_t linear_index(Indices... indices) const {
+        static_assert(util::all_<std::is_integral, Indices...>::value,
+                      "Indices need to be of integral type");
+        auto const idx = std::array<int, Rank>{static_cast<int>(indices)...};
+        std::ptrdiff_t offset = 0;
+        for (std::size_t i = 0; i < Rank; ++i) {
+            assert(idx[i] < sizes_[i] && "Index out of bounds");
+            offset += idx[i] * strides_[i];
+        }
+        return offset;
+    }
+
+    int size(int dim) const {
+        assert(dim < as_signed(Rank) && "Index larger than rank");
+        return sizes_[dim];
+    }
+
+    linear_index_type size() const {
+        linear_index_type size = 1;
+        for (auto n : sizes_) {
+            size *= n;
+        }
+        return size;
+    }
+
+    size_array sizes() const { return sizes_; }
+
+    std::ptrdiff_t stride(int dim) const {
+        assert(dim < as_signed(Rank) && "Index larger than rank");
+        return strides_[dim];
+    }
+
+    stride_array strides() const { return strides_; }
+
+    // True if the elements occupy a contiguous block of memory in reverse_ordering layout
+    bool is_contiguous() const { return strides_ == packed_strides(sizes_); }
+
+    static stride_array packed_strides(const size_array& sizes) {
+        auto strides = stride_array{};
+        std::ptrdiff_t stride = 1;
+        for (std::size_t i = 0; i < Rank; ++i) {
+            strides[i] = stride;
+            stride *= sizes[i];
+        }
+        return strides;
+    }
+};
+
+}  // namespace ads
+
+#endif  // ADS_UTIL_MULTI_ARRAY_ORDERING_STRIDED_HPP
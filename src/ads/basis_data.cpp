@@ -3,63 +3,14 @@
 
 #include "ads/basis_data.hpp"
 
+#include <cstddef>
+#include <vector>
+
 #include "ads/quad/gauss.hpp"
 #include "ads/util.hpp"
 
 namespace ads {
 
-basis_data::~basis_data() {
-    for (int e = 0; e < elements; ++e) {
-        for (int k = 0; k < quad_order; ++k) {
-            for (int d = 0; d <= derivatives; ++d) {
-                delete[] b[e][k][d];
-            }
-            delete[] b[e][k];
-        }
-        delete[] b[e];
-        delete[] x[e];
-    }
-    delete[] b;
-    delete[] J;
-    delete[] x;
-}
-
-basis_data::basis_data(const basis_data& other)
-: first_dofs{other.first_dofs}
-, element_ranges{other.element_ranges}
-, degree{other.degree}
-, elements{other.elements}
-, dofs{other.dofs}
-, derivatives{other.derivatives}
-, quad_order{other.quad_order}
-, elem_division{other.elem_division}
-, points{other.points}
-, basis{other.basis}
-, b{new double***[elements]}
-, x{new double*[elements]}
-, w{other.w}
-, J{new double[elements]} {
-    for (int e = 0; e < elements; ++e) {
-        x[e] = new double[quad_order];
-        b[e] = new double**[quad_order];
-
-        for (int k = 0; k < quad_order; ++k) {
-            x[e][k] = other.x[e][k];
-            b[e][k] = new double*[derivatives + 1];
-
-            for (int d = 0; d <= derivatives; ++d) {
-                b[e][k][d] = new double[degree + 1];
-
-                for (int i = 0; i < degree + 1; ++i) {
-                    b[e][k][d][i] = other.b[e][k][d][i];
-                }
-            }
-        }
-
-        J[e] = other.J[e];
-    }
-}
-
 basis_data::basis_data(bspline::basis basis, int derivatives, int quad_order, int elem_division)
 : first_dofs(bspline::first_nonzero_dofs(basis))
 , element_ranges(bspline::elements_supporting_dofs(basis))
@@ -71,14 +22,16 @@ basis_data::basis_data(bspline::basis basis, int derivatives, int quad_order, in
 , elem_division(elem_division)
 , points(elements + 1)
 , basis(std::move(basis))
-, w(quad::gauss::Ws[quad_order]) {
-    int p = basis.degree;
+, b{elements, quad_order, degree + 1, derivatives}
+, x{elements, quad_order}
+, w(quad::gauss::Ws[quad_order])
+, J(elements) {
+    int p = degree;
     int q = quad_order;
-    x = new double*[elements];
-    J = new double[elements];
-    b = new double***[elements];
 
     bspline::eval_ctx ctx(p);
+    // rows of b for a single quadrature point, filled by eval_basis_with_derivatives
+    auto rows = std::vector<double*>(static_cast<std::size_t>(derivatives + 1));
 
     // compute points of the subdivided elements
     for (int e = 0; e < this->basis.elements(); ++e) {
@@ -90,7 +43,6 @@ basis_data::basis_data(bspline::basis basis, int derivatives, int quad_order, in
     }
 
     for (int e = 0; e < elements; ++e) {
-        x[e] = new double[q];
         double x1 = points[e];
         double x2 = points[e + 1];
         J[e] = 0.5 * (x2 - x1);
@@ -101,14 +53,12 @@ basis_data::basis_data(bspline::basis basis, int derivatives, int quad_order, in
             x[e][k] = ads::lerp(t, x1, x2);
         }
 
-        b[e] = new double**[quad_order];
         for (int k = 0; k < q; ++k) {
-            b[e][k] = new double*[derivatives + 1];
             for (int d = 0; d <= derivatives; ++d) {
-                b[e][k][d] = new double[p + 1];
+                rows[d] = b.table(e, d) + k * (p + 1);
             }
             int span = find_span(x[e][k], this->basis);
-            eval_basis_with_derivatives(span, x[e][k], this->basis, b[e][k], derivatives, ctx);
+            eval_basis_with_derivatives(span, x[e][k], this->basis, rows.data(), derivatives, ctx);
         }
     }
 }
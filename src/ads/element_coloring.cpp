@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/element_coloring.hpp"
+
+#include <cassert>
+
+namespace ads {
+
+std::vector<int> color_elements(const std::vector<const basis_data*>& bases) {
+    assert(!bases.empty() && "No bases to color");
+    auto const elements = bases.front()->elements;
+    auto colors = std::vector<int>(static_cast<std::size_t>(elements));
+    // last element of each color so far
+    auto last = std::vector<int>{};
+
+    // Since first dofs of elements do not decrease, element e can share color with element f < e
+    // iff it does not overlap with the last element of that color
+    auto disjoint = [&](int f, int e) {
+        return std::all_of(begin(bases), end(bases), [&](const basis_data* basis) {
+            assert(basis->elements == elements && "Bases have different elements");
+            return basis->last_dof(f) < basis->first_dof(e);
+        });
+    };
+
+    for (int e = 0; e < elements; ++e) {
+        auto const it = std::find_if(begin(last), end(last), [&](int f) { return disjoint(f, e); });
+        auto const c = static_cast<int>(it - begin(last));
+        if (it == end(last)) {
+            last.push_back(e);
+        } else {
+            *it = e;
+        }
+        colors[static_cast<std::size_t>(e)] = c;
+    }
+    return colors;
+}
+
+}  // namespace ads
@@ -20,6 +20,10 @@ void galois_executor::thread_count(int threads) {
     galois::setActiveThreads(threads);
 }
 
+int galois_executor::thread_count() const {
+    return static_cast<int>(galois::getActiveThreads());
+}
+
 }  // namespace ads
 
 #endif  // defined(ADS_USE_GALOIS)
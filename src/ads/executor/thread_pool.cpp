@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/executor/thread_pool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <thread>
+
+namespace ads {
+
+namespace {
+
+using task_type = std::function<void()>;
+
+struct task_queue {
+    std::mutex mutex;
+    std::deque<task_type> tasks;
+};
+
+}  // namespace
+
+struct thread_pool_executor::pool {
+    std::vector<task_queue> queues;  // one per worker
+    std::vector<std::thread> workers;
+
+    std::atomic<int> queued{0};
+    std::atomic<unsigned> next_queue{0};
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stop = false;
+
+    // Pool and queue of the worker running on the current thread
+    static thread_local const pool* current;
+    static thread_local std::size_t current_queue;
+
+    explicit pool(int worker_count)
+    : queues(static_cast<std::size_t>(worker_count)) {
+        workers.reserve(queues.size());
+        for (std::size_t i = 0; i < queues.size(); ++i) {
+            workers.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    ~pool() {
+        {
+            auto const lock = std::scoped_lock{sleep_mutex};
+            stop = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    pool(const pool&) = delete;
+    pool& operator=(const pool&) = delete;
+
+    bool is_worker_thread() const { return current == this; }
+
+    void push(std::vector<task_type> tasks) {
+        auto const count = static_cast<int>(tasks.size());
+        if (is_worker_thread()) {
+            auto& queue = queues[current_queue];
+            auto const lock = std::scoped_lock{queue.mutex};
+            for (auto& task : tasks) {
+                queue.tasks.push_back(std::move(task));
+            }
+        } else {
+            // spread tasks of external threads over the queues, workers can steal them anyway
+            for (auto& task : tasks) {
+                auto& queue = queues[next_queue++ % queues.size()];
+                auto const lock = std::scoped_lock{queue.mutex};
+                queue.tasks.push_back(std::move(task));
+            }
+        }
+        queued += count;
+        {
+            // synchronizes with workers checking the condition, so that none misses the wake-up
+            auto const lock = std::scoped_lock{sleep_mutex};
+        }
+        if (count == 1) {
+            wake.notify_one();
+        } else {
+            wake.notify_all();
+        }
+    }
+
+    // Takes a task from the back of own queue of a worker, or from the front of another one
+    std::optional<task_type> take() {
+        auto const n = queues.size();
+        if (n == 0 || queued == 0) {
+            return {};
+        }
+        auto const own = is_worker_thread() ? current_queue : next_queue.load() % n;
+
+        if (is_worker_thread()) {
+            auto& queue = queues[own];
+            auto const lock = std::scoped_lock{queue.mutex};
+            if (!queue.tasks.empty()) {
+                auto task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                --queued;
+                return task;
+            }
+        }
+        for (std::size_t k = 1; k <= n; ++k) {
+            auto& queue = queues[(own + k) % n];
+            auto const lock = std::scoped_lock{queue.mutex};
+            if (!queue.tasks.empty()) {
+                auto task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                --queued;
+                return task;
+            }
+        }
+        return {};
+    }
+
+    bool run_one() {
+        if (auto task = take()) {
+            (*task)();
+            return true;
+        }
+        return false;
+    }
+
+    void work(std::size_t index) {
+        current = this;
+        current_queue = index;
+
+        while (true) {
+            if (run_one()) {
+                continue;
+            }
+            auto lock = std::unique_lock{sleep_mutex};
+            wake.wait(lock, [this] { return stop || queued > 0; });
+            if (stop && queued == 0) {
+                return;
+            }
+        }
+    }
+};
+
+thread_local const thread_pool_executor::pool* thread_pool_executor::pool::current = nullptr;
+thread_local std::size_t thread_pool_executor::pool::current_queue = 0;
+
+thread_pool_executor::thread_pool_executor(int threads) {
+    if (threads <= 0) {
+        threads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+    pool_ = std::make_unique<pool>(threads - 1);
+}
+
+thread_pool_executor::~thread_pool_executor() = default;
+
+int thread_pool_executor::thread_count() const {
+    return static_cast<int>(pool_->workers.size()) + 1;
+}
+
+void thread_pool_executor::push(std::function<void()> task) const {
+    if (pool_->workers.empty()) {
+        task();
+    } else {
+        auto tasks = std::vector<task_type>{};
+        tasks.push_back(std::move(task));
+        pool_->push(std::move(tasks));
+    }
+}
+
+void thread_pool_executor::run_chunks(int chunks, const std::function<void(int)>& body) const {
+    if (chunks <= 1 || pool_->workers.empty()) {
+        for (int chunk = 0; chunk < chunks; ++chunk) {
+            body(chunk);
+        }
+        return;
+    }
+
+    auto pending = std::atomic<int>{chunks};
+    auto error_mutex = std::mutex{};
+    auto error = std::exception_ptr{};
+
+    auto run = [&](int chunk) {
+        try {
+            body(chunk);
+        } catch (...) {
+            auto const lock = std::scoped_lock{error_mutex};
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        --pending;
+    };
+
+    auto tasks = std::vector<task_type>{};
+    tasks.reserve(static_cast<std::size_t>(chunks - 1));
+    for (int chunk = 1; chunk < chunks; ++chunk) {
+        tasks.emplace_back([&run, chunk] { run(chunk); });
+    }
+    pool_->push(std::move(tasks));
+
+    run(0);
+    while (pending > 0) {
+        run_pending_or_yield();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void thread_pool_executor::run_pending_or_yield() const {
+    if (!pool_->run_one()) {
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace ads
@@ -59,6 +59,45 @@ void advection_matrix_1d(lin::band_matrix& M, const basis_data& d) {
     }
 }
 
+// Symmetric matrices store (i, j) and (j, i) in the same place, so only entries in the upper
+// triangle are accumulated
+
+void gram_matrix_1d(lin::symmetric_band_matrix& M, const basis_data& d) {
+    for (element_id e = 0; e < d.elements; ++e) {
+        for (int q = 0; q < d.quad_order; ++q) {
+            int first = d.first_dof(e);
+            int last = d.last_dof(e);
+            for (int a = 0; a + first <= last; ++a) {
+                for (int b = a; b + first <= last; ++b) {
+                    int ia = a + first;
+                    int ib = b + first;
+                    auto va = d.b[e][q][0][a];
+                    auto vb = d.b[e][q][0][b];
+                    M(ia, ib) += va * vb * d.w[q] * d.J[e];
+                }
+            }
+        }
+    }
+}
+
+void stiffness_matrix_1d(lin::symmetric_band_matrix& M, const basis_data& d) {
+    for (element_id e = 0; e < d.elements; ++e) {
+        for (int q = 0; q < d.quad_order; ++q) {
+            int first = d.first_dof(e);
+            int last = d.last_dof(e);
+            for (int a = 0; a + first <= last; ++a) {
+                for (int b = a; b + first <= last; ++b) {
+                    int ia = a + first;
+                    int ib = b + first;
+                    auto da = d.b[e][q][1][a];
+                    auto db = d.b[e][q][1][b];
+                    M(ia, ib) += da * db * d.w[q] * d.J[e];
+                }
+            }
+        }
+    }
+}
+
 void gram_matrix_1d(lin::dense_matrix& M, const basis_data& U, const basis_data& V) {
     for (element_id e = 0; e < V.elements; ++e) {
         for (int q = 0; q < V.quad_order; ++q) {
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/lin/allocator.hpp"
+
+#ifdef __linux__
+#    include <sys/mman.h>
+#endif
+
+namespace ads::lin {
+
+bool advise_huge_pages([[maybe_unused]] void* data, [[maybe_unused]] std::size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    return madvise(data, bytes, MADV_HUGEPAGE) == 0;
+#else
+    return false;
+#endif
+}
+
+}  // namespace ads::lin
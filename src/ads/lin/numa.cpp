@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/lin/numa.hpp"
+
+#include "ads/config.hpp"
+
+#ifdef ADS_USE_NUMA
+#    include <cstdint>
+
+#    include <numa.h>
+#    include <numaif.h>
+#    include <unistd.h>
+#endif
+
+namespace ads::lin {
+
+#ifdef ADS_USE_NUMA
+
+int numa_node_count() {
+    if (numa_available() < 0) {
+        return 1;
+    }
+    return numa_num_configured_nodes();
+}
+
+bool apply_numa_placement(void* data, std::size_t bytes, const numa_placement& placement) {
+    if (placement.policy == numa_policy::first_touch || numa_available() < 0) {
+        return false;
+    }
+
+    auto const page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto const address = reinterpret_cast<std::uintptr_t>(data);
+    auto const begin = (address + page - 1) / page * page;
+    auto const end = (address + bytes) / page * page;
+    if (begin >= end) {
+        return false;
+    }
+
+    auto* const nodes = numa_allocate_nodemask();
+    if (placement.policy == numa_policy::interleave) {
+        copy_bitmask_to_bitmask(numa_all_nodes_ptr, nodes);
+    } else {
+        numa_bitmask_setbit(nodes, static_cast<unsigned int>(placement.node));
+    }
+    int const mode = placement.policy == numa_policy::interleave ? MPOL_INTERLEAVE : MPOL_BIND;
+    auto const status = mbind(reinterpret_cast<void*>(begin), end - begin, mode, nodes->maskp,
+                              nodes->size + 1, 0);
+    numa_bitmask_free(nodes);
+
+    return status == 0;
+}
+
+#else
+
+int numa_node_count() {
+    return 1;
+}
+
+bool apply_numa_placement(void* /*data*/, std::size_t /*bytes*/,
+                          const numa_placement& /*placement*/) {
+    return false;
+}
+
+#endif  // defined(ADS_USE_NUMA)
+
+}  // namespace ads::lin
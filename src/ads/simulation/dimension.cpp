@@ -3,29 +3,38 @@
 
 #include "ads/simulation/dimension.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace ads {
 
 dimension::dimension(bspline::basis b, int quad_order, int derivatives, int elem_division)
-: p{b.degree}
+: basis_data_{factorization_cache::global().basis(b, derivatives, quad_order, elem_division)}
+, mass_matrix_{factorization_cache::global().matrix(*basis_data_, matrix_kind::mass)}
+, p{b.degree}
 , elements{b.elements() * elem_division}
 , a{b.begin()}
 , b{b.end()}
-, B{std::move(b)}
-, M{p, p, B.dofs()}
-, basis(B, derivatives, quad_order, elem_division)
-, ctx{M} {
-    gram_matrix_1d(M, basis);
-}
+, B{std::move(b)} { }
 
 dimension::dimension(const dim_config& config, int derivatives)
 : dimension{bspline_basis(config), config.quad_order, derivatives} { }
 
 void dimension::fix_dof(int k) {
-    int last = dofs() - 1;
-    for (int i = clamp(k - p, 0, last); i <= clamp(k + p, 0, last); ++i) {
-        M(k, i) = 0;
+    if (std::find(begin(fixed_), end(fixed_), k) == end(fixed_)) {
+        fixed_.push_back(k);
+    }
+    if (update_) {
+        update_->fix_dof(k);
+    }
+}
+
+void dimension::factorize_matrix() {
+    factors_ = factorization_cache::global().factorized(basis(), matrix_kind::mass);
+    update_.emplace(*mass_matrix_, factors_->M, factors_->ctx);
+    for (int k : fixed_) {
+        update_->fix_dof(k);
     }
-    M(k, k) = 1;
 }
 
 }  // namespace ads
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/simulation/factorization_cache.hpp"
+
+#include "ads/form_matrix.hpp"
+#include "ads/lin/band_solve.hpp"
+
+namespace ads {
+
+factorization_cache& factorization_cache::global() {
+    static factorization_cache cache;
+    return cache;
+}
+
+std::shared_ptr<const basis_data> factorization_cache::basis(const bspline::basis& B,
+                                                             int derivatives, int quad_order,
+                                                             int elem_division) {
+    auto key = basis_key{B.knot, B.degree, quad_order, derivatives, elem_division};
+    auto const lock = std::scoped_lock{mutex_};
+
+    auto& entry = bases_[std::move(key)];
+    if (entry) {
+        ++hits_;
+    } else {
+        ++misses_;
+        entry = std::make_shared<const basis_data>(B, derivatives, quad_order, elem_division);
+    }
+    return entry;
+}
+
+std::shared_ptr<const lin::band_matrix> factorization_cache::matrix(const basis_data& basis,
+                                                                    matrix_kind kind) {
+    auto const lock = std::scoped_lock{mutex_};
+    return matrix_unlocked(basis, kind);
+}
+
+std::shared_ptr<const factorized_matrix> factorization_cache::factorized(const basis_data& basis,
+                                                                         matrix_kind kind) {
+    auto const lock = std::scoped_lock{mutex_};
+
+    auto& entry = factorizations_[key_of(basis, kind)];
+    if (entry) {
+        ++hits_;
+    } else {
+        auto const M = matrix_unlocked(basis, kind);
+        ++misses_;
+        auto factors = factorized_matrix{*M, lin::solver_ctx{*M}};
+        lin::factorize(factors.M, factors.ctx);
+        entry = std::make_shared<const factorized_matrix>(std::move(factors));
+    }
+    return entry;
+}
+
+void factorization_cache::clear() {
+    auto const lock = std::scoped_lock{mutex_};
+    bases_.clear();
+    matrices_.clear();
+    factorizations_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+int factorization_cache::hits() const {
+    auto const lock = std::scoped_lock{mutex_};
+    return hits_;
+}
+
+int factorization_cache::misses() const {
+    auto const lock = std::scoped_lock{mutex_};
+    return misses_;
+}
+
+factorization_cache::matrix_key factorization_cache::key_of(const basis_data& basis,
+                                                            matrix_kind kind) {
+    return {basis.basis.knot, basis.degree, basis.quad_order, basis.elem_division, kind};
+}
+
+std::shared_ptr<const lin::band_matrix> factorization_cache::matrix_unlocked(
+    const basis_data& basis, matrix_kind kind) {
+    auto& entry = matrices_[key_of(basis, kind)];
+    if (entry) {
+        ++hits_;
+    } else {
+        ++misses_;
+        auto M = lin::band_matrix{basis.degree, basis.degree, basis.dofs};
+        if (kind == matrix_kind::mass) {
+            gram_matrix_1d(M, basis);
+        } else {
+            stiffness_matrix_1d(M, basis);
+        }
+        entry = std::make_shared<const lin::band_matrix>(std::move(M));
+    }
+    return entry;
+}
+
+}  // namespace ads
@@ -15,7 +15,6 @@ simulation_2d::simulation_2d(const config_2d& config)
 simulation_2d::simulation_2d(const dimension& x, const dimension& y, const timesteps_config& steps)
 : simulation_base{steps}
 , x{x}
-, y{y}
-, buffer{shape()} { }
+, y{y} { }
 
 }  // namespace ads
@@ -18,7 +18,6 @@ simulation_3d::simulation_3d(const dimension& x, const dimension& y, const dimen
 : simulation_base{steps}
 , x{x}
 , y{y}
-, z{z}
-, buffer{shape()} { }
+, z{z} { }
 
 }  // namespace ads
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/simulation/simulation_4d.hpp"
+
+namespace ads {
+
+simulation_4d::simulation_4d(const config_4d& config)
+: simulation_4d{
+    dimension{config.x, config.derivatives},
+    dimension{config.y, config.derivatives},
+    dimension{config.z, config.derivatives},
+    dimension{config.t, config.derivatives},
+    config.steps,
+} { }
+
+simulation_4d::simulation_4d(const dimension& x, const dimension& y, const dimension& z,
+                             const dimension& t, const timesteps_config& steps)
+: simulation_base{steps}
+, x{x}
+, y{y}
+, z{z}
+, t{t} { }
+
+}  // namespace ads
@@ -6,6 +6,7 @@
 #include <catch2/catch_all.hpp>
 
 #include "ads/bspline/bspline.hpp"
+#include "ads/bspline/eval.hpp"
 
 TEST_CASE("basis_data memory management") {
     auto basis = ads::bspline::create_basis(0.0, 1.0, 2, 5);
@@ -36,3 +37,44 @@ TEST_CASE("basis_data memory management") {
         REQUIRE(data.elem_division == data2.elem_division);
     }
 }
+
+TEST_CASE("basis_data values layout") {
+    auto basis = ads::bspline::create_basis(0.0, 1.0, 2, 5);
+    auto data = ads::basis_data{basis, 2};
+    auto ctx = ads::bspline::eval_ctx{basis.degree};
+
+    auto const n = data.dofs_per_element();
+    auto const e = 3;
+
+    SECTION("indexing agrees with tables") {
+        for (int d = 0; d <= data.derivatives; ++d) {
+            auto const* const table = data.b.table(e, d);
+            for (int q = 0; q < data.quad_order; ++q) {
+                for (int a = 0; a < n; ++a) {
+                    CHECK(data.b[e][q][d][a] == table[q * n + a]);
+                }
+            }
+        }
+    }
+
+    SECTION("values match basis functions") {
+        auto const q = 1;
+        auto const x = data.x[e][q];
+        for (int a = 0; a < n; ++a) {
+            auto const dof = data.first_dof(e) + a;
+            auto const u = [dof](int i) { return i == dof ? 1.0 : 0.0; };
+            auto const value = ads::bspline::eval(x, u, basis, ctx);
+            CHECK(data.b[e][q][0][a] == Catch::Approx(value));
+        }
+    }
+
+    SECTION("copies own their values") {
+        auto const value = data.b[e][1][2][1];
+        auto const point = data.x[e][1];
+
+        auto copy = data;
+        data = ads::basis_data{ads::bspline::create_basis(0.0, 1.0, 1, 6), 1};
+        CHECK(copy.b[e][1][2][1] == value);
+        CHECK(copy.x[e][1] == point);
+    }
+}
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/element_coloring.hpp"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/basis_data.hpp"
+#include "ads/bspline/bspline.hpp"
+#include "ads/executor/sequential.hpp"
+
+namespace {
+
+using index_type = std::array<int, 2>;
+using bases_type = std::array<const ads::basis_data*, 2>;
+
+bool share_dofs(const bases_type& bases, index_type e, index_type f) {
+    for (std::size_t i = 0; i < 2; ++i) {
+        auto const& b = *bases[i];
+        if (b.last_dof(e[i]) < b.first_dof(f[i]) || b.last_dof(f[i]) < b.first_dof(e[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that each element has exactly one color, and elements of one color share no dofs
+void check_coloring(const ads::element_coloring<2>& coloring,
+                    const std::vector<bases_type>& spaces) {
+    auto const& bases = spaces.front();
+    auto const elements = bases[0]->elements * bases[1]->elements;
+    auto count = std::vector<int>(static_cast<std::size_t>(elements));
+
+    for (int c = 0; c < coloring.colors(); ++c) {
+        auto previous = std::vector<index_type>{};
+        for (std::ptrdiff_t i = 0; i < coloring.size(c); ++i) {
+            auto const e = coloring.element(c, i);
+            CHECK(coloring.color(e) == c);
+            ++count[static_cast<std::size_t>(e[0] + e[1] * bases[0]->elements)];
+
+            for (auto const& f : previous) {
+                for (auto const& space : spaces) {
+                    CHECK_FALSE(share_dofs(space, e, f));
+                }
+            }
+            previous.push_back(e);
+        }
+    }
+    for (auto n : count) {
+        CHECK(n == 1);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Element coloring", "[assembly]") {
+    auto const bx = ads::basis_data{ads::bspline::create_basis(0.0, 1.0, 2, 7), 1};
+    auto const by = ads::basis_data{ads::bspline::create_basis(0.0, 1.0, 3, 9), 1};
+    auto const bases = bases_type{&bx, &by};
+
+    SECTION("spline space with maximal continuity") {
+        auto const coloring = ads::element_coloring<2>{bases};
+        CHECK(coloring.colors() == 3 * 4);
+        check_coloring(coloring, {bases});
+    }
+
+    SECTION("C0 space") {
+        auto const cx = ads::basis_data{ads::bspline::create_basis_C0(0.0, 1.0, 2, 7), 1};
+        auto const cy = ads::basis_data{ads::bspline::create_basis_C0(0.0, 1.0, 3, 9), 1};
+        auto const coloring = ads::element_coloring<2>{{&cx, &cy}};
+        CHECK(coloring.colors() == 2 * 2);
+        check_coloring(coloring, {{&cx, &cy}});
+    }
+
+    SECTION("subdivided elements") {
+        auto const sx = ads::basis_data{ads::bspline::create_basis(0.0, 1.0, 2, 7), 1, 3, 2};
+        auto const coloring = ads::element_coloring<2>{{&sx, &by}};
+        check_coloring(coloring, {{&sx, &by}});
+    }
+
+    SECTION("several spaces") {
+        auto const cx = ads::basis_data{ads::bspline::create_basis_C0(0.0, 1.0, 1, 7), 1};
+        auto const coloring = ads::element_coloring<2>{bases, {&cx, &by}};
+        check_coloring(coloring, {bases, {&cx, &by}});
+    }
+
+    SECTION("visits each element once") {
+        auto const coloring = ads::element_coloring<2>{bases};
+        auto visits = std::vector<int>(static_cast<std::size_t>(bx.elements * by.elements));
+        ads::for_each_colored(coloring, ads::sequential_executor{}, [&](index_type e) {
+            ++visits[static_cast<std::size_t>(e[0] + e[1] * bx.elements)];
+        });
+        for (auto n : visits) {
+            CHECK(n == 1);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/executor/per_thread.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/executor/sequential.hpp"
+
+TEST_CASE("Per-thread objects", "[executor]") {
+    auto const plus = [](int& a, int b) { a += b; };
+    auto const executor = ads::sequential_executor{};
+
+    SECTION("are created lazily") {
+        auto counts = ads::per_thread<int>{[] { return 10; }};
+        CHECK(counts.size() == 0);
+
+        int result = 1;
+        counts.reduce(result, executor, plus);
+        CHECK(result == 1);
+
+        counts.local() += 1;
+        counts.local() += 2;
+        CHECK(counts.size() == 1);
+        CHECK(counts.local() == 13);
+    }
+
+    SECTION("are separate for each thread") {
+        constexpr int threads = 7;
+        constexpr int n = 1000;
+        auto counts = ads::per_thread<int>{};
+        // keeps all the threads alive until each one is done, so that their ids are distinct
+        auto done = std::atomic<int>{0};
+
+        auto workers = std::vector<std::thread>{};
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&counts, &done, t] {
+                for (int i = 0; i < n; ++i) {
+                    counts.local() += t;
+                }
+                ++done;
+                while (done < threads) {
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        CHECK(counts.size() == threads);
+
+        int result = 0;
+        counts.reduce(result, executor, plus);
+        CHECK(result == n * threads * (threads - 1) / 2);
+    }
+
+    SECTION("do not share cached objects") {
+        auto a = ads::per_thread<int>{};
+        auto b = ads::per_thread<int>{};
+        a.local() = 1;
+        b.local() = 2;
+        CHECK(a.local() == 1);
+        CHECK(b.local() == 2);
+    }
+}
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/executor/thread_pool.hpp"
+
+#include <array>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/range/counting_range.hpp>
+#include <catch2/catch_all.hpp>
+
+#include "ads/executor/per_thread.hpp"
+#include "ads/util/iter/product.hpp"
+
+TEST_CASE("Thread pool executor", "[executor]") {
+    auto const threads = GENERATE(1, 2, 5);
+    auto const executor = ads::thread_pool_executor{threads};
+    CHECK(executor.thread_count() == threads);
+
+    SECTION("for_each visits each item once") {
+        constexpr int n = 1000;
+        auto visits = std::vector<std::atomic<int>>(n);
+        executor.for_each(boost::counting_range(0, n), [&](int i) { ++visits[i]; });
+        for (auto const& v : visits) {
+            CHECK(v == 1);
+        }
+    }
+
+    SECTION("for_each works with ranges without random access") {
+        using index = std::array<int, 2>;
+        auto const range = ads::util::product_range<index>(boost::counting_range(0, 7),
+                                                            boost::counting_range(0, 9));
+        auto sum = std::atomic<int>{0};
+        executor.for_each(range, [&](index i) { sum += i[0] * i[1]; });
+        CHECK(sum == 21 * 36);
+    }
+
+    SECTION("for_each can be nested") {
+        auto count = std::atomic<int>{0};
+        executor.for_each(boost::counting_range(0, 10), [&](int) {
+            executor.for_each(boost::counting_range(0, 10), [&](int) { ++count; });
+        });
+        CHECK(count == 100);
+    }
+
+    SECTION("for_each handles empty ranges") {
+        auto count = std::atomic<int>{0};
+        executor.for_each(boost::counting_range(0, 0), [&](int) { ++count; });
+        CHECK(count == 0);
+    }
+
+    SECTION("synchronized excludes other threads") {
+        int count = 0;
+        executor.for_each(boost::counting_range(0, 1000),
+                          [&](int) { executor.synchronized([&] { ++count; }); });
+        CHECK(count == 1000);
+    }
+
+    SECTION("exceptions of the loop body are rethrown") {
+        auto const loop = [&] {
+            executor.for_each(boost::counting_range(0, 100), [](int i) {
+                if (i == 57) {
+                    throw std::runtime_error{"error"};
+                }
+            });
+        };
+        CHECK_THROWS_AS(loop(), std::runtime_error);
+    }
+
+    SECTION("parallel_reduce combines results in order") {
+        auto const sum = executor.parallel_reduce(
+            boost::counting_range(1, 1001), 0L, [](int i) { return long{i}; },
+            [](long a, long b) { return a + b; });
+        CHECK(sum == 500500);
+
+        auto const digits = executor.parallel_reduce(
+            boost::counting_range(0, 10), std::string{}, [](int i) { return std::to_string(i); },
+            [](std::string a, const std::string& b) { return a + b; });
+        CHECK(digits == "0123456789");
+    }
+
+    SECTION("submitted tasks are run") {
+        auto futures = std::vector<std::future<int>>{};
+        for (int i = 0; i < 20; ++i) {
+            futures.push_back(executor.submit([i] { return i * i; }));
+        }
+        for (int i = 0; i < 20; ++i) {
+            CHECK(futures[static_cast<std::size_t>(i)].get() == i * i);
+        }
+    }
+
+    SECTION("tasks can wait for other tasks") {
+        auto outer = executor.submit([&] {
+            auto inner = executor.submit([] { return 2; });
+            executor.wait(inner);
+            return inner.get() + 1;
+        });
+        executor.wait(outer);
+        CHECK(outer.get() == 3);
+    }
+
+    SECTION("per-thread objects have one instance per thread") {
+        auto partial = ads::per_thread<int>{};
+        executor.for_each(boost::counting_range(0, 1000), [&](int i) { partial.local() += i; });
+        CHECK(partial.size() <= static_cast<std::size_t>(threads));
+
+        int total = 0;
+        partial.reduce(total, executor, [](int& a, int b) { a += b; });
+        CHECK(total == 999 * 1000 / 2);
+    }
+}
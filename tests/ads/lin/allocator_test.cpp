@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/lin/allocator.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/dense_matrix.hpp"
+#include "ads/lin/tensor.hpp"
+
+namespace lin = ads::lin;
+
+namespace {
+
+auto is_aligned(const void* data, std::size_t alignment) -> bool {
+    return reinterpret_cast<std::uintptr_t>(data) % alignment == 0;
+}
+
+}  // namespace
+
+TEST_CASE("Aligned allocator", "[lin]") {
+    SECTION("Tensors and matrices are aligned") {
+        auto const t = lin::tensor<double, 3>{{3, 5, 7}};
+        CHECK(is_aligned(t.data(), lin::default_alignment));
+
+        auto const a = lin::dense_matrix{3, 5};
+        CHECK(is_aligned(a.data(), lin::default_alignment));
+
+        auto const b = lin::band_matrix{1, 2, 7};
+        CHECK(is_aligned(b.full_buffer(), lin::default_alignment));
+    }
+
+    SECTION("Matrices are zero-initialized") {
+        auto const a = lin::dense_matrix{4, 3};
+        for (int i = 0; i < a.size(); ++i) {
+            CHECK(a.data()[i] == 0);
+        }
+
+        auto const b = lin::band_matrix{2, 1, 6};
+        for (int i = 0; i < 6; ++i) {
+            for (int j = 0; j < 6; ++j) {
+                CHECK(b(i, j) == 0);
+            }
+        }
+    }
+
+    SECTION("Large blocks are aligned to huge pages") {
+        auto const n = 3 * lin::huge_page_size / sizeof(double) / 2;
+        auto v = std::vector<double, lin::huge_page_allocator<double>>(n, 1.0);
+        CHECK(is_aligned(v.data(), lin::huge_page_size));
+        CHECK(v.back() == 1.0);
+
+        auto const t = lin::tensor<double, 2, lin::huge_page_allocator<double>>{{1024, 512}};
+        CHECK(is_aligned(t.data(), lin::huge_page_size));
+        CHECK(t(1023, 511) == 0);
+    }
+
+    SECTION("Small blocks use requested alignment") {
+        auto v = std::vector<float, lin::aligned_allocator<float, 128, true>>(10);
+        CHECK(is_aligned(v.data(), 128));
+    }
+}
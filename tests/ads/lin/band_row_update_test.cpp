@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/lin/band_row_update.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/executor/sequential.hpp"
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/band_solve.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/solver.hpp"
+
+namespace lin = ads::lin;
+
+namespace {
+
+auto make_matrix(int kl, int ku, int n) -> lin::band_matrix {
+    auto m = lin::band_matrix{kl, ku, n};
+    for (int i = 0; i < n; ++i) {
+        for (int j = std::max(0, i - kl); j < std::min(n, i + ku + 1); ++j) {
+            m(i, j) = i == j ? 10.0 + i : 1.0 / (1 + i + 2 * j);
+        }
+    }
+    return m;
+}
+
+// Mass matrix of the dimension with rows of given dofs replaced by rows of identity, factorized
+struct fixed_dimension {
+    lin::band_matrix M;
+    lin::solver_ctx ctx;
+
+    fixed_dimension(const ads::dimension& dim, std::initializer_list<int> dofs)
+    : M{dim.mass_matrix()}
+    , ctx{M} {
+        for (int k : dofs) {
+            for (int j = std::max(0, k - M.kl); j <= std::min(M.cols - 1, k + M.ku); ++j) {
+                M(k, j) = 0;
+            }
+            M(k, k) = 1;
+        }
+        lin::factorize(M, ctx);
+    }
+
+    ads::dim_data data() const { return {M, ctx}; }
+};
+
+auto fill(int size) -> std::vector<double> {
+    auto v = std::vector<double>(size);
+    for (int i = 0; i < size; ++i) {
+        v[i] = (i * 37 % 11) - 5.0;
+    }
+    return v;
+}
+
+}  // namespace
+
+TEST_CASE("Band matrix with replaced rows") {
+    int const kl = 2;
+    int const ku = 1;
+    int const n = 9;
+    int const count = 4;
+
+    auto const A = make_matrix(kl, ku, n);
+    auto factors = A;
+    auto ctx = lin::solver_ctx{factors};
+    lin::factorize(factors, ctx);
+
+    auto update = lin::band_row_update{A, factors, ctx};
+
+    // reference - matrix with the same rows replaced, factorized from scratch
+    auto B = A;
+    auto fix = [&](int k) {
+        for (int j = std::max(0, k - kl); j < std::min(n, k + ku + 1); ++j) {
+            B(k, j) = 0;
+        }
+        B(k, k) = 1;
+        update.fix_dof(k);
+    };
+    fix(0);
+    fix(n - 1);
+
+    auto row = std::vector<double>(n);
+    row[2] = 2;
+    row[3] = -1;
+    row[4] = 3;
+    B(4, 2) = 2;
+    B(4, 3) = -1;
+    B(4, 4) = 3;
+    B(4, 5) = 0;
+    update.replace_row(4, row);
+
+    auto B_ctx = lin::solver_ctx{B};
+    lin::factorize(B, B_ctx);
+
+    SECTION("contiguous right-hand sides") {
+        auto b = fill(n * count);
+        auto expected = b;
+        lin::solve_with_factorized(B, expected.data(), B_ctx, count);
+        lin::solve_with_factorized(update, b.data(), ctx, count);
+
+        CHECK(update.rank() == 3);
+        CHECK_THAT(b, Catch::Matchers::Approx(expected).margin(1e-12));
+    }
+
+    SECTION("interleaved right-hand sides") {
+        int const stride = count + 1;
+        auto b = fill(n * stride);
+        auto expected = b;
+        lin::solve_with_factorized_strided(B, expected.data(), B_ctx, count, stride);
+        lin::solve_with_factorized_strided(update, b.data(), ctx, count, stride);
+
+        CHECK_THAT(b, Catch::Matchers::Approx(expected).margin(1e-12));
+    }
+
+    SECTION("more right-hand sides than fit in one block") {
+        int const many = 2 * lin::band_row_update::scratch_size / update.rank() + 5;
+        auto b = fill(n * many);
+        auto expected = b;
+        lin::solve_with_factorized(B, expected.data(), B_ctx, many);
+        lin::solve_with_factorized(update, b.data(), ctx, many);
+        CHECK_THAT(b, Catch::Matchers::Approx(expected).margin(1e-12));
+
+        auto c = fill(n * many);
+        auto c_expected = c;
+        lin::solve_with_factorized_strided(B, c_expected.data(), B_ctx, many, many);
+        lin::solve_with_factorized_strided(update, c.data(), ctx, many, many);
+        CHECK_THAT(c, Catch::Matchers::Approx(c_expected).margin(1e-12));
+    }
+
+    SECTION("reset restores the original matrix") {
+        update.reset();
+        auto b = fill(n);
+        auto expected = b;
+        lin::solve_with_factorized(factors, expected.data(), ctx, 1);
+        lin::solve_with_factorized(update, b.data(), ctx, 1);
+
+        CHECK(update.rank() == 0);
+        CHECK(b == expected);
+    }
+}
+
+TEST_CASE("Singular band matrix with replaced rows") {
+    int const n = 5;
+    auto A = lin::band_matrix{1, 1, n};
+    for (int i = 0; i < n; ++i) {
+        A(i, i) = 2;
+    }
+    auto factors = A;
+    auto ctx = lin::solver_ctx{factors};
+    lin::factorize(factors, ctx);
+
+    auto update = lin::band_row_update{A, factors, ctx};
+    CHECK_THROWS_AS(update.replace_row(2, std::vector<double>(n)), std::runtime_error);
+}
+
+TEST_CASE("Row update of a dimension") {
+    auto x = ads::dimension{ads::dim_config{2, 8}, 1};
+    CHECK_THROWS_AS(x.row_update(), std::logic_error);
+
+    x.fix_left();
+    x.factorize_matrix();
+    auto update = x.row_update();
+    update.fix_dof(x.dofs() - 1);
+
+    CHECK(x.data().M.rank() == 1);
+    CHECK(update.rank() == 2);
+}
+
+TEST_CASE("ADS with boundary conditions as row updates") {
+    auto make_dimension = [](int p, int elements) {
+        auto dim = ads::dimension{ads::dim_config{p, elements}, 1};
+        dim.factorize_matrix();
+        return dim;
+    };
+    auto x = make_dimension(2, 8);
+    auto y = make_dimension(3, 6);
+
+    auto const x_fixed = fixed_dimension{x, {0, x.dofs() - 1}};
+    auto const y_fixed = fixed_dimension{y, {0}};
+
+    auto x_update = x.row_update();
+    x_update.fix_dof(0);
+    x_update.fix_dof(x.dofs() - 1);
+
+    auto y_update = y.row_update();
+    y_update.fix_dof(0);
+
+    auto rhs = lin::tensor<double, 2>{{x.dofs(), y.dofs()}};
+    auto const values = fill(ads::narrow_cast<int>(rhs.size()));
+    std::copy(begin(values), end(values), rhs.data());
+    auto expected = rhs;
+    auto buf = lin::tensor<double, 2>{rhs.sizes()};
+
+    ads_solve(expected, buf, x_fixed.data(), y_fixed.data());
+
+    SECTION("transposing") {
+        ads_solve(rhs, buf, x.data(x_update), y.data(y_update));
+        CHECK(approx_equal(rhs, expected, 1e-9));
+    }
+
+    SECTION("transpose-free") {
+        ads_solve(rhs, x.data(x_update), y.data(y_update));
+        CHECK(approx_equal(rhs, expected, 1e-9));
+    }
+
+    SECTION("dofs fixed in dimensions") {
+        x.fix_left();
+        x.fix_right();
+        y.fix_left();
+        ads_solve(rhs, buf, x.data(), y.data());
+        CHECK(approx_equal(rhs, expected, 1e-9));
+    }
+}
+
+TEST_CASE("1D parallel ADS with boundary conditions as row updates") {
+    auto x = ads::dimension{ads::dim_config{2, 40}, 1};
+    x.factorize_matrix();
+    auto update = x.row_update();
+    update.fix_dof(0);
+
+    auto const x_fixed = fixed_dimension{x, {0}};
+
+    auto rhs = lin::vector{{x.dofs()}};
+    auto const values = fill(x.dofs());
+    std::copy(begin(values), end(values), rhs.data());
+    auto expected = rhs;
+    ads_solve(expected, x_fixed.data());
+
+    auto const executor = ads::sequential_executor{};
+    ads_solve(ads::parallel_sweep{executor}, rhs, x.data(update));
+    CHECK(approx_equal(rhs, expected, 1e-9));
+}
@@ -4,10 +4,14 @@
 #include "ads/lin/band_solve.hpp"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch_all.hpp>
 
 #include "ads/lin/band_matrix.hpp"
+#include "ads/lin/lapack.hpp"
+#include "ads/lin/symmetric_band_matrix.hpp"
 #include "ads/lin/tensor.hpp"
 
 namespace lin = ads::lin;
@@ -45,6 +49,44 @@ TEST_CASE("Banded matrix") {
         CHECK(approx_equal(x, b, 1e-5));
     }
 
+    SECTION("Solver for interleaved right-hand sides") {
+        int kl = 2;
+        int ku = 1;
+        int n = 7;
+        int count = 5;
+        int stride = 6;
+
+        // large subdiagonal entries force row interchanges
+        lin::band_matrix m(kl, ku, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = std::max(0, i - kl); j < std::min(n, i + ku + 1); ++j) {
+                m(i, j) = (i == j) ? 1 + i : (i - j) * 5 + j;
+            }
+        }
+        lin::solver_ctx ctx(m);
+        lin::factorize(m, ctx);
+
+        lin::matrix b({n, count});
+        std::vector<double> interleaved(n * stride, -1);
+        for (int i = 0; i < n; ++i) {
+            for (int r = 0; r < count; ++r) {
+                b(i, r) = (i * 7 + r * 3) % 5 - 2;
+                interleaved[r + i * stride] = b(i, r);
+            }
+        }
+
+        lin::solve_with_factorized(m, b, ctx);
+        lin::solve_with_factorized_strided(m, interleaved.data(), ctx, count, stride);
+
+        for (int i = 0; i < n; ++i) {
+            for (int r = 0; r < count; ++r) {
+                CHECK(interleaved[r + i * stride] == Catch::Approx(b(i, r)));
+            }
+            // padding between the lines is not touched
+            CHECK(interleaved[count + i * stride] == -1);
+        }
+    }
+
     SECTION("Vector multiplication") {
         ads::lin::band_matrix A{1, 1, 4, 3};
         A(0, 0) = A(1, 1) = A(2, 2) = A(3, 2) = 1;
@@ -57,3 +99,155 @@ TEST_CASE("Banded matrix") {
         CHECK_THAT(y, Catch::Matchers::Approx(expected));
     }
 }
+
+TEST_CASE("Banded matrix kernels specialized for band width") {
+    auto const p = GENERATE(1, 2, 3, 4, 5);
+    auto const n = 23;
+
+    // entries below the diagonal force row interchanges
+    lin::band_matrix m(p, p, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = std::max(0, i - p); j < std::min(n, i + p + 1); ++j) {
+            m(i, j) = (i == j) ? 1 + i % 3 : ((i * 7 + j * 3) % 11) - 2.5;
+        }
+    }
+    auto const original = m;
+
+    // reference factorization and solution computed by LAPACK
+    auto lapack = m;
+    lin::solver_ctx lapack_ctx(lapack);
+    dgbtrf_(&lapack.rows, &lapack.cols, &lapack.kl, &lapack.ku, lapack.full_buffer(),
+            &lapack_ctx.lda, lapack_ctx.pivot(), &lapack_ctx.info);
+
+    lin::solver_ctx ctx(m);
+    lin::factorize(m, ctx);
+
+    CHECK(ctx.info == 0);
+    CHECK(ctx.pivot_vector == lapack_ctx.pivot_vector);
+
+    auto const solve_lapack = [&](lin::matrix& b) {
+        int nrhs = b.size(1);
+        int info = 0;
+        dgbtrs_("N", &n, &p, &p, &nrhs, lapack.full_buffer(), &lapack_ctx.lda, lapack_ctx.pivot(),
+                b.data(), &n, &info);
+    };
+
+    auto const make_rhs = [&](int nrhs) {
+        lin::matrix b({n, nrhs});
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < nrhs; ++j) {
+                b(i, j) = ((i + 1) * (j + 2) % 13) - 6;
+            }
+        }
+        return b;
+    };
+
+    SECTION("single right-hand side") {
+        auto b = make_rhs(1);
+        auto expected = b;
+        solve_lapack(expected);
+
+        lin::solve_with_factorized(m, b, ctx);
+        CHECK(approx_equal(b, expected, 1e-10));
+    }
+
+    SECTION("right-hand sides spanning multiple blocks") {
+        auto const nrhs = 2 * lin::detail::strided_solve_block_width(n) + 3;
+        auto b = make_rhs(nrhs);
+        auto expected = b;
+        solve_lapack(expected);
+
+        lin::solve_with_factorized(m, b, ctx);
+        CHECK(approx_equal(b, expected, 1e-10));
+    }
+
+    SECTION("multiplication by the factorized matrix") {
+        auto const nrhs = 3;
+        auto b = make_rhs(nrhs);
+        lin::matrix expected({n, nrhs});
+        for (int r = 0; r < nrhs; ++r) {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    expected(i, r) += original(i, j) * b(j, r);
+                }
+            }
+        }
+
+        lin::detail::dispatch_band(m, [&](auto band) {
+            auto const factors = lin::detail::factors_of(m, ctx);
+            for (int r = 0; r < nrhs; ++r) {
+                lin::detail::multiply_factorized_strided(factors, b.data() + r * n, 1, 1, band);
+            }
+        });
+        CHECK(approx_equal(b, expected, 1e-10));
+    }
+}
+
+TEST_CASE("Symmetric band matrix") {
+    SECTION("Entries are shared with the transposed position") {
+        lin::symmetric_band_matrix m(2, 5);
+        m(1, 3) = 7;
+        m(4, 2) = -2;
+
+        CHECK(m(3, 1) == 7);
+        CHECK(m(2, 4) == -2);
+        CHECK(std::as_const(m)(0, 4) == 0);
+    }
+
+    SECTION("Cholesky solver") {
+        // kd = 6 exceeds the width of specialized kernels, LAPACK is used
+        auto const kd = GENERATE(1, 2, 3, 6);
+        auto const n = 19;
+
+        // diagonally dominant, hence positive definite
+        lin::band_matrix general(kd, kd, n);
+        lin::symmetric_band_matrix m(kd, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = std::max(0, i - kd); j <= i; ++j) {
+                auto const val = (i == j) ? 4.0 * kd + i % 3 : ((i + 2 * j) % 5) - 2.0;
+                general(i, j) = general(j, i) = val;
+                m(i, j) = val;
+            }
+        }
+        lin::solver_ctx general_ctx(general);
+        lin::factorize(general, general_ctx);
+
+        lin::solver_ctx ctx(m);
+        lin::factorize(m, ctx);
+
+        CHECK(ctx.info == 0);
+        CHECK(ctx.pivot_vector.empty());
+
+        auto const nrhs = 2 * lin::detail::strided_solve_block_width(n) + 3;
+        lin::matrix b({n, nrhs});
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < nrhs; ++j) {
+                b(i, j) = ((i + 1) * (j + 2) % 13) - 6;
+            }
+        }
+        auto expected = b;
+        lin::solve_with_factorized(general, expected, general_ctx);
+
+        SECTION("contiguous right-hand sides") {
+            lin::solve_with_factorized(m, b, ctx);
+            CHECK(approx_equal(b, expected, 1e-10));
+        }
+
+        SECTION("interleaved right-hand sides") {
+            auto interleaved = lin::matrix({nrhs, n});
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < nrhs; ++j) {
+                    interleaved(j, i) = b(i, j);
+                }
+            }
+            lin::solve_with_factorized_strided(m, interleaved.data(), ctx, nrhs, nrhs);
+
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < nrhs; ++j) {
+                    b(i, j) = interleaved(j, i);
+                }
+            }
+            CHECK(approx_equal(b, expected, 1e-10));
+        }
+    }
+}
@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/lin/fast_diagonalization.hpp"
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/lin/dense_matrix.hpp"
+#include "ads/lin/symmetric_band_matrix.hpp"
+#include "ads/lin/tensor.hpp"
+
+namespace lin = ads::lin;
+
+using Catch::Matchers::Approx;
+using kf = lin::kron_factor;
+
+namespace {
+
+// Tridiagonal matrices resembling 1D mass and stiffness matrices of linear B-splines
+auto mass(int n) -> lin::symmetric_band_matrix {
+    auto M = lin::symmetric_band_matrix{1, n};
+    for (int i = 0; i < n; ++i) {
+        M(i, i) = 4 + 0.1 * i;
+        if (i > 0) {
+            M(i - 1, i) = 1;
+        }
+    }
+    return M;
+}
+
+auto stiffness(int n) -> lin::symmetric_band_matrix {
+    auto K = lin::symmetric_band_matrix{1, n};
+    for (int i = 0; i < n; ++i) {
+        K(i, i) = 2 + 0.2 * (i % 3);
+        if (i > 0) {
+            K(i - 1, i) = -1;
+        }
+    }
+    return K;
+}
+
+auto to_vector(const lin::tensor<double, 2>& a) -> std::vector<double> {
+    return {a.data(), a.data() + a.size()};
+}
+
+auto to_vector(const lin::tensor<double, 3>& a) -> std::vector<double> {
+    return {a.data(), a.data() + a.size()};
+}
+
+}  // namespace
+
+TEST_CASE("Generalized eigenbasis") {
+    auto const n = 6;
+    auto const M = mass(n);
+    auto const K = stiffness(n);
+    auto const basis = lin::generalized_eigenbasis{M, K};
+
+    REQUIRE(basis.info == 0);
+
+    auto const& V = basis.vectors();
+    auto const& lambda = basis.values();
+
+    // V^T M V = I, V^T K V = Lambda
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double vmv = 0;
+            double vkv = 0;
+            for (int k = 0; k < n; ++k) {
+                for (int l = 0; l < n; ++l) {
+                    vmv += V(k, i) * M(k, l) * V(l, j);
+                    vkv += V(k, i) * K(k, l) * V(l, j);
+                }
+            }
+            CHECK(vmv == Catch::Approx(i == j ? 1.0 : 0.0).margin(1e-12));
+            CHECK(vkv == Catch::Approx(i == j ? lambda[i] : 0.0).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("Fast diagonalization solver") {
+    SECTION("2D Kronecker sum") {
+        auto const nx = 5;
+        auto const ny = 4;
+        auto const Mx = mass(nx);
+        auto const Kx = stiffness(nx);
+        auto const My = mass(ny);
+        auto const Ky = stiffness(ny);
+
+        auto const cx = 0.3;
+        auto const cy = 2.0;
+        auto const terms = std::vector<lin::kronecker_term<2>>{
+            {1.0, {kf::mass, kf::mass}},
+            {cx, {kf::stiffness, kf::mass}},
+            {cy, {kf::mass, kf::stiffness}},
+        };
+        auto const solver = lin::fast_diagonalization_solver<2>{
+            {lin::generalized_eigenbasis{Mx, Kx}, lin::generalized_eigenbasis{My, Ky}}, terms};
+
+        auto u = lin::tensor<double, 2>{{nx, ny}};
+        for (int i = 0; i < u.size(); ++i) {
+            u.data()[i] = (i * 7 % 5) - 1.5;
+        }
+
+        // f = (M (x) M + cx K (x) M + cy M (x) K) u
+        auto f = lin::tensor<double, 2>{{nx, ny}};
+        for (int i = 0; i < nx; ++i) {
+            for (int j = 0; j < ny; ++j) {
+                double val = 0;
+                for (int k = 0; k < nx; ++k) {
+                    for (int l = 0; l < ny; ++l) {
+                        auto const a = Mx(i, k) * My(j, l) + cx * Kx(i, k) * My(j, l)
+                                     + cy * Mx(i, k) * Ky(j, l);
+                        val += a * u(k, l);
+                    }
+                }
+                f(i, j) = val;
+            }
+        }
+
+        auto buf = lin::tensor<double, 2>{{nx, ny}};
+        solver.solve(f, buf);
+
+        CHECK_THAT(to_vector(f), Approx(to_vector(u)));
+    }
+
+    SECTION("3D Kronecker sum") {
+        auto const n = std::array<int, 3>{4, 3, 5};
+        auto const M = std::array{mass(n[0]), mass(n[1]), mass(n[2])};
+        auto const K = std::array{stiffness(n[0]), stiffness(n[1]), stiffness(n[2])};
+
+        auto const terms = std::vector<lin::kronecker_term<3>>{
+            {1.0, {kf::mass, kf::mass, kf::mass}},
+            {0.5, {kf::stiffness, kf::mass, kf::mass}},
+            {1.5, {kf::mass, kf::stiffness, kf::mass}},
+            {0.7, {kf::mass, kf::mass, kf::stiffness}},
+            {0.1, {kf::stiffness, kf::stiffness, kf::stiffness}},
+        };
+        auto const solver = lin::fast_diagonalization_solver<3>{
+            {
+                lin::generalized_eigenbasis{M[0], K[0]},
+                lin::generalized_eigenbasis{M[1], K[1]},
+                lin::generalized_eigenbasis{M[2], K[2]},
+            },
+            terms};
+
+        auto u = lin::tensor<double, 3>{n};
+        for (int i = 0; i < u.size(); ++i) {
+            u.data()[i] = (i * 11 % 7) - 2.5;
+        }
+
+        auto const entry = [&](const lin::kronecker_term<3>& t, std::size_t d, int i, int j) {
+            return t.factors[d] == kf::mass ? M[d](i, j) : K[d](i, j);
+        };
+
+        auto f = lin::tensor<double, 3>{n};
+        for (int i = 0; i < n[0]; ++i) {
+            for (int j = 0; j < n[1]; ++j) {
+                for (int k = 0; k < n[2]; ++k) {
+                    double val = 0;
+                    for (int a = 0; a < n[0]; ++a) {
+                        for (int b = 0; b < n[1]; ++b) {
+                            for (int c = 0; c < n[2]; ++c) {
+                                for (auto const& t : terms) {
+                                    val += t.coefficient * entry(t, 0, i, a) * entry(t, 1, j, b)
+                                         * entry(t, 2, k, c) * u(a, b, c);
+                                }
+                            }
+                        }
+                    }
+                    f(i, j, k) = val;
+                }
+            }
+        }
+
+        auto buf = lin::tensor<double, 3>{n};
+        solver.solve(f, buf);
+
+        CHECK_THAT(to_vector(f), Approx(to_vector(u)));
+    }
+}
+
+TEST_CASE("Fast diagonalization solver rejects invalid problems") {
+    auto const n = 4;
+    auto const M = mass(n);
+    auto const K = stiffness(n);
+
+    SECTION("failed eigenbasis") {
+        // K is not positive definite, so it cannot take the place of M
+        auto negative = K;
+        for (int i = 0; i < n; ++i) {
+            negative(i, i) = -negative(i, i);
+        }
+        auto basis = lin::generalized_eigenbasis{negative, K};
+        REQUIRE(basis.info != 0);
+
+        auto const terms = std::vector<lin::kronecker_term<1>>{{1.0, {kf::mass}}};
+        CHECK_THROWS_AS((lin::fast_diagonalization_solver<1>{{basis}, terms}), std::runtime_error);
+    }
+
+    SECTION("singular operator") {
+        // M (x) M - M (x) M
+        auto const terms = std::vector<lin::kronecker_term<2>>{
+            {1.0, {kf::mass, kf::mass}},
+            {-1.0, {kf::mass, kf::mass}},
+        };
+        auto const bases = std::array{lin::generalized_eigenbasis{M, K},
+                                      lin::generalized_eigenbasis{M, K}};
+        CHECK_THROWS_AS((lin::fast_diagonalization_solver<2>{bases, terms}), std::runtime_error);
+    }
+}
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/lin/kron_apply.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/executor/sequential.hpp"
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/dense_matrix.hpp"
+#include "ads/lin/tensor.hpp"
+
+namespace lin = ads::lin;
+
+namespace {
+
+auto make_band(int kl, int ku, int rows, int cols) -> lin::band_matrix {
+    auto m = lin::band_matrix{kl, ku, rows, cols};
+    for (int i = 0; i < rows; ++i) {
+        for (int j = std::max(0, i - kl); j < std::min(cols, i + ku + 1); ++j) {
+            m(i, j) = 1.0 + i - 0.5 * j;
+        }
+    }
+    return m;
+}
+
+auto make_dense(int rows, int cols) -> lin::dense_matrix {
+    auto m = lin::dense_matrix{rows, cols};
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            m(i, j) = (i * 7 + j * 3) % 5 - 2.0;
+        }
+    }
+    return m;
+}
+
+template <typename Tensor>
+void fill(Tensor& t, int seed) {
+    for (int i = 0; i < t.size(); ++i) {
+        t.data()[i] = ((i + seed) * 37 % 11) - 5.0;
+    }
+}
+
+template <typename Tensor>
+auto to_vector(const Tensor& t) -> std::vector<double> {
+    return {t.data(), t.data() + t.size()};
+}
+
+}  // namespace
+
+TEST_CASE("Kronecker product application", "[lin]") {
+    auto const A = make_band(1, 2, 6, 6);
+    auto const B = make_dense(4, 5);
+    auto const C = make_band(2, 1, 7, 5);  // rectangular
+
+    SECTION("2D, band and dense") {
+        auto x = lin::tensor<double, 2>{{6, 5}};
+        fill(x, 1);
+        auto y = lin::tensor<double, 2>{{6, 4}};
+        fill(y, 2);
+        auto expected = y;
+
+        for (int i = 0; i < 6; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                double sum = 0;
+                for (int k = 0; k < 6; ++k) {
+                    for (int l = 0; l < 5; ++l) {
+                        sum += A(i, k) * B(j, l) * x(k, l);
+                    }
+                }
+                expected(i, j) = 2 * sum - expected(i, j);
+            }
+        }
+
+        lin::kron_apply(y, x, {A, B}, 2, -1);
+        CHECK_THAT(to_vector(y), Catch::Matchers::Approx(to_vector(expected)));
+    }
+
+    SECTION("3D, rectangular factors") {
+        auto x = lin::tensor<double, 3>{{5, 6, 5}};
+        fill(x, 3);
+        auto expected = lin::tensor<double, 3>{{4, 6, 7}};
+
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 6; ++j) {
+                for (int k = 0; k < 7; ++k) {
+                    double sum = 0;
+                    for (int a = 0; a < 5; ++a) {
+                        for (int b = 0; b < 6; ++b) {
+                            for (int c = 0; c < 5; ++c) {
+                                sum += B(i, a) * A(j, b) * C(k, c) * x(a, b, c);
+                            }
+                        }
+                    }
+                    expected(i, j, k) = sum;
+                }
+            }
+        }
+
+        auto y = lin::tensor<double, 3>{expected.sizes()};
+        lin::kron_apply(y, x, {B, A, C});
+        CHECK_THAT(to_vector(y), Catch::Matchers::Approx(to_vector(expected)));
+
+        SECTION("split into chunks") {
+            auto z = lin::tensor<double, 3>{expected.sizes()};
+            lin::kron_apply(ads::sequential_executor{}, z, x, {B, A, C}, 1, 0, 3);
+            CHECK_THAT(to_vector(z), Catch::Matchers::Approx(to_vector(expected)));
+        }
+    }
+
+    SECTION("sum of Kronecker products") {
+        auto const M = make_band(2, 2, 9, 9);
+        auto const K = make_dense(9, 9);
+        auto x = lin::tensor<double, 2>{{9, 9}};
+        fill(x, 4);
+
+        auto dense_M = lin::dense_matrix{9, 9};
+        lin::to_dense(M, dense_M);
+        auto expected = lin::tensor<double, 2>{{9, 9}};
+        lin::kron_apply(expected, x, {K, dense_M});
+        lin::kron_apply(expected, x, {dense_M, K}, 1, 1);
+
+        auto y = lin::tensor<double, 2>{{9, 9}};
+        lin::kron_apply(y, x, {K, M});
+        lin::kron_apply(y, x, {M, K}, 1, 1);
+        CHECK_THAT(to_vector(y), Catch::Matchers::Approx(to_vector(expected)));
+    }
+}
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/lin/tensor/strided_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/executor/sequential.hpp"
+#include "ads/lin/band_matrix.hpp"
+#include "ads/lin/band_solve.hpp"
+#include "ads/lin/tensor.hpp"
+
+namespace lin = ads::lin;
+
+namespace {
+
+template <typename Tensor>
+void fill(Tensor& t) {
+    for (int i = 0; i < t.size(); ++i) {
+        t.data()[i] = i;
+    }
+}
+
+auto make_band(int kl, int ku, int n) -> lin::band_matrix {
+    auto m = lin::band_matrix{kl, ku, n};
+    for (int i = 0; i < n; ++i) {
+        for (int j = std::max(0, i - kl); j < std::min(n, i + ku + 1); ++j) {
+            m(i, j) = i == j ? 10.0 : 1.0 + i - 0.5 * j;
+        }
+    }
+    return m;
+}
+
+}  // namespace
+
+TEST_CASE("Strided views", "[lin]") {
+    auto t = lin::tensor<double, 3>{{4, 5, 6}};
+    fill(t);
+
+    SECTION("whole tensor is contiguous") {
+        auto const v = t.strided();
+        CHECK(v.is_contiguous());
+        CHECK(v.sizes() == t.sizes());
+        CHECK(v(1, 2, 3) == t(1, 2, 3));
+    }
+
+    SECTION("slices") {
+        auto const s0 = t.slice<0>(2);
+        CHECK(s0.sizes() == std::array{5, 6});
+        CHECK_FALSE(s0.is_contiguous());
+        CHECK(s0(3, 4) == t(2, 3, 4));
+
+        auto const s2 = t.slice<2>(5);
+        CHECK(s2.is_contiguous());
+        CHECK(s2(1, 3) == t(1, 3, 5));
+
+        auto const line = s0.slice<1>(4);
+        CHECK(line.size() == 5);
+        CHECK(line(2) == t(2, 2, 4));
+    }
+
+    SECTION("blocks") {
+        auto const b = t.block({1, 1, 2}, {2, 3, 3});
+        CHECK(b.sizes() == std::array{2, 3, 3});
+        CHECK(b(0, 0, 0) == t(1, 1, 2));
+        CHECK(b(1, 2, 2) == t(2, 3, 4));
+
+        auto const inner = b.slice<2>(1).block({1, 1}, {1, 2});
+        CHECK(inner(0, 1) == t(2, 3, 3));
+    }
+
+    SECTION("writing through views") {
+        t.slice<1>(0)(3, 2) = -1;
+        CHECK(t(3, 0, 2) == -1);
+    }
+
+    SECTION("views of const tensors") {
+        const auto& ct = t;
+        lin::strided_view<const double, 2> s = ct.slice<0>(1);
+        CHECK(s(0, 0) == t(1, 0, 0));
+    }
+}
+
+TEST_CASE("Operations on strided views", "[lin]") {
+    auto t = lin::tensor<double, 2>{{4, 5}};
+    fill(t);
+
+    SECTION("assign") {
+        lin::assign(t.slice<0>(0), 7.0);
+        lin::assign(t.slice<1>(4), 8.0);
+        for (int j = 0; j < 4; ++j) {
+            CHECK(t(0, j) == 7);
+        }
+        for (int i = 0; i < 4; ++i) {
+            CHECK(t(i, 4) == 8);
+        }
+        CHECK(t(1, 1) == 5);
+    }
+
+    SECTION("copy between tensors and views") {
+        auto row = lin::vector{{5}};
+        lin::copy(t.slice<0>(2), row);
+        for (int j = 0; j < 5; ++j) {
+            CHECK(row(j) == t(2, j));
+        }
+
+        lin::scale(-1.0, row);
+        lin::copy(row, t.slice<0>(3));
+        CHECK(t(3, 1) == row(1));
+
+        auto copy = lin::tensor<double, 2>{{4, 5}};
+        lin::copy(t, copy);
+        CHECK(copy == t);
+    }
+
+    SECTION("axpy and scale") {
+        auto expected = t;
+        for (int i = 1; i < 3; ++i) {
+            for (int j = 1; j < 4; ++j) {
+                expected(i, j) = 2 * (t(i, j) + 3 * t(i - 1, j - 1));
+            }
+        }
+        auto const source = t;
+        lin::axpy(3.0, source.block({0, 0}, {2, 3}), t.block({1, 1}, {2, 3}));
+        lin::scale(2.0, t.block({1, 1}, {2, 3}));
+        CHECK(t == expected);
+    }
+}
+
+TEST_CASE("Solving for strided views", "[lin]") {
+    int const n = 6;
+    auto m = make_band(2, 1, n);
+    auto ctx = lin::solver_ctx{m};
+    lin::factorize(m, ctx);
+
+    auto t = lin::tensor<double, 3>{{3, n, 4}};
+    fill(t);
+    auto const original = t;
+
+    auto expect_solved = [&](int i, int k) {
+        auto line = lin::vector{{n}};
+        for (int j = 0; j < n; ++j) {
+            line(j) = original(i, j, k);
+        }
+        lin::solve_with_factorized(m, line, ctx);
+        for (int j = 0; j < n; ++j) {
+            CHECK(t(i, j, k) == Catch::Approx(line(j)));
+        }
+    };
+
+    SECTION("line along non-leading dimension") {
+        lin::solve_with_factorized(m, t.slice<0>(1).slice<1>(2), std::as_const(ctx));
+        expect_solved(1, 2);
+        CHECK(t(0, 0, 2) == original(0, 0, 2));
+    }
+
+    SECTION("plane with interleaved lines") {
+        auto plane = t.slice<2>(3);
+        // lines along the second dimension
+        auto lines = lin::strided_view<double, 2>{plane.data(), {n, 3}, {3, 1}};
+        lin::solve_with_factorized(m, lines, ctx);
+        for (int i = 0; i < 3; ++i) {
+            expect_solved(i, 3);
+        }
+    }
+
+    SECTION("block with lines at arbitrary stride") {
+        auto lines = lin::strided_view<double, 2>{&t(0, 0, 0), {n, 4}, {3, 3 * n}};
+        lin::solve_with_factorized(m, lines, std::as_const(ctx));
+        for (int k = 0; k < 4; ++k) {
+            expect_solved(0, k);
+        }
+        CHECK(t(1, 0, 0) == original(1, 0, 0));
+    }
+}
+
+TEST_CASE("Cyclic transpose of strided views", "[lin]") {
+    auto t = lin::tensor<double, 3>{{5, 4, 6}};
+    fill(t);
+    auto const b = t.block({1, 0, 2}, {3, 4, 3});
+
+    auto expected = lin::tensor<double, 3>{{4, 3, 3}};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            for (int k = 0; k < 3; ++k) {
+                expected(j, k, i) = b(i, j, k);
+            }
+        }
+    }
+
+    SECTION("sequential") {
+        auto out = lin::tensor<double, 3>{{4, 3, 3}};
+        lin::cyclic_transpose(b, out);
+        CHECK(out == expected);
+    }
+
+    SECTION("parallel") {
+        auto out = lin::tensor<double, 3>{{4, 3, 3}};
+        lin::cyclic_transpose(b, out, ads::sequential_executor{});
+        CHECK(out == expected);
+    }
+
+    SECTION("contiguous view") {
+        auto out = std::vector<double>(t.size());
+        auto const view = lin::cyclic_transpose(std::as_const(t).strided(), out.data());
+        CHECK(view(2, 3, 1) == t(1, 2, 3));
+    }
+}
@@ -7,6 +7,8 @@
 
 #include <catch2/catch_all.hpp>
 
+#include "ads/executor/sequential.hpp"
+
 namespace lin = ads::lin;
 
 TEST_CASE("Tensor") {
@@ -78,4 +80,65 @@ TEST_CASE("Tensor") {
         cyclic_transpose(a2, a3);
         CHECK(a3 == a);
     }
+
+    SECTION("Cyclic transpose of tensor larger than a single tile") {
+        int k = 37;
+        int n = 70;
+        int m = 9;
+
+        auto a = lin::tensor<double, 3>{{k, n, m}};
+        for (int i = 0; i < a.size(); ++i) {
+            a.data()[i] = i;
+        }
+
+        auto out = lin::tensor<double, 3>{{n, m, k}};
+        cyclic_transpose(a, out);
+
+        bool ok = true;
+        for (int i = 0; i < k; ++i) {
+            for (int j = 0; j < n; ++j) {
+                for (int l = 0; l < m; ++l) {
+                    ok = ok && out(j, l, i) == a(i, j, l);
+                }
+            }
+        }
+        CHECK(ok);
+    }
+
+    SECTION("Cyclic transpose of a matrix using executor") {
+        int n = 45;
+        int m = 67;
+
+        auto a = lin::tensor<double, 2>{{n, m}};
+        for (int i = 0; i < a.size(); ++i) {
+            a.data()[i] = i;
+        }
+
+        auto expected = lin::tensor<double, 2>{{m, n}};
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < m; ++j) {
+                expected(j, i) = a(i, j);
+            }
+        }
+
+        auto out = lin::tensor<double, 2>{{m, n}};
+        cyclic_transpose(a, out, ads::sequential_executor{});
+        CHECK(out == expected);
+    }
+
+    SECTION("Tensor initialized by executor is zero") {
+        auto a = lin::tensor<double, 3>{{7, 5, 9}, ads::sequential_executor{}};
+        CHECK(a.size() == 7 * 5 * 9);
+        CHECK(a == lin::tensor<double, 3>{{7, 5, 9}});
+
+        a(3, 2, 4) = 1;
+        zero(a, ads::sequential_executor{});
+        CHECK(a == lin::tensor<double, 3>{{7, 5, 9}});
+    }
+
+    SECTION("Interleaved tensor is zero") {
+        auto const placement = lin::numa_placement{lin::numa_policy::interleave};
+        auto a = lin::tensor<double, 2>{{300, 200}, ads::sequential_executor{}, placement};
+        CHECK(a == lin::tensor<double, 2>{{300, 200}});
+    }
 }
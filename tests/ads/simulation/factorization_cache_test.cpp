@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/simulation/factorization_cache.hpp"
+
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/form_matrix.hpp"
+#include "ads/lin/band_solve.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+
+namespace {
+
+auto solve(ads::dimension& dim) -> std::vector<double> {
+    auto rhs = ads::lin::vector{{dim.dofs()}};
+    for (int i = 0; i < dim.dofs(); ++i) {
+        rhs(i) = 1.0 + i % 3;
+    }
+    auto const factors = dim.data();
+    ads::lin::solve_with_factorized(factors.M, rhs, factors.ctx);
+    return {rhs.data(), rhs.data() + rhs.size()};
+}
+
+}  // namespace
+
+TEST_CASE("Factorization cache", "[simulation]") {
+    auto& cache = ads::factorization_cache::global();
+    cache.clear();
+
+    auto const config = ads::dim_config{3, 14};
+
+    SECTION("identical dimensions share basis data") {
+        auto x = ads::dimension{config, 1};
+        auto y = ads::dimension{config, 1};
+
+        CHECK(&x.basis() == &y.basis());
+        CHECK(&x.mass_matrix() == &y.mass_matrix());
+    }
+
+    SECTION("different dimensions do not share basis data") {
+        auto x = ads::dimension{config, 1};
+        auto y = ads::dimension{ads::dim_config{3, 14, 0, 2}, 1};
+        auto z = ads::dimension{config, 2};
+
+        CHECK(&x.basis() != &y.basis());
+        CHECK(&x.basis() != &z.basis());
+    }
+
+    SECTION("shared factorization gives the same solution") {
+        auto x = ads::dimension{config, 1};
+        auto y = ads::dimension{config, 1};
+        x.factorize_matrix();
+        auto const misses = cache.misses();
+        y.factorize_matrix();
+
+        CHECK(cache.misses() == misses);
+
+        auto M = ads::lin::band_matrix{x.p, x.p, x.dofs()};
+        ads::gram_matrix_1d(M, x.basis());
+        auto ctx = ads::lin::solver_ctx{M};
+        ads::lin::factorize(M, ctx);
+
+        CHECK(&x.data().M.factors() == &y.data().M.factors());
+        CHECK(&x.data().ctx == &y.data().ctx);
+        CHECK(x.data().M.factors() == M);
+        CHECK(solve(x) == solve(y));
+    }
+
+    SECTION("fixing dofs after sharing the factorization") {
+        auto x = ads::dimension{config, 1};
+        auto y = ads::dimension{config, 1};
+        x.factorize_matrix();
+        y.factorize_matrix();
+        y.fix_left();
+
+        CHECK(&x.data().M.factors() == &y.data().M.factors());
+        CHECK(y.data().M.rank() == 1);
+        CHECK(solve(y)[0] == Catch::Approx(1.0));
+        CHECK(solve(x)[0] != Catch::Approx(1.0));
+    }
+
+    SECTION("dimensions can be copy assigned") {
+        auto x = ads::dimension{config, 1};
+        auto y = ads::dimension{ads::dim_config{2, 10}, 1};
+        x.factorize_matrix();
+        y = x;
+
+        CHECK(y.dofs() == x.dofs());
+        CHECK(&y.basis() == &x.basis());
+        CHECK(&y.data().M.factors() == &x.data().M.factors());
+    }
+
+    SECTION("dimensions with fixed dofs share the factorization") {
+        auto x = ads::dimension{config, 1};
+        auto y = ads::dimension{config, 1};
+        y.fix_left();
+        x.factorize_matrix();
+        auto const misses = cache.misses();
+        y.factorize_matrix();
+
+        CHECK(cache.misses() == misses);
+        CHECK(&x.data().M.factors() == &y.data().M.factors());
+        CHECK(solve(y)[0] == Catch::Approx(1.0));
+    }
+
+    SECTION("stiffness matrix") {
+        auto x = ads::dimension{config, 1};
+        auto const K = cache.matrix(x.basis(), ads::matrix_kind::stiffness);
+
+        auto expected = ads::lin::band_matrix{x.p, x.p, x.dofs()};
+        ads::stiffness_matrix_1d(expected, x.basis());
+
+        CHECK(*K == expected);
+        CHECK(cache.matrix(x.basis(), ads::matrix_kind::stiffness) == K);
+    }
+
+    cache.clear();
+}
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/simulation/simulation_4d.hpp"
+
+#include <sstream>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/lin/tensor/io.hpp"
+#include "ads/output_manager.hpp"
+#include "ads/simulation/config.hpp"
+
+namespace {
+
+class projection_4d : public ads::simulation_4d {
+public:
+    explicit projection_4d(const ads::config_4d& config)
+    : simulation_4d{config} { }
+
+    using simulation_4d::vector_type;
+
+    // Polynomial of degree 1 in each variable, exactly representable in the basis
+    static double poly(double x, double y, double z, double t) {
+        return (1 + x) * (2 - y) * (0.5 + z) * (3 + t);
+    }
+
+    auto project() -> vector_type {
+        prepare_matrices();
+        auto u = vector_type{shape()};
+        projection(u, poly);
+        solve(u);
+        return u;
+    }
+
+    auto error(const vector_type& u) const -> double {
+        auto exact = [](point_type p) {
+            return value_type{poly(p[0], p[1], p[2], p[3]), 0, 0, 0, 0};
+        };
+        return errorL2(u, x, y, z, t, exact);
+    }
+
+    auto element_count() const -> int {
+        int count = 0;
+        for ([[maybe_unused]] auto e : elements()) {
+            ++count;
+        }
+        return count;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Space-time simulation", "[simulation]") {
+    auto const dim = ads::dim_config{2, 3};
+    auto const time = ads::dim_config{1, 4, 0, 2};
+    auto sim = projection_4d{ads::config_4d{dim, dim, dim, time, {1, 2.0}, 1}};
+
+    CHECK(sim.element_count() == 3 * 3 * 3 * 4);
+
+    auto const u = sim.project();
+
+    SECTION("projection of a function in the basis is exact") {
+        CHECK(sim.error(u) == Catch::Approx(0).margin(1e-10));
+    }
+
+    SECTION("snapshot at given time") {
+        auto output = ads::output_manager<4>{sim.x.B, sim.y.B, sim.z.B, sim.t.B, 4};
+        auto const& coeffs = output.snapshot(u, 2.0);
+        for (int i = 0; i < coeffs.size(0); ++i) {
+            CHECK(coeffs(i, 1, 2) == Catch::Approx(u(i, 1, 2, sim.t.dofs() - 1)));
+        }
+    }
+
+    SECTION("printing") {
+        auto t = ads::lin::tensor<double, 4>{{1, 2, 1, 2}};
+        t(0, 1, 0, 1) = 3;
+        auto os = std::ostringstream{};
+        os << t;
+        CHECK(os.str().find("[1]") != std::string::npos);
+    }
+}
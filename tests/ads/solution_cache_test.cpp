@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/solution_cache.hpp"
+
+#include <array>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/basis_data.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/sum_factorization.hpp"
+#include "ads/util/function_value.hpp"
+#include "test_helpers.hpp"
+
+namespace lin = ads::lin;
+
+using ads::test::fill;
+using ads::test::make_basis;
+using ads::test::to_vector;
+
+namespace {
+
+// Derivative of given orders of u at quadrature point q of element e, computed directly
+auto derivative(const lin::tensor<double, 2>& u, const ads::basis_data& bx,
+                const ads::basis_data& by, std::array<int, 2> e, std::array<int, 2> q, int dx,
+                int dy) -> double {
+    double val = 0;
+    for (int a = 0; a <= bx.degree; ++a) {
+        for (int b = 0; b <= by.degree; ++b) {
+            double const c = u(bx.first_dof(e[0]) + a, by.first_dof(e[1]) + b);
+            val += c * bx.b[e[0]][q[0]][dx][a] * by.b[e[1]][q[1]][dy][b];
+        }
+    }
+    return val;
+}
+
+}  // namespace
+
+TEST_CASE("Solution cache", "[assembly]") {
+    auto const bx = make_basis(3, 4, 2);
+    auto const by = make_basis(2, 5, 2);
+
+    auto u = lin::tensor<double, 2>{{bx.dofs, by.dofs}};
+    fill(u);
+
+    auto cache = ads::solution_cache<2>{{&bx, &by}, true};
+    CHECK(cache.dirty());
+    cache.update(u);
+    CHECK_FALSE(cache.dirty());
+
+    auto const e = std::array{2, 3};
+    auto const q = std::array{1, 2};
+    auto const idx = cache.point_index(q);
+
+    SECTION("values, gradients and Hessians") {
+        auto const val = cache.value(e, q);
+        CHECK(val.val == Catch::Approx(derivative(u, bx, by, e, q, 0, 0)));
+        CHECK(val.dx == Catch::Approx(derivative(u, bx, by, e, q, 1, 0)));
+        CHECK(val.dy == Catch::Approx(derivative(u, bx, by, e, q, 0, 1)));
+
+        CHECK(cache.hessian(e, idx, 0, 0) == Catch::Approx(derivative(u, bx, by, e, q, 2, 0)));
+        CHECK(cache.hessian(e, idx, 0, 1) == Catch::Approx(derivative(u, bx, by, e, q, 1, 1)));
+        CHECK(cache.hessian(e, idx, 1, 0) == cache.hessian(e, idx, 0, 1));
+        CHECK(cache.hessian(e, idx, 1, 1) == Catch::Approx(derivative(u, bx, by, e, q, 0, 2)));
+    }
+
+    SECTION("is recomputed only when outdated") {
+        auto const before = cache.value(e, q).val;
+        u(bx.first_dof(e[0]) + 1, by.first_dof(e[1]) + 1) += 1;
+
+        cache.update(u);
+        CHECK(cache.value(e, q).val == before);
+
+        cache.invalidate();
+        cache.update(u);
+        CHECK(cache.value(e, q).val == Catch::Approx(derivative(u, bx, by, e, q, 0, 0)));
+
+        auto other = u;
+        lin::scale(2.0, other);
+        cache.update(other);
+        CHECK(cache.value(e, q).val == Catch::Approx(2 * derivative(u, bx, by, e, q, 0, 0)));
+    }
+
+    SECTION("assembly from cached values") {
+        auto form = [](std::array<double, 2> x, ads::function_value_2d u) {
+            return ads::function_value_2d{x[0] * u.val, -0.5 * u.dx, 2 * u.dy + u.val};
+        };
+        auto expected = lin::tensor<double, 2>{u.sizes()};
+        ads::assemble_rhs(expected, u, {&bx, &by}, form);
+
+        auto rhs = lin::tensor<double, 2>{u.sizes()};
+        ads::assemble_rhs(rhs, cache, form);
+        CHECK_THAT(to_vector(rhs), Catch::Matchers::Approx(to_vector(expected)));
+    }
+}
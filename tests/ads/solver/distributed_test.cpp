@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/solver/distributed.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/solver.hpp"
+#include "test_helpers.hpp"
+
+using Catch::Matchers::Approx;
+using ads::test::make_dimension;
+using ads::test::tensor;
+using ads::test::to_vector;
+
+namespace {
+
+auto value(int i) -> double {
+    return std::sin(0.1 * i) + 0.25;
+}
+
+}  // namespace
+
+TEST_CASE("Distributed ADS", "[ads][mpi]") {
+    SECTION("3D") {
+        auto x = make_dimension(2, 7);
+        auto y = make_dimension(3, 5);
+        auto z = make_dimension(1, 10);
+
+        auto const sizes = std::array<int, 3>{x.dofs(), y.dofs(), z.dofs()};
+        auto solver = ads::distributed_ads<3>{MPI_COMM_WORLD, sizes};
+
+        auto global = tensor<3>{sizes};
+        for (int i = 0; i < global.size(); ++i) {
+            global.data()[i] = value(i);
+        }
+        auto local = tensor<3>{solver.local_sizes()};
+        auto const offset = sizes[0] * sizes[1] * solver.local_begin();
+        for (int i = 0; i < local.size(); ++i) {
+            local.data()[i] = global.data()[offset + i];
+        }
+
+        auto buf = tensor<3>{sizes};
+        ads_solve(global, buf, x.data(), y.data(), z.data());
+        solver.solve(local, x.data(), y.data(), z.data());
+
+        auto expected = std::vector<double>(global.data() + offset,
+                                            global.data() + offset + local.size());
+        CHECK_THAT(to_vector(local), Approx(expected));
+    }
+
+    SECTION("2D with fewer columns than processes") {
+        auto x = make_dimension(1, 2);
+        auto y = make_dimension(2, 11);
+
+        auto const sizes = std::array<int, 2>{x.dofs(), y.dofs()};
+        auto solver = ads::distributed_ads<2>{MPI_COMM_WORLD, sizes};
+
+        auto global = tensor<2>{sizes};
+        for (int i = 0; i < global.size(); ++i) {
+            global.data()[i] = value(i);
+        }
+        auto local = tensor<2>{solver.local_sizes()};
+        auto const offset = sizes[0] * solver.local_begin();
+        for (int i = 0; i < local.size(); ++i) {
+            local.data()[i] = global.data()[offset + i];
+        }
+
+        auto buf = tensor<2>{sizes};
+        ads_solve(global, buf, x.data(), y.data());
+        solver.solve(local, x.data(), y.data());
+
+        auto expected = std::vector<double>(global.data() + offset,
+                                            global.data() + offset + local.size());
+        CHECK_THAT(to_vector(local), Approx(expected));
+    }
+}
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/solver/mixed_precision.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/form_matrix.hpp"
+#include "ads/lin/solver_ctx.hpp"
+#include "ads/lin/symmetric_band_matrix.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+#include "ads/simulation/simulation_3d.hpp"
+#include "ads/solver.hpp"
+#include "test_helpers.hpp"
+
+using ads::test::fill;
+using ads::test::make_dimension;
+using ads::test::tensor;
+
+namespace {
+
+template <std::size_t N>
+auto relative_error(const tensor<N>& a, const tensor<N>& b) -> double {
+    double diff = 0;
+    double norm = 0;
+    for (int i = 0; i < a.size(); ++i) {
+        diff = std::max(diff, std::abs(a.data()[i] - b.data()[i]));
+        norm = std::max(norm, std::abs(b.data()[i]));
+    }
+    return diff / norm;
+}
+
+// Dimension using symmetric storage of the mass matrix
+struct spd_dimension {
+    ads::dimension dim;
+    ads::lin::symmetric_band_matrix M;
+    ads::lin::solver_ctx ctx;
+
+    spd_dimension(int p, int elements)
+    : dim{ads::dim_config{p, elements}, 1}
+    , M{p, dim.dofs()}
+    , ctx{M} {
+        ads::gram_matrix_1d(M, dim.basis());
+        ads::lin::factorize(M, ctx);
+    }
+
+    ads::spd_dim_data data() { return {M, ctx}; }
+};
+
+struct test_simulation : ads::simulation_3d {
+    using simulation_3d::simulation_3d;
+};
+
+}  // namespace
+
+TEST_CASE("Mixed precision ADS", "[ads]") {
+    auto const p = GENERATE(1, 2, 3);
+
+    SECTION("LU factorization") {
+        auto x = ads::dimension{ads::dim_config{p, 12}, 1};
+        auto y = make_dimension(p, 9);
+        auto z = make_dimension(p, 10);
+
+        // non-symmetric matrix with a row replaced by boundary condition
+        x.fix_left();
+        x.factorize_matrix();
+
+        auto rhs = tensor<3>{{x.dofs(), y.dofs(), z.dofs()}};
+        auto buf = tensor<3>{rhs.sizes()};
+        fill(rhs);
+        auto expected = rhs;
+        ads_solve(expected, buf, x.data(), y.data(), z.data());
+
+        auto solver = ads::mixed_precision_ads{x.data(), y.data(), z.data()};
+        auto const status = solver.solve(rhs);
+
+        CHECK(status.converged);
+        CHECK(status.steps > 0);
+        CHECK(status.steps <= solver.max_iterations);
+        CHECK(relative_error(rhs, expected) < 1e-12);
+    }
+
+    SECTION("Cholesky factorization") {
+        auto x = spd_dimension{p, 8};
+        auto y = spd_dimension{p, 11};
+
+        auto rhs = tensor<2>{{x.dim.dofs(), y.dim.dofs()}};
+        auto buf = tensor<2>{rhs.sizes()};
+        fill(rhs);
+        auto expected = rhs;
+        ads_solve(expected, buf, x.data(), y.data());
+
+        auto solver = ads::mixed_precision_ads{x.data(), y.data()};
+        auto const status = solver.solve(rhs);
+
+        CHECK(status.converged);
+        CHECK(relative_error(rhs, expected) < 1e-12);
+    }
+
+    SECTION("Not converged") {
+        auto x = make_dimension(p, 8);
+        auto y = make_dimension(p, 7);
+
+        auto rhs = tensor<2>{{x.dofs(), y.dofs()}};
+        auto buf = tensor<2>{rhs.sizes()};
+        fill(rhs);
+        auto expected = rhs;
+        ads_solve(expected, buf, x.data(), y.data());
+
+        auto solver = ads::mixed_precision_ads{x.data(), y.data()};
+        solver.max_iterations = 0;
+        auto const status = solver.solve(rhs);
+
+        CHECK_FALSE(status.converged);
+        CHECK(status.steps == 0);
+        CHECK(relative_error(rhs, expected) < 1e-5);
+    }
+}
+
+TEST_CASE("Mixed precision solve of 3D simulation", "[ads]") {
+    auto const steps = ads::timesteps_config{1, 0.1};
+    auto sim = test_simulation{make_dimension(2, 16), make_dimension(2, 14), make_dimension(2, 12),
+                               steps};
+
+    auto rhs = tensor<3>{{sim.x.dofs(), sim.y.dofs(), sim.z.dofs()}};
+    fill(rhs);
+    auto expected = rhs;
+    sim.solve(expected);
+
+    auto solver = ads::mixed_precision_ads<3>{sim.x.data(), sim.y.data(), sim.z.data()};
+    auto const status = sim.solve(rhs, solver);
+
+    CHECK(status.converged);
+    CHECK(relative_error(rhs, expected) < 1e-12);
+}
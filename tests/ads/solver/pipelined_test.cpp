@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/solver/pipelined.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/executor/sequential.hpp"
+#include "ads/executor/thread_pool.hpp"
+#include "ads/solver.hpp"
+#include "test_helpers.hpp"
+
+using ads::test::fill;
+using ads::test::make_dimension;
+using ads::test::tensor;
+using ads::test::to_vector;
+
+TEST_CASE("Pipelined ADS", "[ads]") {
+    auto x = make_dimension(2, 10);
+    auto y = make_dimension(3, 7);
+    auto z = make_dimension(1, 9);
+    auto t = make_dimension(2, 5);
+
+    SECTION("sequential executor") {
+        auto const executor = ads::sequential_executor{};
+        auto const slabs = GENERATE(1, 3, 100);
+        auto solver = ads::pipelined_ads{executor, 2, slabs};
+
+        SECTION("2D") {
+            auto rhs = tensor<2>{{x.dofs(), y.dofs()}};
+            fill(rhs);
+            auto expected = rhs;
+            auto buf = tensor<2>{rhs.sizes()};
+            ads_solve(expected, buf, x.data(), y.data());
+
+            solver.solve(rhs, x.data(), y.data());
+            CHECK(to_vector(rhs) == to_vector(expected));
+        }
+
+        SECTION("3D") {
+            auto rhs = tensor<3>{{x.dofs(), y.dofs(), z.dofs()}};
+            fill(rhs);
+            auto expected = rhs;
+            auto buf = tensor<3>{rhs.sizes()};
+            ads_solve(expected, buf, x.data(), y.data(), z.data());
+
+            solver.solve(rhs, x.data(), y.data(), z.data());
+            CHECK(to_vector(rhs) == to_vector(expected));
+        }
+
+        SECTION("4D") {
+            auto rhs = tensor<4>{{x.dofs(), y.dofs(), z.dofs(), t.dofs()}};
+            fill(rhs);
+            auto expected = rhs;
+            auto buf = tensor<4>{rhs.sizes()};
+            ads_solve(expected, buf, x.data(), y.data(), z.data(), t.data());
+
+            solver.solve(rhs, x.data(), y.data(), z.data(), t.data());
+            CHECK(to_vector(rhs) == to_vector(expected));
+        }
+    }
+
+    SECTION("concurrent workers") {
+        auto const executor = ads::thread_pool_executor{4};
+        auto solver = ads::pipelined_ads{executor, 4, 5};
+
+        auto rhs = tensor<4>{{x.dofs(), y.dofs(), z.dofs(), t.dofs()}};
+        fill(rhs);
+        auto expected = rhs;
+        auto buf = tensor<4>{rhs.sizes()};
+        ads_solve(expected, buf, x.data(), y.data(), z.data(), t.data());
+
+        solver.solve(rhs, x.data(), y.data(), z.data(), t.data());
+        CHECK(to_vector(rhs) == to_vector(expected));
+
+        auto const& stats = solver.stats();
+        REQUIRE(stats.size() == 4);
+        for (auto const& stage : stats) {
+            CHECK(stage.begin <= stage.end);
+            CHECK(stage.end <= solver.wall_time());
+        }
+        // the last direction can only start once all the others are done
+        CHECK(stats[3].begin >= stats[2].end);
+    }
+
+    SECTION("solve after releasing the buffers") {
+        auto const executor = ads::sequential_executor{};
+        auto solver = ads::pipelined_ads{executor, 2, 3};
+
+        auto rhs = tensor<3>{{x.dofs(), y.dofs(), z.dofs()}};
+        fill(rhs);
+        auto expected = rhs;
+        auto buf = tensor<3>{rhs.sizes()};
+        ads_solve(expected, buf, x.data(), y.data(), z.data());
+
+        auto other = rhs;
+        solver.solve(other, x.data(), y.data(), z.data());
+        solver.release_buffers();
+
+        solver.solve(rhs, x.data(), y.data(), z.data());
+        CHECK(to_vector(rhs) == to_vector(expected));
+    }
+}
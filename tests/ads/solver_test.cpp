@@ -10,6 +10,8 @@
 
 #include <catch2/catch_all.hpp>
 
+#include "ads/executor/sequential.hpp"
+#include "ads/executor/thread_pool.hpp"
 #include "ads/lin/band_matrix.hpp"
 #include "ads/lin/band_solve.hpp"
 #include "ads/lin/solver_ctx.hpp"
@@ -532,3 +534,318 @@ TEST_CASE("ADS generalized 3D", "[ads]") {
         CHECK_THAT(to_vector(rhs), Approx(expected));
     }
 }
+
+TEST_CASE("ADS parallel sweeps", "[ads]") {
+    auto const nx = 7;
+    auto const ny = 5;
+    auto const nz = 6;
+
+    auto const make_dim = [](int n) {
+        auto rows = std::vector<std::vector<double>>{};
+        for (int i = 0; i < n; ++i) {
+            auto const first = i > 0 ? std::vector<double>{-1.0} : std::vector<double>{};
+            auto row = first;
+            row.push_back(4.0 + i);
+            if (i < n - 1) {
+                row.push_back(2.0 - i);
+            }
+            rows.push_back(row);
+        }
+        return make_factored_matrix(1, 1, n, rows);
+    };
+
+    auto X = make_dim(nx);
+    auto Y = make_dim(ny);
+    auto Z = make_dim(nz);
+
+    auto dim_x = ads::dim_data{X.mat, X.ctx};
+    auto dim_y = ads::dim_data{Y.mat, Y.ctx};
+    auto dim_z = ads::dim_data{Z.mat, Z.ctx};
+
+    auto rhs = tensor<3>{{nx, ny, nz}};
+    for (int i = 0; i < rhs.size(); ++i) {
+        rhs.data()[i] = (i * 37 % 11) - 5.0;
+    }
+    auto buf = tensor<3>{rhs.sizes()};
+
+    auto expected = rhs;
+    ads_solve(expected, buf, dim_x, dim_y, dim_z);
+
+    auto const executor = ads::sequential_executor{};
+
+    SECTION("uneven chunks") {
+        auto const sweep = ads::parallel_sweep{executor, 4};
+        ads_solve(sweep, rhs, buf, dim_x, dim_y, dim_z);
+        CHECK(to_vector(rhs) == to_vector(expected));
+    }
+
+    SECTION("more chunks than right-hand sides") {
+        auto const sweep = ads::parallel_sweep{executor, 100};
+        ads_solve(sweep, rhs, buf, dim_x, dim_y, dim_z);
+        CHECK(to_vector(rhs) == to_vector(expected));
+    }
+
+    SECTION("default number of chunks") {
+        auto const sweep = ads::parallel_sweep{executor};
+        ads_solve(sweep, rhs, buf, dim_x, dim_y, dim_z);
+        CHECK(to_vector(rhs) == to_vector(expected));
+    }
+
+    SECTION("with special dimension") {
+        auto const step_z = [&](auto& r) { ads::lin::solve_with_factorized(Z.mat, r, Z.ctx); };
+        auto const sweep = ads::parallel_sweep{executor, 3};
+        ads_solve(sweep, rhs, buf, dim_x, dim_y, step_z);
+        // special dimension is solved first, so rounding errors may differ
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("without buffer") {
+        auto const sweep = ads::parallel_sweep{executor, 4};
+        ads_solve(sweep, rhs, dim_x, dim_y, dim_z);
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("without buffer, more chunks than lines") {
+        auto const sweep = ads::parallel_sweep{executor, 1000};
+        ads_solve(sweep, rhs, dim_x, dim_y, dim_z);
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("thread pool") {
+        auto const pool = ads::thread_pool_executor{4};
+        auto const chunks = GENERATE(0, 3, 8);
+        ads_solve(ads::parallel_sweep{pool, chunks}, rhs, buf, dim_x, dim_y, dim_z);
+        CHECK(to_vector(rhs) == to_vector(expected));
+    }
+}
+
+TEST_CASE("ADS transpose-free", "[ads]") {
+    auto const make_dim = [](int n) {
+        auto rows = std::vector<std::vector<double>>{};
+        for (int i = 0; i < n; ++i) {
+            auto row = i > 0 ? std::vector<double>{3.0 + i} : std::vector<double>{};
+            row.push_back(1.0 + i);
+            if (i < n - 1) {
+                row.push_back(2.0 - i);
+            }
+            rows.push_back(row);
+        }
+        return make_factored_matrix(1, 1, n, rows);
+    };
+
+    auto X = make_dim(7);
+    auto Y = make_dim(5);
+    auto Z = make_dim(6);
+
+    auto dim_x = ads::dim_data{X.mat, X.ctx};
+    auto dim_y = ads::dim_data{Y.mat, Y.ctx};
+    auto dim_z = ads::dim_data{Z.mat, Z.ctx};
+
+    auto const fill = [](auto& rhs) {
+        for (int i = 0; i < rhs.size(); ++i) {
+            rhs.data()[i] = (i * 37 % 11) - 5.0;
+        }
+    };
+
+    SECTION("2D") {
+        auto rhs = tensor<2>{{7, 5}};
+        fill(rhs);
+        auto expected = rhs;
+        auto buf = tensor<2>{rhs.sizes()};
+        ads_solve(expected, buf, dim_x, dim_y);
+
+        ads_solve(ads::strided_sweep{}, rhs, dim_x, dim_y);
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("3D") {
+        auto rhs = tensor<3>{{7, 5, 6}};
+        fill(rhs);
+        auto expected = rhs;
+        auto buf = tensor<3>{rhs.sizes()};
+        ads_solve(expected, buf, dim_x, dim_y, dim_z);
+
+        ads_solve(ads::strided_sweep{}, rhs, dim_x, dim_y, dim_z);
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("without buffer") {
+        auto rhs = tensor<3>{{7, 5, 6}};
+        fill(rhs);
+        auto expected = rhs;
+        auto buf = tensor<3>{rhs.sizes()};
+        ads_solve(expected, buf, dim_x, dim_y, dim_z);
+
+        ads_solve(rhs, dim_x, dim_y, dim_z);
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+}
+
+TEST_CASE("ADS with symmetric positive definite dimensions", "[ads]") {
+    struct spd_dimension {
+        ads::lin::band_matrix general;
+        ads::lin::symmetric_band_matrix symmetric;
+        ads::lin::solver_ctx general_ctx;
+        ads::lin::solver_ctx symmetric_ctx;
+
+        spd_dimension(int kd, int n)
+        : general{kd, kd, n}
+        , symmetric{kd, n}
+        , general_ctx{general}
+        , symmetric_ctx{symmetric} {
+            for (int i = 0; i < n; ++i) {
+                for (int j = std::max(0, i - kd); j <= i; ++j) {
+                    auto const val = (i == j) ? 3.0 * kd + i % 2 : 1.0 / (1 + i - j);
+                    general(i, j) = general(j, i) = symmetric(i, j) = val;
+                }
+            }
+            ads::lin::factorize(general, general_ctx);
+            ads::lin::factorize(symmetric, symmetric_ctx);
+        }
+
+        auto lu() -> ads::dim_data { return {general, general_ctx}; }
+        auto spd() -> ads::spd_dim_data { return {symmetric, symmetric_ctx}; }
+    };
+
+    auto X = spd_dimension{2, 7};
+    auto Y = spd_dimension{1, 5};
+    auto Z = spd_dimension{3, 6};
+
+    auto rhs = tensor<3>{{7, 5, 6}};
+    for (int i = 0; i < rhs.size(); ++i) {
+        rhs.data()[i] = (i * 37 % 11) - 5.0;
+    }
+    auto buf = tensor<3>{rhs.sizes()};
+
+    auto expected = rhs;
+    ads_solve(expected, buf, X.lu(), Y.lu(), Z.lu());
+
+    SECTION("standard") {
+        ads_solve(rhs, buf, X.spd(), Y.spd(), Z.spd());
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("mixed with LU-factorized dimensions") {
+        ads_solve(rhs, buf, X.spd(), Y.lu(), Z.spd());
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("parallel sweeps") {
+        auto const executor = ads::sequential_executor{};
+        ads_solve(ads::parallel_sweep{executor, 3}, rhs, buf, X.spd(), Y.spd(), Z.spd());
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("transpose-free") {
+        ads_solve(ads::strided_sweep{}, rhs, X.spd(), Y.spd(), Z.spd());
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("parallel sweeps without buffer") {
+        auto const executor = ads::sequential_executor{};
+        ads_solve(ads::parallel_sweep{executor, 3}, rhs, X.spd(), Y.spd(), Z.spd());
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+
+    SECTION("parallel sweeps on thread pool") {
+        auto expected_spd = rhs;
+        ads_solve(expected_spd, buf, X.spd(), Y.spd(), Z.spd());
+
+        auto const pool = ads::thread_pool_executor{3};
+        ads_solve(ads::parallel_sweep{pool, 4}, rhs, buf, X.spd(), Y.spd(), Z.spd());
+        CHECK(to_vector(rhs) == to_vector(expected_spd));
+    }
+
+    SECTION("with special dimension") {
+        auto const step_y = [&](auto& r) {
+            ads::lin::solve_with_factorized(Y.symmetric, r, Y.symmetric_ctx);
+        };
+        ads_solve(rhs, buf, X.spd(), step_y, Z.spd());
+        CHECK_THAT(to_vector(rhs), Approx(to_vector(expected)));
+    }
+}
+
+TEST_CASE("ADS batch of fields", "[ads]") {
+    auto const make_dim = [](int n) {
+        auto rows = std::vector<std::vector<double>>{};
+        for (int i = 0; i < n; ++i) {
+            auto row = i > 0 ? std::vector<double>{-1.0 - i} : std::vector<double>{};
+            row.push_back(5.0 + i);
+            if (i < n - 1) {
+                row.push_back(1.5);
+            }
+            rows.push_back(row);
+        }
+        return make_factored_matrix(1, 1, n, rows);
+    };
+
+    auto X = make_dim(7);
+    auto Y = make_dim(5);
+    auto Z = make_dim(4);
+
+    auto dim_x = ads::dim_data{X.mat, X.ctx};
+    auto dim_y = ads::dim_data{Y.mat, Y.ctx};
+    auto dim_z = ads::dim_data{Z.mat, Z.ctx};
+
+    auto const fields = 3;
+
+    auto batch = tensor<4>{{7, 5, 4, fields}};
+    for (int i = 0; i < batch.size(); ++i) {
+        batch.data()[i] = (i * 37 % 11) - 5.0;
+    }
+
+    // expected solution - each field solved separately
+    auto expected = batch;
+    auto const field_size = 7 * 5 * 4;
+    for (int f = 0; f < fields; ++f) {
+        auto rhs = tensor<3>{{7, 5, 4}};
+        auto buf = tensor<3>{rhs.sizes()};
+        auto* const field = expected.data() + f * field_size;
+        std::copy_n(field, field_size, rhs.data());
+        ads_solve(rhs, buf, dim_x, dim_y, dim_z);
+        std::copy_n(rhs.data(), field_size, field);
+    }
+
+    auto buf = tensor<4>{batch.sizes()};
+
+    SECTION("sequential") {
+        ads_solve_batch(batch, buf, dim_x, dim_y, dim_z);
+        CHECK(to_vector(batch) == to_vector(expected));
+    }
+
+    SECTION("parallel sweeps") {
+        auto const executor = ads::sequential_executor{};
+        ads_solve_batch(ads::parallel_sweep{executor, 5}, batch, buf, dim_x, dim_y, dim_z);
+        CHECK(to_vector(batch) == to_vector(expected));
+    }
+
+    SECTION("parallel sweeps on thread pool") {
+        auto const pool = ads::thread_pool_executor{4};
+        ads_solve_batch(ads::parallel_sweep{pool, 5}, batch, buf, dim_x, dim_y, dim_z);
+        CHECK(to_vector(batch) == to_vector(expected));
+    }
+
+    SECTION("transpose-free") {
+        ads_solve_batch(ads::strided_sweep{}, batch, dim_x, dim_y, dim_z);
+        CHECK_THAT(to_vector(batch), Approx(to_vector(expected)));
+    }
+
+    SECTION("even number of dimensions") {
+        auto batch_2d = tensor<3>{{7, 5, fields}};
+        auto buf_2d = tensor<3>{batch_2d.sizes()};
+        std::copy_n(batch.data(), batch_2d.size(), batch_2d.data());
+        auto expected_2d = batch_2d;
+
+        for (int f = 0; f < fields; ++f) {
+            auto rhs = tensor<2>{{7, 5}};
+            auto tmp = tensor<2>{rhs.sizes()};
+            auto* const field = expected_2d.data() + f * rhs.size();
+            std::copy_n(field, rhs.size(), rhs.data());
+            ads_solve(rhs, tmp, dim_x, dim_y);
+            std::copy_n(rhs.data(), rhs.size(), field);
+        }
+
+        ads_solve_batch(batch_2d, buf_2d, dim_x, dim_y);
+        CHECK(to_vector(batch_2d) == to_vector(expected_2d));
+    }
+}
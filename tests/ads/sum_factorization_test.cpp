@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ads/sum_factorization.hpp"
+
+#include <array>
+
+#include <catch2/catch_all.hpp>
+
+#include "ads/basis_data.hpp"
+#include "ads/executor/sequential.hpp"
+#include "ads/executor/thread_pool.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/util/function_value.hpp"
+#include "test_helpers.hpp"
+
+namespace lin = ads::lin;
+
+using ads::test::fill;
+using ads::test::make_basis;
+using ads::test::to_vector;
+
+namespace {
+
+// Straightforward assembly, evaluating each basis function at each quadrature point
+template <typename Form>
+auto naive_rhs_2d(const lin::tensor<double, 2>& u, const ads::basis_data& bx,
+                  const ads::basis_data& by, Form&& form) -> lin::tensor<double, 2> {
+    auto rhs = lin::tensor<double, 2>{u.sizes()};
+    auto basis = [&](int ex, int ey, int qx, int qy, int ax, int ay) {
+        double const Bx = bx.b[ex][qx][0][ax];
+        double const By = by.b[ey][qy][0][ay];
+        double const dBx = bx.b[ex][qx][1][ax];
+        double const dBy = by.b[ey][qy][1][ay];
+        return ads::function_value_2d{Bx * By, dBx * By, Bx * dBy};
+    };
+
+    for (int ex = 0; ex < bx.elements; ++ex) {
+        for (int ey = 0; ey < by.elements; ++ey) {
+            double const J = bx.J[ex] * by.J[ey];
+            for (int qx = 0; qx < bx.quad_order; ++qx) {
+                for (int qy = 0; qy < by.quad_order; ++qy) {
+                    double const w = bx.w[qx] * by.w[qy];
+                    auto const x = std::array{bx.x[ex][qx], by.x[ey][qy]};
+
+                    auto val = ads::function_value_2d{};
+                    for (int ax = 0; ax <= bx.degree; ++ax) {
+                        for (int ay = 0; ay <= by.degree; ++ay) {
+                            double const c = u(bx.first_dof(ex) + ax, by.first_dof(ey) + ay);
+                            auto B = basis(ex, ey, qx, qy, ax, ay);
+                            B *= c;
+                            val += B;
+                        }
+                    }
+                    auto const r = form(x, val);
+                    for (int ax = 0; ax <= bx.degree; ++ax) {
+                        for (int ay = 0; ay <= by.degree; ++ay) {
+                            auto const v = basis(ex, ey, qx, qy, ax, ay);
+                            double const L = r.val * v.val + r.dx * v.dx + r.dy * v.dy;
+                            rhs(bx.first_dof(ex) + ax, by.first_dof(ey) + ay) += L * w * J;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return rhs;
+}
+
+}  // namespace
+
+TEST_CASE("Sum factorization", "[assembly]") {
+    auto const bx = make_basis(3, 4);
+    auto const by = make_basis(2, 5);
+    auto const bz = make_basis(1, 3);
+
+    SECTION("values at quadrature points") {
+        auto u = lin::tensor<double, 3>{{bx.dofs, by.dofs, bz.dofs}};
+        fill(u);
+        auto sf = ads::sum_factorization<3>{{&bx, &by, &bz}};
+        auto values = ads::quad_values<3>{bx.quad_order * by.quad_order * bz.quad_order};
+
+        auto const e = std::array{2, 1, 2};
+        sf.evaluate(u, e, values);
+
+        auto const q = std::array{1, 2, 0};
+        auto expected = ads::function_value_3d{};
+        for (int a = 0; a <= bx.degree; ++a) {
+            for (int b = 0; b <= by.degree; ++b) {
+                for (int c = 0; c <= bz.degree; ++c) {
+                    double const coeff =
+                        u(bx.first_dof(e[0]) + a, by.first_dof(e[1]) + b, bz.first_dof(e[2]) + c);
+                    double const B1 = bx.b[e[0]][q[0]][0][a];
+                    double const B2 = by.b[e[1]][q[1]][0][b];
+                    double const B3 = bz.b[e[2]][q[2]][0][c];
+                    double const dB1 = bx.b[e[0]][q[0]][1][a];
+                    double const dB2 = by.b[e[1]][q[1]][1][b];
+                    double const dB3 = bz.b[e[2]][q[2]][1][c];
+                    expected += ads::function_value_3d{coeff * B1 * B2 * B3, coeff * dB1 * B2 * B3,
+                                                       coeff * B1 * dB2 * B3,
+                                                       coeff * B1 * B2 * dB3};
+                }
+            }
+        }
+
+        auto const idx = q[0] + bx.quad_order * (q[1] + by.quad_order * q[2]);
+        auto const val = values[idx];
+        CHECK(val.val == Catch::Approx(expected.val));
+        CHECK(val.dx == Catch::Approx(expected.dx));
+        CHECK(val.dy == Catch::Approx(expected.dy));
+        CHECK(val.dz == Catch::Approx(expected.dz));
+    }
+
+    SECTION("right-hand side assembly") {
+        auto u = lin::tensor<double, 2>{{bx.dofs, by.dofs}};
+        fill(u);
+        auto form = [](std::array<double, 2> x, ads::function_value_2d u) {
+            return ads::function_value_2d{x[0] * u.val + x[1], -0.5 * u.dx, 2 * u.dy + u.val};
+        };
+        auto const expected = naive_rhs_2d(u, bx, by, form);
+
+        auto rhs = lin::tensor<double, 2>{u.sizes()};
+        ads::assemble_rhs(rhs, u, {&bx, &by}, form);
+        CHECK_THAT(to_vector(rhs), Catch::Matchers::Approx(to_vector(expected)));
+
+        SECTION("with executor") {
+            auto rhs2 = lin::tensor<double, 2>{u.sizes()};
+            ads::assemble_rhs(rhs2, u, {&bx, &by}, form, ads::sequential_executor{});
+            CHECK_THAT(to_vector(rhs2), Catch::Matchers::Approx(to_vector(expected)));
+        }
+
+        SECTION("with each assembly mode") {
+            auto mode = GENERATE(ads::assembly_mode::locked, ads::assembly_mode::colored,
+                                 ads::assembly_mode::reduction);
+            auto const executor = ads::thread_pool_executor{3};
+            auto rhs2 = lin::tensor<double, 2>{u.sizes()};
+            ads::assemble_rhs(rhs2, u, {&bx, &by}, form, executor, mode);
+            CHECK_THAT(to_vector(rhs2), Catch::Matchers::Approx(to_vector(expected)));
+        }
+
+        SECTION("with separate trial space") {
+            auto rhs2 = lin::tensor<double, 2>{u.sizes()};
+            ads::assemble_rhs(rhs2, {&bx, &by}, u, {&bx, &by}, form, ads::sequential_executor{});
+            CHECK_THAT(to_vector(rhs2), Catch::Matchers::Approx(to_vector(expected)));
+        }
+    }
+}
@@ -51,3 +51,19 @@ TEST_CASE("Multiarray") {
         CHECK(aa.size(3) == s);
     }
 }
+
+TEST_CASE("Linear indices beyond 32 bits") {
+    // Only meaningful with ADS_USE_64BIT_INDICES
+    if constexpr (sizeof(ads::linear_index_type) >= 8) {
+        auto const n = 2000;
+        auto const standard = ads::standard_ordering<3>{{n, n, n}};
+        auto const reverse = ads::reverse_ordering<3>{{n, n, n}};
+        auto const size = ads::linear_index_type{n} * n * n;
+
+        CHECK(standard.size() == size);
+        CHECK(reverse.size() == size);
+        CHECK(standard.linear_index(n - 1, n - 1, n - 1) == size - 1);
+        CHECK(reverse.linear_index(n - 1, n - 1, n - 1) == size - 1);
+        CHECK(reverse.linear_index(0, 0, n - 1) == ads::linear_index_type{n} * n * (n - 1));
+    }
+}
@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Test runner for tests using MPI, run by each process of the communicator
+
+#include <mpi.h>
+
+#include <catch2/catch_session.hpp>
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int const result = Catch::Session().run(argc, argv);
+    MPI_Finalize();
+    return result;
+}
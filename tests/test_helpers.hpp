@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2015 - 2023 Marcin Łoś <marcin.los.91@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Fixtures shared by tests of solvers and assembly
+
+#ifndef ADS_TESTS_TEST_HELPERS_HPP
+#define ADS_TESTS_TEST_HELPERS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "ads/basis_data.hpp"
+#include "ads/bspline/bspline.hpp"
+#include "ads/lin/tensor.hpp"
+#include "ads/simulation/config.hpp"
+#include "ads/simulation/dimension.hpp"
+
+namespace ads::test {
+
+template <std::size_t N>
+using tensor = lin::tensor<double, N>;
+
+// Fills the tensor with smooth, non-zero values
+template <typename Tensor>
+void fill(Tensor& t) {
+    for (int i = 0; i < t.size(); ++i) {
+        t.data()[i] = std::sin(0.37 * i) + 0.5;
+    }
+}
+
+template <typename Tensor>
+auto to_vector(const Tensor& t) -> std::vector<double> {
+    return {t.data(), t.data() + t.size()};
+}
+
+// Basis data on [0, 1] with uniform knot vector
+inline auto make_basis(int p, int elements, int derivatives = 1) -> basis_data {
+    auto basis = bspline::create_basis(0.0, 1.0, p, elements);
+    return basis_data{basis, derivatives};
+}
+
+// Dimension on [0, 1] with factorized mass matrix
+inline auto make_dimension(int p, int elements) -> dimension {
+    auto dim = dimension{dim_config{p, elements}, 1};
+    dim.factorize_matrix();
+    return dim;
+}
+
+}  // namespace ads::test
+
+#endif  // ADS_TESTS_TEST_HELPERS_HPP
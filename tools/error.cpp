@@ -6,10 +6,22 @@
 #include <string>
 
 #include "ads/executor/galois.hpp"
+#include "ads/executor/per_thread.hpp"
 #include "ads/simulation.hpp"
 
 namespace ads {
 
+namespace {
+
+template <typename Executor>
+double total(per_thread<double>& partial, const Executor& executor) {
+    double sum = 0;
+    partial.reduce(sum, executor, [](double& a, double b) { a += b; });
+    return sum;
+}
+
+}  // namespace
+
 class diff_computer2d : public simulation_2d {
     galois_executor executor{4};
 
@@ -37,7 +49,7 @@ class diff_computer2d : public simulation_2d {
         auto u = read_solution(path1);
         auto v = read_solution(path2);
 
-        double L2 = 0;
+        auto L2 = per_thread<double>{};
 
         executor.for_each(elements(), [&](index_type e) {
             double localL2 = 0;
@@ -50,16 +62,16 @@ class diff_computer2d : public simulation_2d {
                 auto e = uval - vval;
                 localL2 += w * J * e.val * e.val;
             }
-            executor.synchronized([&]() { L2 += localL2; });
+            L2.local() += localL2;
         });
-        return std::sqrt(L2);
+        return std::sqrt(total(L2, executor));
     }
 
     double error_H1(const std::string& path1, const std::string& path2) {
         auto u = read_solution(path1);
         auto v = read_solution(path2);
 
-        double H1 = 0;
+        auto H1 = per_thread<double>{};
 
         executor.for_each(elements(), [&](index_type e) {
             double localH1 = 0;
@@ -72,9 +84,9 @@ class diff_computer2d : public simulation_2d {
                 auto e = uval - vval;
                 localH1 += w * J * (e.val * e.val + e.dx * e.dx + e.dy * e.dy);
             }
-            executor.synchronized([&]() { H1 += localH1; });
+            H1.local() += localH1;
         });
-        return std::sqrt(H1);
+        return std::sqrt(total(H1, executor));
     }
 };
 
@@ -112,7 +124,7 @@ class diff_computer3d : public simulation_3d {
         auto a = read_solution(path1);
         auto b = read_solution(path2);
 
-        double L2 = 0;
+        auto L2 = per_thread<double>{};
 
         executor.for_each(elements(), [&](index_type e) {
             double localL2 = 0;
@@ -126,16 +138,16 @@ class diff_computer3d : public simulation_3d {
 
                 localL2 += w * J * (ex.val * ex.val + ey.val * ey.val + ez.val * ez.val);
             }
-            executor.synchronized([&]() { L2 += localL2; });
+            L2.local() += localL2;
         });
-        return std::sqrt(L2);
+        return std::sqrt(total(L2, executor));
     }
 
     double error_H1(const std::string& path1, const std::string& path2) {
         auto a = read_solution(path1);
         auto b = read_solution(path2);
 
-        double H1 = 0;
+        auto H1 = per_thread<double>{};
 
         executor.for_each(elements(), [&](index_type e) {
             double localH1 = 0;
@@ -151,9 +163,9 @@ class diff_computer3d : public simulation_3d {
                 };
                 localH1 += w * J * (norm2(ex) + norm2(ey) + norm2(ez));
             }
-            executor.synchronized([&]() { H1 += localH1; });
+            H1.local() += localH1;
         });
-        return std::sqrt(H1);
+        return std::sqrt(total(H1, executor));
     }
 };
 